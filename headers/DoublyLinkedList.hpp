@@ -13,7 +13,7 @@ protected:
         std::shared_ptr<Node> prev;
 
 
-        explicit Node(T content) : content(content), next(nullptr), prev(nullptr)
+        explicit Node(T content) : content(std::move(content)), next(nullptr), prev(nullptr)
         {};
     };
 
@@ -33,11 +33,12 @@ public:
 
     /**
      * Method used to insert an element of type T in the first position of the list.
+     * The element is moved into the list, hence T may also be a move-only type.
      * @param elem the element to insert.
      */
     void insertFirst(T elem)
     {
-        std::shared_ptr<Node> newNode = std::make_shared<Node>(elem);
+        std::shared_ptr<Node> newNode = std::make_shared<Node>(std::move(elem));
 
         // If either head or tail are nullptr, we have to directly connect them to the newly allocated node.
         if (!(head || tail))
@@ -92,13 +93,13 @@ public:
     }
 
 
-    std::shared_ptr<Node> getHead()
+    const std::shared_ptr<Node> &getHead() const
     {
         return head;
     }
 
 
-    std::shared_ptr<Node> getTail()
+    const std::shared_ptr<Node> &getTail() const
     {
         return tail;
     }
@@ -79,4 +79,64 @@ private:
 };
 
 
+// ----- //
+
+
+class TileSyntaxException : public std::exception {
+public:
+    explicit TileSyntaxException(const std::string &message) : message_(message)
+    {}
+
+
+    [[nodiscard]] const char *what() const noexcept override
+    {
+        return message_.c_str();
+    }
+
+
+private:
+    std::string message_;
+};
+
+
+// ----- //
+
+
+class InvalidCampaignJournalException : public std::exception {
+public:
+    explicit InvalidCampaignJournalException(const std::string &message) : message_(message)
+    {}
+
+
+    [[nodiscard]] const char *what() const noexcept override
+    {
+        return message_.c_str();
+    }
+
+
+private:
+    std::string message_;
+};
+
+
+// ----- //
+
+
+class InvalidCommandArgumentException : public std::exception {
+public:
+    explicit InvalidCommandArgumentException(const std::string &message) : message_(message)
+    {}
+
+
+    [[nodiscard]] const char *what() const noexcept override
+    {
+        return message_.c_str();
+    }
+
+
+private:
+    std::string message_;
+};
+
+
 #endif //UTOTPARSER_EXCEPTIONS_H
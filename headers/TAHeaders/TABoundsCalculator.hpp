@@ -36,17 +36,16 @@ typedef struct {
     double r;
 } Bound;
 
+// The bounds are kept separately by each thread, since each thread composes its own TAs.
+
 class TABoundsCalculator {
 
 private:
-    // A map storing for each string key (which will be the name of a TA), the corresponding bounds that have been found.
-    static std::map<std::string, std::vector<Bound>> taBounds;
-
     // A stack saving the current history of bounds found for each forking path due to multiple 'out' locations tiles.
-    static std::stack<std::vector<Bound>> boundsHistory;
+    static thread_local std::stack<std::vector<Bound>> boundsHistory;
 
     // A vector collecting all the bounds found for all paths for a given TA.
-    static std::vector<Bound> pathBounds;
+    static thread_local std::vector<Bound> pathBounds;
 
     // The keyword corresponding to the nan bound.
     static const std::string nanKeyword;
@@ -166,23 +165,12 @@ public:
 
 
     /**
-     * Method used to insert into the 'taBounds' map the bounds found for a given key.
-     * @param nameTA the name of the TA for which to store bounds.
+     * Method used to get the bounds found so far for the TA being handled by the current thread.
+     * @return the bounds found for the current TA.
      */
-    static void storeTABounds(const std::string &nameTA)
+    static const std::vector<Bound> &getPathBounds()
     {
-        taBounds.insert(std::make_pair(nameTA, pathBounds));
-    }
-
-
-    /**
-     * Method used to retrieve from the 'taBounds' map the bounds found for a given key.
-     * @param nameTA the name of the TA for which to retrieve bounds.
-     * @return the bounds relative to the 'nameTA' TA.
-     */
-    static std::vector<Bound> getStoredBounds(const std::string &nameTA)
-    {
-        return taBounds.find(nameTA)->second;
+        return pathBounds;
     }
 
 
@@ -264,17 +252,6 @@ public:
     }
 
 
-    /*
-     * Method used to return the bounds for a given TA name, its respective Bounds as a string representation,
-     * @param nameTA the name of the TA for which to return the bounds as a string.
-     * @return a string representation of the bounds retrieved for he 'nameTA' TA.
-     */
-    static std::string getBoundsAsString(const std::string &nameTA)
-    {
-        return getBoundsAsString(taBounds.find(nameTA)->second);
-    }
-
-
     /**
      * Method used to return the size of the given bound.
      * @param bound the bound to compute the size.
@@ -289,11 +266,10 @@ public:
 };
 
 // Defining static attributes.
-std::map<std::string, std::vector<Bound>> TABoundsCalculator::taBounds {};
 const std::string TABoundsCalculator::nanKeyword { "nan" };
 const std::string TABoundsCalculator::infKeyword { "inf" };
-std::stack<std::vector<Bound>> TABoundsCalculator::boundsHistory {};
-std::vector<Bound> TABoundsCalculator::pathBounds {};
+thread_local std::stack<std::vector<Bound>> TABoundsCalculator::boundsHistory {};
+thread_local std::vector<Bound> TABoundsCalculator::pathBounds {};
 
 #endif
 
@@ -0,0 +1,277 @@
+#ifndef UTOTPARSER_TACANONICALHASHER_H
+#define UTOTPARSER_TACANONICALHASHER_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iomanip>
+#include <queue>
+#include <sstream>
+#include <tuple>
+
+#include "utilities/Utils.hpp"
+#include "TAHeaders/TAGraph.hpp"
+
+
+// Canonical form of a composed TA.
+// --------------------------------
+// Two TAs generated from different regular expressions (or from the same one, with different tile instance numbers) are
+// often the same TA up to the names of their locations and transitions. The canonical form only keeps what tChecker sees
+// apart from the names: the initial and final locations, the invariants, the transitions and their labels, with
+// whitespace removed from every label. Locations are numbered as follows:
+// 1) Each location gets a color from its own labels, which is then refined for a few rounds with the colors of its
+//    neighbours and the labels of the transitions reaching them (Weisfeiler-Lehman refinement).
+// 2) Locations are numbered in breadth-first order starting from the initial one, visiting the successors of a location
+//    in order of transition labels and colors (locations not reachable from the initial one are visited afterwards).
+// 3) The canonical form lists the locations and the transitions using these numbers.
+// Renaming the locations of a TA never changes its canonical form, while two TAs with the same canonical form are the
+// same TA. When the successors of a location cannot be told apart by their colors, ties are broken by position, hence two
+// same TAs may still get different canonical forms (e.g., if two branches of a ternary tile only differ far away from it):
+// this only makes a duplicate go undetected, it never makes different TAs look the same.
+// The hash of the canonical form is made of two independent 64-bit hashes (FNV-1a and a polynomial hash modulo 2^61 - 1).
+
+class TACanonicalHasher {
+
+private:
+    // The number of rounds of color refinement (the refinement stops earlier if colors do not split anymore).
+    static const int refinementRounds;
+
+    // The modulus of the polynomial hash.
+    static const uint64_t polynomialModulus;
+
+    // The base of the polynomial hash.
+    static const uint64_t polynomialBase;
+
+
+    /**
+     * Method used to mix two values into one, used to compute the colors of the locations.
+     * @param seed the current value.
+     * @param value the value to mix into the current one.
+     * @return the mixed value.
+     */
+    static uint64_t mix(uint64_t seed, uint64_t value)
+    {
+        // splitmix64 finalizer.
+        uint64_t z { seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2)) };
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+
+    /**
+     * Method used to remove the whitespace from a label, so that labels differing only by spacing are the same.
+     * @param label the label to normalize.
+     * @return the label without whitespace.
+     */
+    static std::string normalizeLabel(const std::string &label)
+    {
+        std::string normalized {};
+        normalized.reserve(label.size());
+        for (char c: label)
+            if (!std::isspace(static_cast<unsigned char>(c)))
+                normalized.push_back(c);
+        return normalized;
+    }
+
+
+    /**
+     * Method used to compute the 61-bit polynomial hash of a string.
+     * @param str the string to hash.
+     * @return the polynomial hash of the given string.
+     */
+    static uint64_t computePolynomialHash(const std::string &str)
+    {
+        uint64_t hash { 0 };
+        for (char c: str)
+        {
+            // (hash * base + c) mod 2^61 - 1, computed on 128 bits.
+            __uint128_t product { static_cast<__uint128_t>(hash) * polynomialBase + static_cast<unsigned char>(c) + 1 };
+            uint64_t reduced { static_cast<uint64_t>(product & polynomialModulus) + static_cast<uint64_t>(product >> 61) };
+            hash = (reduced >= polynomialModulus) ? reduced - polynomialModulus : reduced;
+        }
+        return hash;
+    }
+
+
+public:
+    /**
+     * Method used to get the canonical form of a TA, i.e., a textual description of it which does not depend on the
+     * names of its locations and transitions.
+     * @param ta the graph representation of the TA.
+     * @return the canonical form of the TA.
+     */
+    static std::string getCanonicalForm(const TAGraph &ta)
+    {
+        uint32_t locationCount { ta.getLocationCount() };
+        uint32_t initial { ta.getInitialLocation() };
+
+        // The labels of the locations and of the transitions, normalized once.
+        std::vector<std::string> invariants(locationCount);
+        std::vector<bool> isFinal(locationCount);
+        ta.forEachLocation([&](uint32_t i, const GraphLocation &location) {
+            if (location.invariant != STRING_POOL_NONE)
+                invariants[i] = normalizeLabel(TAGraph::getString(location.invariant));
+            isFinal[i] = location.isFinal;
+        });
+
+        // Each transition as its source, its target and its labels (kind and text, in the order they are written).
+        std::vector<std::tuple<uint32_t, uint32_t, std::string>> edges {};
+        edges.reserve(ta.getEdgeCount());
+        ta.forEachEdge([&](uint32_t, const GraphEdge &edge) {
+            std::string labels {};
+            for (uint32_t i = 0; i < edge.labelCount; i++)
+            {
+                const GraphLabel &label = ta.getLabel(edge, i);
+                labels.append(TAGraph::getString(label.kind)).append("=").append(normalizeLabel(TAGraph::getString(label.text))).append(";");
+            }
+            edges.emplace_back(edge.source, edge.target, std::move(labels));
+        });
+
+        std::vector<uint64_t> edgeColors(edges.size());
+        for (size_t e = 0; e < edges.size(); e++)
+            edgeColors[e] = computeFNV1aHash(std::get<2>(edges[e]));
+
+        // The outgoing and incoming transitions of each location.
+        std::vector<std::vector<uint32_t>> outEdges(locationCount);
+        std::vector<std::vector<uint32_t>> inEdges(locationCount);
+        for (uint32_t e = 0; e < edges.size(); e++)
+        {
+            outEdges[std::get<0>(edges[e])].push_back(e);
+            inEdges[std::get<1>(edges[e])].push_back(e);
+        }
+
+        // 1) Coloring the locations.
+        std::vector<uint64_t> colors(locationCount);
+        for (uint32_t i = 0; i < locationCount; i++)
+            colors[i] = mix(mix(computeFNV1aHash(invariants[i]), isFinal[i]), i == initial);
+
+        auto countColors = [](std::vector<uint64_t> c) {
+            std::sort(c.begin(), c.end());
+            return std::unique(c.begin(), c.end()) - c.begin();
+        };
+
+        auto colorCount = countColors(colors);
+        std::vector<uint64_t> neighbours {};
+        for (int round = 0; round < refinementRounds; round++)
+        {
+            std::vector<uint64_t> refinedColors(locationCount);
+            for (uint32_t i = 0; i < locationCount; i++)
+            {
+                neighbours.clear();
+                for (uint32_t e: outEdges[i])
+                    neighbours.push_back(mix(mix(edgeColors[e], colors[std::get<1>(edges[e])]), 1));
+                for (uint32_t e: inEdges[i])
+                    neighbours.push_back(mix(mix(edgeColors[e], colors[std::get<0>(edges[e])]), 2));
+                std::sort(neighbours.begin(), neighbours.end());
+
+                uint64_t color { colors[i] };
+                for (uint64_t n: neighbours)
+                    color = mix(color, n);
+                refinedColors[i] = color;
+            }
+            colors = std::move(refinedColors);
+
+            auto refinedColorCount = countColors(colors);
+            if (refinedColorCount == colorCount)
+                break;
+            colorCount = refinedColorCount;
+        }
+
+        // 2) Numbering the locations in breadth-first order.
+        std::vector<uint32_t> numbers(locationCount, UINT32_MAX);
+        std::vector<uint32_t> order {};
+        order.reserve(locationCount);
+
+        std::vector<uint32_t> roots(locationCount);
+        for (uint32_t i = 0; i < locationCount; i++)
+            roots[i] = i;
+        std::stable_sort(roots.begin(), roots.end(), [&](uint32_t a, uint32_t b) {
+            return std::make_pair(a != initial, colors[a]) < std::make_pair(b != initial, colors[b]);
+        });
+
+        std::vector<std::tuple<uint64_t, uint64_t, uint32_t>> successors {};
+        for (uint32_t root: roots)
+        {
+            if (numbers[root] != UINT32_MAX)
+                continue;
+
+            std::queue<uint32_t> queue {};
+            numbers[root] = static_cast<uint32_t>(order.size());
+            order.push_back(root);
+            queue.push(root);
+
+            while (!queue.empty())
+            {
+                uint32_t location { queue.front() };
+                queue.pop();
+
+                successors.clear();
+                for (uint32_t e: outEdges[location])
+                    successors.emplace_back(edgeColors[e], colors[std::get<1>(edges[e])], std::get<1>(edges[e]));
+                std::sort(successors.begin(), successors.end());
+
+                for (const auto &successor: successors)
+                {
+                    uint32_t target { std::get<2>(successor) };
+                    if (numbers[target] != UINT32_MAX)
+                        continue;
+                    numbers[target] = static_cast<uint32_t>(order.size());
+                    order.push_back(target);
+                    queue.push(target);
+                }
+            }
+        }
+
+        // 3) Writing the locations and the transitions with their numbers.
+        std::ostringstream form;
+        form << "locations:" << locationCount << ":initial:" << (locationCount > 0 ? numbers[initial] : 0) << '\n';
+        for (uint32_t number = 0; number < locationCount; number++)
+        {
+            uint32_t location { order[number] };
+            form << number << (isFinal[location] ? ":final" : "") << ':' << invariants[location] << '\n';
+        }
+
+        std::vector<uint32_t> edgeOrder(edges.size());
+        for (uint32_t e = 0; e < edges.size(); e++)
+            edgeOrder[e] = e;
+        std::sort(edgeOrder.begin(), edgeOrder.end(), [&](uint32_t a, uint32_t b) {
+            return std::tie(numbers[std::get<0>(edges[a])], numbers[std::get<1>(edges[a])], std::get<2>(edges[a])) <
+                   std::tie(numbers[std::get<0>(edges[b])], numbers[std::get<1>(edges[b])], std::get<2>(edges[b]));
+        });
+
+        form << "edges:" << edges.size() << '\n';
+        for (uint32_t e: edgeOrder)
+            form << numbers[std::get<0>(edges[e])] << ':' << numbers[std::get<1>(edges[e])] << ':' << std::get<2>(edges[e]) << '\n';
+
+        return form.str();
+    }
+
+
+    /**
+     * Method used to get the hash of the canonical form of a TA, hence two TAs which only differ by the names of their
+     * locations and transitions have the same hash.
+     * @param ta the graph representation of the TA.
+     * @return the hexadecimal representation of the 128-bit hash of the canonical form of the TA.
+     */
+    static std::string getCanonicalHash(const TAGraph &ta)
+    {
+        std::string form { getCanonicalForm(ta) };
+
+        std::ostringstream hash;
+        hash << std::hex << std::setfill('0')
+             << std::setw(16) << computeFNV1aHash(form)
+             << std::setw(16) << computePolynomialHash(form);
+        return hash.str();
+    }
+
+};
+
+
+// Defining static attributes.
+const int TACanonicalHasher::refinementRounds { 8 };
+const uint64_t TACanonicalHasher::polynomialModulus { (1ULL << 61) - 1 };
+const uint64_t TACanonicalHasher::polynomialBase { 0x1F3D5B79A2C4E687ULL % ((1ULL << 61) - 1) };
+
+
+#endif //UTOTPARSER_TACANONICALHASHER_H
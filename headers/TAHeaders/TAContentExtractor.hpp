@@ -5,6 +5,7 @@
 #include "nlohmann/json.hpp"
 
 #include "defines/UPPAALxmlAttributes.h"
+#include "utilities/JsonHelper.hpp"
 
 using json = nlohmann::json;
 
@@ -77,9 +78,9 @@ public:
     /**
      * Method used to return the locations declarations in the given TA.
      * @param inFile the json representation of the TA.
-     * @return a json containing the locations declaration.
+     * @return a reference to the json containing the locations declaration.
      */
-    static json getLocations(const json &inFile)
+    static const json &getLocations(const json &inFile)
     {
         return inFile.at(NTA).at(TEMPLATE).at(LOCATION);
     }
@@ -99,9 +100,9 @@ public:
     /**
      * Method used to return the transitions declarations in the given TA.
      * @param inFile the json representation of the TA.
-     * @return a json containing the transitions declaration.
+     * @return a reference to the json containing the transitions declaration.
      */
-    static json getTransitions(const json &inFile)
+    static const json &getTransitions(const json &inFile)
     {
         return inFile.at(NTA).at(TEMPLATE).at(TRANSITION);
     }
@@ -118,56 +119,21 @@ public:
     }
 
 
-    // TODO: maybe raise an exception when no named location has been found.
     /**
-     * Method used to extract the locations ids. The considered locations must have been defined in UPPAAL with a name.
-     * @param inFile the json file from which to take the named locations.
-     * @param name the string to match in the location's name in order to get it as a result.
-     * @return a vector containing all the locations whose name equals parameter 'name'.
+     * Method used to bring the given TA in the form expected by the tile operators, in which the locations and the
+     * transitions sections are always arrays (xml2json produces a single object when there is only one of them).
+     * Normalizing the TA once when it is loaded allows all the following accesses to be performed by reference.
+     * Labels are left untouched, since their shape is meaningful to the translators.
+     * @param inFile the json representation of the TA to normalize.
      */
-    static std::vector<std::string> getNamedLocations(const json &inFile, const std::string &name)
+    static void normalizeTA(json &inFile)
     {
-        std::vector<std::string> result;
+        json &taTemplate = inFile.at(NTA).at(TEMPLATE);
 
-        // First, get all the locations from the given json file.
-        json locations = TAContentExtractor::getLocations(inFile);
-
-        // For each such location, we get only those whose name equals parameter name.
-        for (auto &loc: locations)
-            if (loc.contains(NAME) && static_cast<std::string>(loc.at(NAME).at(TEXT)) == name)
-                result.push_back(loc.at(ID));
-
-        return result;
-    }
-
-
-    /**
-     * Method used to extract the text section of a location's label.
-     * @param inFile the json file in which the text is going to be extracted.
-     * @param locationName the name of the location to extract the label text.
-     * @param kind the kind of label to extract.
-     * @param replaceColon true if one wants to replace all occurrences of '.' characters in the extracted text with ';' characters.
-     * @return the text corresponding to the location label. If the label's kind doesn't match the one given as 'kind' parameter,
-     *         an empty string will be returned instead.
-     */
-    static std::string getLocationLabelText(const json &inFile, const std::string &locationName, const std::string &kind, bool replaceColon = true)
-    {
-        std::string resultLabel {};
-        json locations = TAContentExtractor::getLocations(inFile);
-
-        for (auto &loc: locations)
-        {
-            if (static_cast<std::string>(loc.at(ID)) == locationName)
-            {
-                if (loc.contains(LABEL) && static_cast<std::string>(loc.at(LABEL).at(KIND)) == kind)
-                {
-                    resultLabel = static_cast<std::string>(loc.at(LABEL).at(TEXT));
-                    if (replaceColon)
-                        std::replace(resultLabel.begin(), resultLabel.end(), ',', ';');
-                }
-            }
-        }
-        return resultLabel;
+        if (taTemplate.contains(LOCATION))
+            getJsonPtrAsArray(&taTemplate.at(LOCATION));
+        if (taTemplate.contains(TRANSITION))
+            getJsonPtrAsArray(&taTemplate.at(TRANSITION));
     }
 
 
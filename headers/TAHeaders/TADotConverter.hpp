@@ -1,12 +1,17 @@
 #ifndef UTOTPARSER_TADOTCONVERTER_HPP
 #define UTOTPARSER_TADOTCONVERTER_HPP
 
+#include <algorithm>
 #include "nlohmann/json.hpp"
 
 #include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TALabelParser.hpp"
+#include "TAHeaders/TAGraph.hpp"
 #include "utilities/JsonHelper.hpp"
 #include "utilities/Utils.hpp"
 #include "defines/GraphvizParameters.h"
+#include "defines/ANSI-color-codes.h"
+#include "utilities/OutputBuffer.hpp"
 
 using json = nlohmann::json;
 
@@ -17,137 +22,112 @@ private:
     const std::string outFilePath;
 
 
-    /**
-     * Method use to escape html characters since we're using a graphviz html representation.
-     * @param stringToSanitize the string to sanitize.
-     * @return a string where the specified html characters are escaped.
-     */
-    static std::string htmlSanitize(std::string stringToSanitize)
-    {
-        // Remember to first replace the '&' since otherwise the others derived
-        // from subsequent replacements will be substituted as well.
-        std::vector<std::pair<char, std::string>> symbolsAndStrings = {{ '&', "&amp;" },
-                                                                       { '<', "&lt;" },
-                                                                       { '>', "&gt;" }};
-        for (auto &sAs: symbolsAndStrings)
-            stringToSanitize = substituteCharInString(stringToSanitize, sAs.first, sAs.second);
-        return stringToSanitize;
-    }
-
-
     /**
      * Method used to write the starting part of the graphviz .dot file.
      * @param systemName the name of the system.
-     * @param out the stream in which to write the file.
+     * @param out the buffer in which to write the file.
      */
-    static void writeHeading(const std::string &systemName, std::ofstream &out)
+    static void writeHeading(const std::string &systemName, OutputBuffer &out)
     {
-        out << "digraph " << systemName << " {" << std::endl;
-        out << "fontname=\"" << FONT_NAME << "\"" << std::endl;
-        out << "node [fontname=\"" << FONT_NAME << "\"]" << std::endl;
-        out << "edge [fontname=\"" << FONT_NAME << "\"]" << std::endl;
-        out << "nodesep = " << NODESEP << ";" << std::endl;
-        out << "node [fixedsize=true, shape=" << NODE_SHAPE << ", width=" << NODE_WIDTH << ", height=" << NODE_HEIGHT << "];" << std::endl;
-        out.flush();
+        out << "digraph " << systemName << " {\n";
+        out << "fontname=\"" << FONT_NAME << "\"\n";
+        out << "node [fontname=\"" << FONT_NAME << "\"]\n";
+        out << "edge [fontname=\"" << FONT_NAME << "\"]\n";
+        out << "nodesep = " << NODESEP << ";\n";
+        out << "node [fixedsize=true, shape=" << NODE_SHAPE << ", width=" << NODE_WIDTH << ", height=" << NODE_HEIGHT << "];\n";
     }
 
 
     /**
      * Method used to write the locations part of the graphviz .dot file.
-     * @param locations a json representation of the TA's locations.
-     * @param initialLocation the name of the initial location.
-     * @param out the stream in which to write the file.
+     * Labels are written with html characters escaped, since we're using a graphviz html representation.
+     * @param ta the graph representation of the TA.
+     * @param out the buffer in which to write the file.
      */
-    static void writeLocations(json locations, const std::string &initialLocation, std::ofstream &out)
+    static void writeLocations(const TAGraph &ta, OutputBuffer &out)
     {
-        for (auto &location: locations)
-        {
+        ta.forEachLocation([&](uint32_t i, const GraphLocation &location) {
             bool isInitial = false, isFinal = false;
 
-            std::string locationID = static_cast<std::string>(location.at(ID));
-            std::string outString = "P_" + locationID + "[fontsize=\"" + std::string(LOCATION_FONT_SIZE) + "\", ";
-            // This is the 'label' attribute used in a typical .dot file.
-            std::string dotLabel = "label=<<FONT>" + locationID;
+            out << "P_";
+            ta.writeLocationName(out, i);
+            out << "[fontsize=\"" << LOCATION_FONT_SIZE << "\", ";
 
             // If the location is initial we mark it with a double circle.
-            if (locationID == initialLocation)
+            if (i == ta.getInitialLocation())
             {
                 isInitial = true;
-                outString.append(INIT_NODE_SHAPE);
+                out << INIT_NODE_SHAPE;
             }
 
-            // If the location contains an invariant, we have to add it to the node as a label info.
-            if (location.contains(LABEL) && location.at(LABEL).contains(KIND))
-                if (static_cast<std::string>(location.at(LABEL).at(KIND)) == INVARIANT)
-                    dotLabel.append("<BR />" + htmlSanitize(static_cast<std::string>(location.at(LABEL).at(TEXT))));
-
             // As we assume that in UPPAAL a colored location is also final, also here we mark a final location with a color.
-            if (location.contains(COLOR))
+            if (location.isFinal)
             {
-                (isInitial) ? outString.append(", ") : outString;
-                outString.append(FINAL_NODE_STYLE);
+                if (isInitial)
+                    out << ", ";
+                out << FINAL_NODE_STYLE;
                 isFinal = true;
             }
 
-            dotLabel.append("</FONT>>");
-            (isInitial || isFinal) ? outString.append(", " + dotLabel) : outString.append(dotLabel);
+            // This is the 'label' attribute used in a typical .dot file.
+            if (isInitial || isFinal)
+                out << ", ";
+            out << "label=<<FONT>";
+            ta.writeLocationName(out, i);
 
-            outString.append("];\n");
-            out << outString;
-        }
-        out.flush();
+            // If the location contains an invariant, we have to add it to the node as a label info.
+            if (location.invariant != STRING_POOL_NONE)
+                out << "<BR />" << location.invariantExpression->htmlText;
+
+            out << "</FONT>>];\n";
+            out.flushIfFull();
+        });
     }
 
 
     /**
      * Method used to write the transitions part of the graphviz .dot file.
-     * @param transitions a json representation of the TA's transitions.
-     * @param out the stream in which to write the file.
+     * @param ta the graph representation of the TA.
+     * @param out the buffer in which to write the file.
      */
-    static void writeTransitions(json transitions, std::ofstream &out)
+    static void writeTransitions(const TAGraph &ta, OutputBuffer &out)
     {
-        for (auto &transition: transitions)
-        {
-            std::string outString =
-                    "P_" + static_cast<std::string>(transition.at(SOURCE).at(REF)) + " -> " +
-                    "P_" + static_cast<std::string>(transition.at(TARGET).at(REF)) +
-                    " [arrowsize=" + std::string(ARROW_SIZE) + ", fontsize=\"" + std::string(EDGE_FONT_SIZE) + "\"";
+        ta.forEachEdge([&](uint32_t, const GraphEdge &transition) {
+            out << "P_";
+            ta.writeLocationName(out, transition.source);
+            out << " -> " << "P_";
+            ta.writeLocationName(out, transition.target);
+            out << " [arrowsize=" << ARROW_SIZE << ", fontsize=\"" << EDGE_FONT_SIZE << "\"";
 
-            std::string dotLabel = "label=<<FONT> <FONT COLOR=\"" + std::string(NODE_LABEL_COLOR) + "\">a</FONT>";
+            out << "label=<<FONT> <FONT COLOR=\"" << NODE_LABEL_COLOR << "\">a</FONT>";
 
-            if (transition.contains(LABEL))
-            {
-                json labels = transition.at(LABEL);
-                dotLabel.append(writeTransitions_helper(getJsonAsArray(labels)));
-            }
+            writeTransitions_helper(ta, transition, out);
 
-            outString.append(dotLabel + "</FONT>>];\n");
-            out << outString;
-        }
-        out.flush();
+            out << "</FONT>>];\n";
+            out.flushIfFull();
+        });
     }
 
 
     /**
      * Helper method used to write the text inside a transition.
-     * @param labels the transition's labels which content will be written in the graphviz .dot file.
-     * @return a string which contains a properly formatted text according to the labels content.
+     * @param ta the graph representation of the TA.
+     * @param transition the transition whose labels will be written in the graphviz .dot file.
+     * @param out the buffer in which to write the file.
      */
-    static std::string writeTransitions_helper(json labels)
+    static void writeTransitions_helper(const TAGraph &ta, const GraphEdge &transition, OutputBuffer &out)
     {
-        std::string dotLabelAddition;
-
-        for (auto &label: labels)
+        for (uint32_t i = 0; i < transition.labelCount; i++)
         {
-            std::string labelText = static_cast<std::string>(label.at(TEXT));
-            std::string labelKind = static_cast<std::string>(label.at(KIND));
+            const GraphLabel &label = ta.getLabel(transition, i);
+            const auto &labelKind = TAGraph::getString(label.kind);
 
-            if (labelKind == GUARD)
-                dotLabelAddition.append("<BR /><FONT COLOR=\"" + std::string(GUARD_COLOR) + "\">" + htmlSanitize(labelText) + "</FONT>");
-            if (labelKind == ASSIGNMENT)
-                dotLabelAddition.append("<BR /><FONT COLOR=\"" + std::string(ASSIGNMENT_COLOR) + "\">" + htmlSanitize(labelText) + "</FONT>");
+            if (labelKind == GUARD || labelKind == ASSIGNMENT)
+            {
+                out << "<BR /><FONT COLOR=\"" << ((labelKind == GUARD) ? GUARD_COLOR : ASSIGNMENT_COLOR) << "\">"
+                    << label.expression->htmlText << "</FONT>";
+            }
         }
-        return dotLabelAddition;
     }
 
 
@@ -157,29 +137,47 @@ public:
 
 
     /**
-     * Method used to translate a TA from .xml format to .dot format.
+     * Method used to translate a TA to .dot format.
      * @param systemName the name of the system to translate.
-     * @param inFile a json representation of the TA.
+     * @param ta the graph representation of the TA.
+     * @return true if the file has been written, false otherwise.
      */
-    void translateTAtoDot(const std::string &systemName, const json &inFile)
+    bool translateTAtoDot(const std::string &systemName, const TAGraph &ta)
     {
-        std::ofstream out;
-        out.open(outFilePath, std::ofstream::out | std::ofstream::trunc);
+        // A rough estimate of the size of the .dot file, so that the buffer is (almost) never reallocated.
+        // Since the buffer is written out whenever it is full, its size is bounded even for huge TAs.
+        OutputBuffer out(std::min<size_t>(OUTPUT_BUFFER_DEFAULT_CAPACITY + 128 * ta.getLocationCount() + 192 * ta.getEdgeCount(),
+                                          OUTPUT_BUFFER_FLUSH_THRESHOLD + OUTPUT_BUFFER_DEFAULT_CAPACITY));
+        bool isStreaming = out.startStreaming(outFilePath);
 
         std::cout << "Writing heading." << std::endl;
         writeHeading(systemName, out);
 
         std::cout << "Writing locations." << std::endl;
-        json locations = TAContentExtractor::getLocations(inFile);
-        writeLocations(getJsonAsArray(locations), TAContentExtractor::getInitialLocationName(inFile), out);
+        writeLocations(ta, out);
 
         std::cout << "Writing transitions." << std::endl;
-        writeTransitions(getJsonAsArray(TAContentExtractor::getTransitions(inFile)), out);
+        writeTransitions(ta, out);
+
+        out << "overlap=false;\n}\n";
+
+        if (isStreaming && out.finishStreaming())
+            return true;
+
+        std::cerr << BHRED << "Failed to write file: " << outFilePath << rstColor << std::endl;
+        return false;
+    }
 
-        out << "overlap=false;\n}" << std::endl;
-        out.flush();
 
-        out.close();
+    /**
+     * Method used to translate a TA from .xml format to .dot format.
+     * @param systemName the name of the system to translate.
+     * @param inFile a json representation of the TA.
+     * @return true if the file has been written, false otherwise.
+     */
+    bool translateTAtoDot(const std::string &systemName, const json &inFile)
+    {
+        return translateTAtoDot(systemName, TAGraph::fromJson(inFile));
     }
 
 };
@@ -0,0 +1,1098 @@
+#ifndef UTOTPARSER_TAGRAPH_H
+#define UTOTPARSER_TAGRAPH_H
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+#include "defines/UPPAALxmlAttributes.h"
+#include "utilities/JsonHelper.hpp"
+#include "utilities/StringPool.hpp"
+#include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TALabelParser.hpp"
+
+using json = nlohmann::json;
+
+
+/**
+ * Struct representing a location of a TAGraph.
+ * Strings are stored as indexes inside the string pool of TAGraph (STRING_POOL_NONE if absent).
+ */
+typedef struct gl {
+    // The id of the location, as written in the tile it comes from.
+    uint32_t id;
+    // The text of the location's name, as written in the tile it comes from (e.g., 'in' or 'out' for the locations used
+    // to connect tiles). Whether a location is still a port of the graph is told by the port lists of the graph.
+    uint32_t name;
+    // The text of the location's invariant.
+    uint32_t invariant;
+    // The parsed invariant, nullptr if the location has no invariant.
+    const LabelExpression *invariantExpression;
+    // The text of the location's comments.
+    uint32_t comments;
+    // True if the location is colored, i.e., final.
+    bool isFinal;
+    // The json element from which the location has been built, used only when converting the TA back to json
+    // (nullptr for locations of randomly-generated tiles, which are described by their record only).
+    const json *prototype;
+} GraphLocation;
+
+
+/**
+ * Struct representing a label of a transition of a TAGraph.
+ */
+typedef struct glb {
+    uint32_t kind;
+    uint32_t text;
+    // The parsed label, shared by all the labels with the same kind and text.
+    const LabelExpression *expression;
+} GraphLabel;
+
+
+/**
+ * Struct representing a transition of a TAGraph.
+ */
+typedef struct ge {
+    // The id of the transition, as written in the tile it comes from.
+    uint32_t id;
+    // The positions of the source and target locations inside the locations of the TAGraph.
+    uint32_t source;
+    uint32_t target;
+    // The position of the first label of the transition inside the labels of the TAGraph, and the number of labels.
+    uint32_t firstLabel;
+    uint32_t labelCount;
+    // The json element from which the transition has been built (nullptr for transitions added by connectors and for
+    // the ones of randomly-generated tiles).
+    const json *prototype;
+} GraphEdge;
+
+
+/**
+ * Struct representing the records of one or more tiles, stored in flat arrays.
+ * Positions stored inside the records (endpoints and labels of the transitions) are relative to the segment holding them.
+ * Records may be shared by many graphs (e.g., by all the instances of a tile), in which case they are never changed.
+ */
+typedef struct grc {
+    std::vector<GraphLocation> locations {};
+    std::vector<GraphEdge> edges {};
+    std::vector<GraphLabel> labels {};
+} GraphRecords;
+
+
+/**
+ * Struct representing a contiguous block of positions of a TAGraph, which records are stored together.
+ */
+typedef struct gsg {
+    // The records of the segment, copied by getWritableRecords before being changed if they are shared.
+    std::shared_ptr<GraphRecords> records;
+    // The positions in the graph of the first location, transition and label of the segment.
+    uint32_t firstLocation;
+    uint32_t firstEdge;
+    uint32_t firstLabel;
+    // The offset to add to the endpoints of the transitions of the segment to get their positions in the graph.
+    // It differs from 'firstLocation' for the segments holding the transitions added by connectors, which endpoints
+    // may be anywhere in the graph.
+    uint32_t endpointsOffset;
+} GraphSegment;
+
+
+/**
+ * Struct representing the ids of the locations of a tile instance.
+ */
+typedef struct gti {
+    // The position of the first location of the tile instance inside the graph.
+    uint32_t firstLocation;
+    // The position of each location relative to the first one, given its id.
+    std::shared_ptr<const std::unordered_map<uint32_t, uint32_t>> ids;
+} GraphTileIds;
+
+
+// Compact representation of a TA used while composing tiles and while emitting .tck and .dot files.
+// -------------------------------------------------------------------------------------------------
+// Locations and transitions are stored in flat arrays, in the same order as in the json representation, and refer to
+// each other through their positions. Every string (ids, names, labels) is interned once in a string pool shared by
+// all the graphs, so that a record costs a few integers instead of a tree of json objects.
+// The arrays are split in segments, each covering a contiguous block of positions. Segments share their records: every
+// instance of a tile refers to the records of the tile prototype kept by the TileLibrary, and records are copied only
+// when they have to be changed (copy-on-write). Renaming an instance, deleting its port names and connecting it to other
+// tiles never changes its records, since instance numbers, ports and added transitions are stored in the graph. When composing eagerly (the default),
+// a graph has a single segment and merging two graphs appends the records of the smaller one to the arrays of the
+// bigger one. When composing lazily, merging never copies records: the segments of the smaller graph are moved into
+// the bigger one, hence a composed graph is the DAG of its tile instances (one segment each) plus the segments holding
+// the transitions added by connectors, and the emitters stream the records straight from the segments.
+// The 'in' and 'out' locations of each graph are kept in port lists, so that operators and connectors never have to
+// look locations up by name. Port lists follow the emission order (not the positions), since connectors pick ports by
+// their order (e.g., the first 'out' location): this way, which graph is moved into the other never changes the result.
+// Since the records of the left graph may be stored after the ones of the right graph, the order in which the records
+// are emitted is kept separately, as a list of ranges of positions: merging never moves the records of the bigger
+// graph, and its cost only depends on the size of the smaller one.
+// The json elements the graph has been built from are referenced (not copied) and are only used to give back the
+// UPPAAL json representation, with all its attributes, when the TA has to be printed.
+// Ids are never rewritten: each tile instance is given a number, and the printable name of a location or transition
+// (its id followed by "T" and the instance number, e.g., id3T12) is derived only when the TA is emitted.
+// Since the records of an instance are contiguous, instances are stored as ranges of positions, hence renaming a tile
+// costs O(1) regardless of its size.
+
+class TAGraph {
+
+private:
+    // The pool containing all the strings referenced by the graphs.
+    static StringPool strings;
+
+    // True if graphs are composed lazily, i.e., without copying the records of the merged graphs.
+    static bool lazyComposition;
+
+    // The parsed labels referenced by the records, given the indexes of their kind and text in the string pool: each
+    // distinct label is parsed once, when the first record holding it is built, and is never moved afterwards.
+    static std::unordered_map<uint64_t, LabelExpression> labelExpressions;
+
+    static std::mutex labelExpressionsMutex;
+
+    // The json representations the graph has been built from, which are kept alive since the records point to their elements.
+    std::vector<std::shared_ptr<const json>> sources {};
+
+    // The json of the TA on the left of every composition, which provides declarations and the template.
+    std::shared_ptr<const json> header {};
+
+    // The segments holding the records, sorted by position.
+    std::vector<GraphSegment> segments {};
+
+    uint32_t locationCount {};
+
+    uint32_t edgeCount {};
+
+    uint32_t labelCount {};
+
+    // The positions of the locations named 'in' and 'out', in the order the locations are emitted.
+    std::vector<uint32_t> inPorts {};
+
+    std::vector<uint32_t> outPorts {};
+
+    // The position of the initial location, STRING_POOL_NONE if the initial location is not among the locations.
+    uint32_t initial { STRING_POOL_NONE };
+
+    // The instance number of the locations and transitions, as pairs { first position, instance number } sorted by
+    // position: each pair covers the records up to the next one. Records not covered by any pair, or covered by
+    // STRING_POOL_NONE, do not belong to a renamed tile instance and are printed with their id only.
+    std::vector<std::pair<uint32_t, uint32_t>> locationInstances {};
+
+    std::vector<std::pair<uint32_t, uint32_t>> edgeInstances {};
+
+    // The ids of the locations of the tiles, given their instance number. The ids of a tile are shared by all its
+    // instances and only the position of its first location is stored, so that a tile instance can be renamed, or
+    // merged with another graph, without touching its locations.
+    std::unordered_map<uint32_t, std::vector<GraphTileIds>> locationIndex {};
+
+    // The order in which locations and transitions are emitted, as ranges [first position, last position + 1).
+    std::deque<std::pair<uint32_t, uint32_t>> locationOrder {};
+
+    std::deque<std::pair<uint32_t, uint32_t>> edgeOrder {};
+
+
+    /**
+     * Method used to get the interned text of an optional label of a location, given its kind.
+     * Location labels are taken into account only when they are single labels (this is how they are handled by the emitters).
+     * @param location the json representation of the location.
+     * @param kind the kind of the label to get.
+     * @return the index of the label text, STRING_POOL_NONE if the location has no such label.
+     */
+    static uint32_t getLocationLabel(const json &location, const std::string &kind)
+    {
+        if (!location.contains(LABEL) || !location.at(LABEL).contains(KIND) || location.at(LABEL).at(KIND).get_ref<const std::string &>() != kind)
+            return STRING_POOL_NONE;
+        return strings.intern(location.at(LABEL).at(TEXT).get_ref<const std::string &>());
+    }
+
+
+    /**
+     * Method used to get the json representation of a location built without a json element, as it would be given by UPPAAL.
+     * Such locations are never final, since they only come from randomly-generated tiles.
+     * @param location the record of the location.
+     * @return the json representation of the location, without its identifier.
+     */
+    static json getLocationJson(const GraphLocation &location)
+    {
+        json result = json::object();
+        if (location.name != STRING_POOL_NONE)
+            result[NAME] = {{ TEXT, strings.get(location.name) }};
+        if (location.invariant != STRING_POOL_NONE)
+            result[LABEL] = {{ TEXT, strings.get(location.invariant) }, { KIND, INVARIANT }};
+        else if (location.comments != STRING_POOL_NONE)
+            result[LABEL] = {{ TEXT, strings.get(location.comments) }, { KIND, COMMENTS }};
+        return result;
+    }
+
+
+    /**
+     * Method used to get the json representation of the labels of a transition built without a json element.
+     * As in the json given by UPPAAL, a single label is an object, while more labels are an array.
+     * @param edge the record of the transition.
+     * @return the json representation of the labels of the transition.
+     */
+    [[nodiscard]] json getLabelsJson(const GraphEdge &edge) const
+    {
+        json result = json::array();
+        for (uint32_t i = 0; i < edge.labelCount; i++)
+            result.push_back({{ TEXT, strings.get(getLabel(edge, i).text) }, { KIND, strings.get(getLabel(edge, i).kind) }});
+        return (result.size() == 1) ? json(std::move(result[0])) : result;
+    }
+
+
+    std::vector<uint32_t> &getPortsRef(const std::string &portName)
+    {
+        return (portName == IN) ? inPorts : outPorts;
+    }
+
+
+    /**
+     * Method used to tell if the name of a location has been deleted, i.e., if the location was a port of its tile and
+     * it has been used to connect tiles.
+     * @param sortedInPorts the 'in' ports of the graph, sorted by position.
+     * @param sortedOutPorts the 'out' ports of the graph, sorted by position.
+     */
+    static bool isDeletedPort(uint32_t position, const GraphLocation &location,
+                              const std::vector<uint32_t> &sortedInPorts, const std::vector<uint32_t> &sortedOutPorts)
+    {
+        if (location.name == STRING_POOL_NONE)
+            return false;
+
+        const std::string &name = strings.get(location.name);
+        if (name != IN && name != OUT)
+            return false;
+
+        const std::vector<uint32_t> &ports = (name == IN) ? sortedInPorts : sortedOutPorts;
+        return !std::binary_search(ports.begin(), ports.end(), position);
+    }
+
+
+    /**
+     * Method used to add the ports of a graph whose records have been appended to the ones of this graph.
+     * @param ports the ports of this graph.
+     * @param otherPorts the ports of the appended graph.
+     * @param offset the offset to add to the positions of the appended graph.
+     * @param isEmittedFirst true if the locations of the appended graph are emitted before the ones of this graph.
+     */
+    static void appendPorts(std::vector<uint32_t> &ports, const std::vector<uint32_t> &otherPorts, uint32_t offset, bool isEmittedFirst)
+    {
+        auto first = ports.insert(isEmittedFirst ? ports.begin() : ports.end(), otherPorts.begin(), otherPorts.end());
+        for (auto port = first; port != first + static_cast<std::ptrdiff_t>(otherPorts.size()); ++port)
+            *port += offset;
+    }
+
+
+    /**
+     * Method used to find the segment holding a given position.
+     * Empty segments never hold a position, since they are always followed by the segment starting at the same position.
+     * @param position the position of the record.
+     * @param first the member of the segments telling the position of their first record of the wanted kind.
+     * @return the index of the segment holding the record.
+     */
+    [[nodiscard]] size_t findSegment(uint32_t position, uint32_t GraphSegment::*first) const
+    {
+        auto next = std::upper_bound(segments.begin(), segments.end(), position,
+                                     [first](uint32_t pos, const GraphSegment &segment) { return pos < segment.*first; });
+        return static_cast<size_t>(std::prev(next) - segments.begin());
+    }
+
+
+    /**
+     * Method used to get a transition with its endpoints and labels referring to positions in the graph.
+     */
+    static GraphEdge resolveEdge(const GraphSegment &segment, uint32_t position)
+    {
+        GraphEdge edge = segment.records->edges[position - segment.firstEdge];
+        edge.source += segment.endpointsOffset;
+        edge.target += segment.endpointsOffset;
+        edge.firstLabel += segment.firstLabel;
+        return edge;
+    }
+
+
+    /**
+     * Method used to get the records of a segment in order to change them, copying them first if they are shared.
+     */
+    static GraphRecords &getWritableRecords(GraphSegment &segment)
+    {
+        if (segment.records.use_count() > 1)
+            segment.records = std::make_shared<GraphRecords>(*segment.records);
+        return *segment.records;
+    }
+
+
+    /**
+     * Method used to get the records to which transitions added by connectors are appended.
+     * When composing eagerly, these are the records of the only segment of the graph. When composing lazily, they are
+     * the records of the last segment, unless it belongs to a tile instance or it has been moved from another graph,
+     * in which cases a new segment is added.
+     */
+    GraphRecords &getOverlay()
+    {
+        if (segments.empty() || (lazyComposition && (!segments.back().records->locations.empty() || segments.back().endpointsOffset != 0)))
+            segments.push_back({ std::make_shared<GraphRecords>(), locationCount, edgeCount, labelCount, 0 });
+        return getWritableRecords(segments.back());
+    }
+
+
+    /**
+     * Method used to get the instance number covering a given position.
+     * @param instances the instance ranges, sorted by position.
+     * @param position the position of the record.
+     * @return the instance number of the record, STRING_POOL_NONE if it does not belong to a tile instance.
+     */
+    static uint32_t getInstance(const std::vector<std::pair<uint32_t, uint32_t>> &instances, uint32_t position)
+    {
+        // The range containing the position is the last one starting at or before it.
+        auto next = std::upper_bound(instances.begin(), instances.end(), position,
+                                     [](uint32_t pos, const std::pair<uint32_t, uint32_t> &range) { return pos < range.first; });
+        return (next == instances.begin()) ? STRING_POOL_NONE : std::prev(next)->second;
+    }
+
+
+    /**
+     * Method used to add the instance ranges of an appended graph.
+     */
+    static void appendInstances(std::vector<std::pair<uint32_t, uint32_t>> &instances, const std::vector<std::pair<uint32_t, uint32_t>> &otherInstances, uint32_t offset)
+    {
+        // The records of the appended graph not covered by its ranges must not be covered by the last range of this graph.
+        if (otherInstances.empty() || otherInstances.front().first != 0)
+            instances.emplace_back(offset, STRING_POOL_NONE);
+        for (const auto &range: otherInstances)
+            instances.emplace_back(range.first + offset, range.second);
+    }
+
+
+    /**
+     * Method used to add a range of positions at the end of an emission order, joining it to the last range when contiguous.
+     */
+    static void pushBackRange(std::deque<std::pair<uint32_t, uint32_t>> &order, uint32_t first, uint32_t last)
+    {
+        if (first == last)
+            return;
+        if (!order.empty() && order.back().second == first)
+            order.back().second = last;
+        else
+            order.emplace_back(first, last);
+    }
+
+
+    /**
+     * Method used to add a range of positions at the beginning of an emission order, joining it to the first range when contiguous.
+     */
+    static void pushFrontRange(std::deque<std::pair<uint32_t, uint32_t>> &order, uint32_t first, uint32_t last)
+    {
+        if (first == last)
+            return;
+        if (!order.empty() && order.front().first == last)
+            order.front().first = first;
+        else
+            order.emplace_front(first, last);
+    }
+
+
+    /**
+     * Method used to add the ids of the tiles of an instance to the index of this graph.
+     * @param instance the instance number of the tiles.
+     * @param tiles the ids of the tiles, which are moved.
+     */
+    void mergeIndex(uint32_t instance, std::vector<GraphTileIds> &&tiles)
+    {
+        std::vector<GraphTileIds> &indexed = locationIndex[instance];
+        if (indexed.empty())
+            indexed = std::move(tiles);
+        else
+            indexed.insert(indexed.end(), std::make_move_iterator(tiles.begin()), std::make_move_iterator(tiles.end()));
+    }
+
+
+    /**
+     * Method used to move the records of another graph after the ones of this graph.
+     * When composing eagerly the records are copied in the arrays of this graph, otherwise the segments of the other
+     * graph are moved as they are.
+     * The emission order, the ports, the header and the initial location are left to the caller.
+     * @param other the graph which records have to be moved.
+     * @return the positions in this graph of the first location and of the first transition coming from the other graph.
+     */
+    std::pair<uint32_t, uint32_t> appendRecords(TAGraph &other)
+    {
+        uint32_t offset = locationCount;
+        uint32_t edgesOffset = edgeCount;
+        uint32_t labelsOffset = labelCount;
+
+        if (lazyComposition)
+        {
+            segments.reserve(segments.size() + other.segments.size());
+            for (GraphSegment &segment: other.segments)
+            {
+                segment.firstLocation += offset;
+                segment.firstEdge += edgesOffset;
+                segment.firstLabel += labelsOffset;
+                segment.endpointsOffset += offset;
+                segments.push_back(std::move(segment));
+            }
+        } else
+        {
+            GraphRecords &records = getOverlay();
+            for (const GraphSegment &segment: other.segments)
+            {
+                const GraphRecords &otherRecords = *segment.records;
+                auto firstLabel = static_cast<uint32_t>(records.labels.size());
+                records.locations.insert(records.locations.end(), otherRecords.locations.begin(), otherRecords.locations.end());
+                records.labels.insert(records.labels.end(), otherRecords.labels.begin(), otherRecords.labels.end());
+
+                records.edges.reserve(records.edges.size() + otherRecords.edges.size());
+                for (GraphEdge edge: otherRecords.edges)
+                {
+                    edge.source += segment.endpointsOffset + offset;
+                    edge.target += segment.endpointsOffset + offset;
+                    edge.firstLabel += firstLabel;
+                    records.edges.push_back(edge);
+                }
+            }
+        }
+
+        locationCount += other.locationCount;
+        edgeCount += other.edgeCount;
+        labelCount += other.labelCount;
+
+        appendInstances(locationInstances, other.locationInstances, offset);
+        appendInstances(edgeInstances, other.edgeInstances, edgesOffset);
+
+        for (auto &instanceIndex: other.locationIndex)
+        {
+            for (GraphTileIds &tile: instanceIndex.second)
+                tile.firstLocation += offset;
+            mergeIndex(instanceIndex.first, std::move(instanceIndex.second));
+        }
+
+        sources.insert(sources.end(), std::make_move_iterator(other.sources.begin()), std::make_move_iterator(other.sources.end()));
+
+        return { offset, edgesOffset };
+    }
+
+
+    /**
+     * Method used to estimate the cost of moving the records of the graph into another one.
+     */
+    [[nodiscard]] size_t getMergeCost() const
+    {
+        return lazyComposition ? segments.size() : static_cast<size_t>(locationCount) + edgeCount;
+    }
+
+
+    /**
+     * Method used to write the printable name of a record, given its id and its instance number.
+     */
+    template<typename Out>
+    static void writeName(Out &out, uint32_t id, uint32_t instance)
+    {
+        out << strings.get(id);
+        if (instance != STRING_POOL_NONE)
+            out << 'T' << static_cast<long long>(instance);
+    }
+
+
+    // Graphs are copied only by instantiate, since a copy shares the records of the original graph.
+    TAGraph(const TAGraph &) = default;
+
+
+public:
+    TAGraph() = default;
+
+
+    // Otherwise, graphs are never copied: their ownership is transferred, from the parser stacks to the operators and back.
+    TAGraph &operator=(const TAGraph &) = delete;
+
+
+    TAGraph(TAGraph &&) = default;
+
+
+    TAGraph &operator=(TAGraph &&) = default;
+
+
+    /**
+     * Method used to choose how graphs are composed.
+     * It must be called before any graph is built, since graphs composed in different ways cannot be merged.
+     * @param lazy true if the records of the merged graphs have to be referenced instead of copied.
+     */
+    static void setLazyComposition(bool lazy)
+    {
+        lazyComposition = lazy;
+    }
+
+
+    /**
+     * Method used to build a graph out of the json representation of a TA.
+     * @param source the json representation of the TA, which will be shared (not copied) by the graph.
+     * @return the graph representing the TA.
+     */
+    static TAGraph fromJson(std::shared_ptr<const json> source)
+    {
+        TAGraph graph;
+        const json &ta = *source;
+        const json &taTemplate = ta.at(NTA).at(TEMPLATE);
+        auto records = std::make_shared<GraphRecords>();
+
+        uint32_t initialID = strings.intern(TAContentExtractor::getInitialLocationName(ta));
+
+        // The locations are numbered in order of appearance, and indexed by id to resolve the transitions' endpoints.
+        auto locationPositions = std::make_shared<std::unordered_map<uint32_t, uint32_t>>();
+        if (taTemplate.contains(LOCATION))
+        {
+            records->locations.reserve(getJsonArraySize(taTemplate.at(LOCATION)));
+            forEachJsonElement(taTemplate.at(LOCATION), [&](const json &location) {
+                GraphLocation graphLocation {};
+                graphLocation.id = strings.intern(location.at(ID).get_ref<const std::string &>());
+                graphLocation.name = location.contains(NAME) ? strings.intern(location.at(NAME).at(TEXT).get_ref<const std::string &>()) : STRING_POOL_NONE;
+                graphLocation.invariant = getLocationLabel(location, INVARIANT);
+                graphLocation.invariantExpression = (graphLocation.invariant != STRING_POOL_NONE) ? parseLabel(strings.intern(INVARIANT), graphLocation.invariant) : nullptr;
+                graphLocation.comments = getLocationLabel(location, COMMENTS);
+                graphLocation.isFinal = location.contains(COLOR);
+                graphLocation.prototype = &location;
+
+                auto position = static_cast<uint32_t>(records->locations.size());
+                locationPositions->emplace(graphLocation.id, position);
+                if (graphLocation.name != STRING_POOL_NONE && strings.get(graphLocation.name) == IN)
+                    graph.inPorts.push_back(position);
+                if (graphLocation.name != STRING_POOL_NONE && strings.get(graphLocation.name) == OUT)
+                    graph.outPorts.push_back(position);
+                records->locations.push_back(graphLocation);
+            });
+        }
+
+        auto initialPosition = locationPositions->find(initialID);
+        graph.initial = (initialPosition != locationPositions->end()) ? initialPosition->second : STRING_POOL_NONE;
+
+        if (taTemplate.contains(TRANSITION))
+        {
+            records->edges.reserve(getJsonArraySize(taTemplate.at(TRANSITION)));
+            forEachJsonElement(taTemplate.at(TRANSITION), [&](const json &transition) {
+                GraphEdge edge {};
+                edge.id = strings.intern(transition.at(ID).get_ref<const std::string &>());
+                edge.source = locationPositions->at(strings.intern(transition.at(SOURCE).at(REF).get_ref<const std::string &>()));
+                edge.target = locationPositions->at(strings.intern(transition.at(TARGET).at(REF).get_ref<const std::string &>()));
+                edge.firstLabel = static_cast<uint32_t>(records->labels.size());
+                edge.prototype = &transition;
+
+                if (transition.contains(LABEL))
+                    forEachJsonElement(transition.at(LABEL), [&](const json &label) {
+                        uint32_t kind = strings.intern(label.at(KIND).get_ref<const std::string &>());
+                        uint32_t text = strings.intern(label.at(TEXT).get_ref<const std::string &>());
+                        records->labels.push_back({ kind, text, parseLabel(kind, text) });
+                    });
+                edge.labelCount = static_cast<uint32_t>(records->labels.size()) - edge.firstLabel;
+                records->edges.push_back(edge);
+            });
+        }
+
+        graph.locationCount = static_cast<uint32_t>(records->locations.size());
+        graph.edgeCount = static_cast<uint32_t>(records->edges.size());
+        graph.labelCount = static_cast<uint32_t>(records->labels.size());
+        graph.segments.push_back({ std::move(records), 0, 0, 0, 0 });
+        graph.locationIndex[STRING_POOL_NONE].push_back({ 0, std::move(locationPositions) });
+
+        pushBackRange(graph.locationOrder, 0, graph.locationCount);
+        pushBackRange(graph.edgeOrder, 0, graph.edgeCount);
+
+        graph.header = source;
+        graph.sources.push_back(std::move(source));
+        return graph;
+    }
+
+
+    /**
+     * Method used to build a graph straight from its records, as randomly-generated tiles are, without going through
+     * their json representation: since such tiles may have hundreds of thousands of locations and transitions, building
+     * (and then reading) one json element for each of them would cost much more than generating the tile itself.
+     * The records must not have any json element, and the endpoints of their transitions are positions of their locations.
+     * @param header the json representation of the TA without locations and transitions, providing its declarations.
+     * @param records the records of the TA.
+     * @param initial the position of the initial location, STRING_POOL_NONE if there is none.
+     * @return the graph representing the TA.
+     */
+    static TAGraph fromRecords(std::shared_ptr<const json> header, GraphRecords &&records, uint32_t initial)
+    {
+        TAGraph graph;
+
+        auto locationPositions = std::make_shared<std::unordered_map<uint32_t, uint32_t>>();
+        locationPositions->reserve(records.locations.size());
+        for (uint32_t position = 0; position < records.locations.size(); position++)
+        {
+            const GraphLocation &location = records.locations[position];
+            locationPositions->emplace(location.id, position);
+            if (location.name != STRING_POOL_NONE && strings.get(location.name) == IN)
+                graph.inPorts.push_back(position);
+            if (location.name != STRING_POOL_NONE && strings.get(location.name) == OUT)
+                graph.outPorts.push_back(position);
+        }
+
+        graph.initial = initial;
+        graph.locationCount = static_cast<uint32_t>(records.locations.size());
+        graph.edgeCount = static_cast<uint32_t>(records.edges.size());
+        graph.labelCount = static_cast<uint32_t>(records.labels.size());
+        graph.segments.push_back({ std::make_shared<GraphRecords>(std::move(records)), 0, 0, 0, 0 });
+        graph.locationIndex[STRING_POOL_NONE].push_back({ 0, std::move(locationPositions) });
+
+        pushBackRange(graph.locationOrder, 0, graph.locationCount);
+        pushBackRange(graph.edgeOrder, 0, graph.edgeCount);
+
+        graph.header = header;
+        graph.sources.push_back(std::move(header));
+        return graph;
+    }
+
+
+    /**
+     * Method used to get a new instance of the TA, which shares the records of this graph instead of copying them.
+     * Only the few data telling how the instance is connected (ports, instance numbers, emission order) are copied,
+     * hence instantiating a tile prototype costs the same regardless of the size of the tile.
+     * @return the new instance, which has to be renamed in order to avoid name clashes with other instances.
+     */
+    [[nodiscard]] TAGraph instantiate() const
+    {
+        return TAGraph(*this);
+    }
+
+
+    /**
+     * Method used to build a graph out of the json representation of a TA, without taking ownership of it.
+     * Useful for emitting a TA: the given json must outlive the returned graph.
+     * @param ta the json representation of the TA.
+     * @return the graph representing the TA.
+     */
+    static TAGraph fromJson(const json &ta)
+    {
+        // A shared_ptr with an empty owner only points to the json, without ever deleting it.
+        return fromJson(std::shared_ptr<const json>(std::shared_ptr<const json>(), &ta));
+    }
+
+
+    /**
+     * Method used to give back the UPPAAL json representation of the TA.
+     * The declarations are the ones of the first TA the graph has been built from, as it happens when merging tiles.
+     * @return the json representation of the TA.
+     */
+    [[nodiscard]] json toJson() const
+    {
+        json result = *header;
+        json &taTemplate = result.at(NTA).at(TEMPLATE);
+
+        if (initial != STRING_POOL_NONE)
+            taTemplate.at(INIT).at(REF) = getLocationName(initial);
+
+        std::vector<uint32_t> sortedInPorts { getSortedPorts(IN) };
+        std::vector<uint32_t> sortedOutPorts { getSortedPorts(OUT) };
+
+        json resultLocations = json::array();
+        resultLocations.get_ref<json::array_t &>().reserve(locationCount);
+        forEachLocation([&](uint32_t position, const GraphLocation &location) {
+            json resultLocation = location.prototype ? *location.prototype : getLocationJson(location);
+            resultLocation[ID] = getLocationName(position);
+            // The names of the ports which have been used to connect tiles are deleted.
+            if (isDeletedPort(position, location, sortedInPorts, sortedOutPorts))
+                resultLocation.erase(NAME);
+            resultLocations.push_back(std::move(resultLocation));
+        });
+        taTemplate[LOCATION] = std::move(resultLocations);
+
+        json resultTransitions = json::array();
+        resultTransitions.get_ref<json::array_t &>().reserve(edgeCount);
+        forEachEdge([&](uint32_t position, const GraphEdge &edge) {
+            json resultTransition = edge.prototype ? *edge.prototype : json::object();
+            resultTransition[ID] = getEdgeName(position);
+            resultTransition[SOURCE][REF] = getLocationName(edge.source);
+            resultTransition[TARGET][REF] = getLocationName(edge.target);
+            if (!edge.prototype && edge.labelCount > 0)
+                resultTransition[LABEL] = getLabelsJson(edge);
+            resultTransitions.push_back(std::move(resultTransition));
+        });
+        taTemplate[TRANSITION] = std::move(resultTransitions);
+
+        return result;
+    }
+
+
+    /**
+     * Method used to get a string stored in the pool shared by the graphs.
+     * @param index the index of the string.
+     * @return a reference to the string.
+     */
+    static const std::string &getString(uint32_t index)
+    {
+        return strings.get(index);
+    }
+
+
+    /**
+     * Method used to get the parsed representation of a label, parsing it only if no record has held it so far.
+     * Labels are parsed when the records are built, so that the emitters read them straight from the records.
+     * @param kind the index of the kind of the label (guard, invariant, assignment, ...) in the string pool.
+     * @param text the index of the text of the label in the string pool.
+     * @return a pointer to the parsed label, which stays valid until the program ends.
+     */
+    static const LabelExpression *parseLabel(uint32_t kind, uint32_t text)
+    {
+        uint64_t key = (static_cast<uint64_t>(kind) << 32) | text;
+        {
+            std::lock_guard<std::mutex> lock(labelExpressionsMutex);
+            auto found = labelExpressions.find(key);
+            if (found != labelExpressions.end())
+                return &found->second;
+        }
+
+        // The label is parsed without holding the lock: if another thread parsed it meanwhile, its expression is kept.
+        LabelExpression expression = TALabelParser::parse(strings.get(kind), strings.get(text));
+        std::lock_guard<std::mutex> lock(labelExpressionsMutex);
+        return &labelExpressions.emplace(key, std::move(expression)).first->second;
+    }
+
+
+    /**
+     * Method used to add a string to the pool shared by the graphs.
+     * @param str the string to add.
+     * @return the index of the string.
+     */
+    static uint32_t internString(std::string_view str)
+    {
+        return strings.intern(str);
+    }
+
+
+    [[nodiscard]] uint32_t getLocationCount() const
+    {
+        return locationCount;
+    }
+
+
+    [[nodiscard]] uint32_t getEdgeCount() const
+    {
+        return edgeCount;
+    }
+
+
+    /**
+     * Method used to get a location given its position.
+     * @param position the position of the location.
+     * @return a reference to the location.
+     */
+    [[nodiscard]] const GraphLocation &getLocation(uint32_t position) const
+    {
+        const GraphSegment &segment = segments[findSegment(position, &GraphSegment::firstLocation)];
+        return segment.records->locations[position - segment.firstLocation];
+    }
+
+
+    /**
+     * Method used to get a transition given its position.
+     * @param position the position of the transition.
+     * @return the transition, with its endpoints and labels referring to positions in the graph.
+     */
+    [[nodiscard]] GraphEdge getEdge(uint32_t position) const
+    {
+        return resolveEdge(segments[findSegment(position, &GraphSegment::firstEdge)], position);
+    }
+
+
+    /**
+     * Method used to visit the locations in the order they have to be emitted, i.e., the order of the tiles in the compositional string.
+     * The locations are read straight from the segments holding them, without building the expanded TA.
+     * @param visitor a function called with the position of each location and the location itself.
+     */
+    template<typename Visitor>
+    void forEachLocation(Visitor &&visitor) const
+    {
+        for (const auto &range: locationOrder)
+        {
+            size_t s = findSegment(range.first, &GraphSegment::firstLocation);
+            for (uint32_t position = range.first; position < range.second; position++)
+            {
+                while (position - segments[s].firstLocation >= segments[s].records->locations.size())
+                    s++;
+                visitor(position, segments[s].records->locations[position - segments[s].firstLocation]);
+            }
+        }
+    }
+
+
+    /**
+     * Method used to visit the transitions in the order they have to be emitted, i.e., the order of the tiles in the
+     * compositional string, followed by the transitions added by connectors.
+     * The transitions are read straight from the segments holding them, without building the expanded TA.
+     * @param visitor a function called with the position of each transition and the transition itself.
+     */
+    template<typename Visitor>
+    void forEachEdge(Visitor &&visitor) const
+    {
+        for (const auto &range: edgeOrder)
+        {
+            size_t s = findSegment(range.first, &GraphSegment::firstEdge);
+            for (uint32_t position = range.first; position < range.second; position++)
+            {
+                while (position - segments[s].firstEdge >= segments[s].records->edges.size())
+                    s++;
+                visitor(position, resolveEdge(segments[s], position));
+            }
+        }
+    }
+
+
+    /**
+     * Method used to get a label of a transition.
+     * @param edge the transition, as given by forEachEdge or getEdge.
+     * @param i the index of the label among the labels of the transition.
+     * @return a reference to the label.
+     */
+    [[nodiscard]] const GraphLabel &getLabel(const GraphEdge &edge, uint32_t i) const
+    {
+        uint32_t position = edge.firstLabel + i;
+        const GraphSegment &segment = segments[findSegment(position, &GraphSegment::firstLabel)];
+        return segment.records->labels[position - segment.firstLabel];
+    }
+
+
+    [[nodiscard]] uint32_t getInitialLocation() const
+    {
+        return initial;
+    }
+
+
+    /**
+     * Method used to write the printable name of a location, i.e., its id followed by the number of its tile instance.
+     * @param out the stream or buffer in which to write the name.
+     * @param position the position of the location.
+     */
+    template<typename Out>
+    void writeLocationName(Out &out, uint32_t position) const
+    {
+        writeName(out, getLocation(position).id, getInstance(locationInstances, position));
+    }
+
+
+    /**
+     * Method used to get the printable name of a location, i.e., its id followed by the number of its tile instance.
+     * @param position the position of the location.
+     * @return the printable name of the location.
+     */
+    [[nodiscard]] std::string getLocationName(uint32_t position) const
+    {
+        std::ostringstream name;
+        writeLocationName(name, position);
+        return name.str();
+    }
+
+
+    /**
+     * Method used to get the printable name of a transition, i.e., its id followed by the number of its tile instance.
+     * @param position the position of the transition.
+     * @return the printable name of the transition.
+     */
+    [[nodiscard]] std::string getEdgeName(uint32_t position) const
+    {
+        std::ostringstream name;
+        writeName(name, getEdge(position).id, getInstance(edgeInstances, position));
+        return name.str();
+    }
+
+
+    /**
+     * Method used to make the graph a new tile instance, so that its ids do not clash with the ones of other instances
+     * of the same tile once they are merged. Nothing is rewritten: the instance number is only stored.
+     * @param instance the number of the instance.
+     */
+    void setInstance(uint32_t instance)
+    {
+        locationInstances.assign(1, { 0, instance });
+        edgeInstances.assign(1, { 0, instance });
+
+        std::unordered_map<uint32_t, std::vector<GraphTileIds>> previousIndex = std::move(locationIndex);
+        locationIndex.clear();
+        for (auto &instanceIndex: previousIndex)
+            mergeIndex(instance, std::move(instanceIndex.second));
+    }
+
+
+    /**
+     * Method used to find a location given its id and the number of its tile instance, i.e., given its printable name.
+     * @param id the id of the location, as written in its tile.
+     * @param instance the instance number of the tile (STRING_POOL_NONE for tiles that have not been renamed).
+     * @return the position of the location, STRING_POOL_NONE if there is no such location.
+     */
+    [[nodiscard]] uint32_t findLocation(const std::string &id, uint32_t instance) const
+    {
+        auto instanceIndex = locationIndex.find(instance);
+        if (instanceIndex == locationIndex.end())
+            return STRING_POOL_NONE;
+
+        uint32_t idIndex = strings.find(id);
+        for (const GraphTileIds &tile: instanceIndex->second)
+        {
+            auto found = tile.ids->find(idIndex);
+            if (found != tile.ids->end())
+                return tile.firstLocation + found->second;
+        }
+        return STRING_POOL_NONE;
+    }
+
+
+    [[nodiscard]] std::string getClocksDeclaration() const
+    {
+        return TAContentExtractor::getClocksDeclaration(*header);
+    }
+
+
+    [[nodiscard]] std::string getDeclaration() const
+    {
+        return TAContentExtractor::getDeclaration(*header);
+    }
+
+
+    /**
+     * Method used to get the positions of the locations having a given port name.
+     * @param portName the name of the port (either 'in' or 'out').
+     * @return the positions of the locations named 'portName', in the order the locations are emitted.
+     */
+    [[nodiscard]] std::vector<uint32_t> getPorts(const std::string &portName) const
+    {
+        return (portName == IN) ? inPorts : outPorts;
+    }
+
+
+    /**
+     * Method used to get the positions of the locations having a given port name, sorted so that they can be searched.
+     * @param portName the name of the port (either 'in' or 'out').
+     * @return the positions of the locations named 'portName', in increasing order.
+     */
+    [[nodiscard]] std::vector<uint32_t> getSortedPorts(const std::string &portName) const
+    {
+        std::vector<uint32_t> ports { getPorts(portName) };
+        std::sort(ports.begin(), ports.end());
+        return ports;
+    }
+
+
+    /**
+     * Method used to shift some positions by the offset returned by append, so that they refer to the merged graph.
+     * @param positions the positions to shift.
+     * @param offset the offset to add.
+     */
+    static void shiftPositions(std::vector<uint32_t> &positions, uint32_t offset)
+    {
+        for (uint32_t &position: positions)
+            position += offset;
+    }
+
+
+    /**
+     * Method used to append another graph to this one, as when merging the locations and transitions of two tiles.
+     * In the resulting graph, the records of this graph come before the ones of the other graph, and the declarations
+     * and the initial location are the ones of this graph.
+     * The records of the smaller graph are moved after the ones of the bigger graph, which are left untouched: hence,
+     * the positions of either this or the other graph are shifted in the result, as told by the returned offsets.
+     * @param other the graph to append, which is consumed.
+     * @return the offsets to add to the positions of this graph and of the other graph, respectively, to get their positions in the result.
+     */
+    std::pair<uint32_t, uint32_t> append(TAGraph &&other)
+    {
+        if (other.getMergeCost() <= getMergeCost())
+        {
+            auto offsets = appendRecords(other);
+            for (const auto &range: other.locationOrder)
+                pushBackRange(locationOrder, range.first + offsets.first, range.second + offsets.first);
+            for (const auto &range: other.edgeOrder)
+                pushBackRange(edgeOrder, range.first + offsets.second, range.second + offsets.second);
+            appendPorts(inPorts, other.inPorts, offsets.first, false);
+            appendPorts(outPorts, other.outPorts, offsets.first, false);
+
+            other = TAGraph();
+            return { 0, offsets.first };
+        }
+
+        // This graph is the smaller one: its records are moved after the ones of the other graph, and its ranges and
+        // ports are put before the ones of the other graph, as they are emitted first.
+        std::swap(*this, other);
+        auto offsets = appendRecords(other);
+        for (auto range = other.locationOrder.rbegin(); range != other.locationOrder.rend(); ++range)
+            pushFrontRange(locationOrder, range->first + offsets.first, range->second + offsets.first);
+        for (auto range = other.edgeOrder.rbegin(); range != other.edgeOrder.rend(); ++range)
+            pushFrontRange(edgeOrder, range->first + offsets.second, range->second + offsets.second);
+        appendPorts(inPorts, other.inPorts, offsets.first, true);
+        appendPorts(outPorts, other.outPorts, offsets.first, true);
+
+        header = std::move(other.header);
+        initial = (other.initial != STRING_POOL_NONE) ? other.initial + offsets.first : STRING_POOL_NONE;
+
+        other = TAGraph();
+        return { offsets.first, 0 };
+    }
+
+
+    /**
+     * Method used to add a new transition to the graph.
+     * @param id the id of the transition.
+     * @param source the position of the source location.
+     * @param target the position of the target location.
+     * @param text the text of the transition's label, no label is added if it is empty.
+     * @param kind the kind of the transition's label.
+     */
+    void addEdge(const std::string &id, uint32_t source, uint32_t target, const std::string &text, const std::string &kind)
+    {
+        // Transitions added by connectors do not belong to any tile instance.
+        if (!edgeInstances.empty() && edgeInstances.back().second != STRING_POOL_NONE)
+            edgeInstances.emplace_back(edgeCount, STRING_POOL_NONE);
+
+        pushBackRange(edgeOrder, edgeCount, edgeCount + 1);
+
+        // The endpoints are stored as they are, since the offset of the overlay segment is 0.
+        GraphRecords &overlay = getOverlay();
+        GraphEdge edge { strings.intern(id), source, target, static_cast<uint32_t>(overlay.labels.size()), 0, nullptr };
+        if (!text.empty())
+        {
+            uint32_t kindIndex = strings.intern(kind);
+            uint32_t textIndex = strings.intern(text);
+            overlay.labels.push_back({ kindIndex, textIndex, parseLabel(kindIndex, textIndex) });
+            edge.labelCount = 1;
+            labelCount++;
+        }
+        overlay.edges.push_back(edge);
+        edgeCount++;
+    }
+
+
+    /**
+     * Method used to delete the name of some locations, provided that it is the given port name.
+     * Such locations will not be considered as ports anymore. The locations themselves are left untouched: their
+     * name is omitted only when the TA is converted back to json.
+     * @param positions the positions of the locations.
+     * @param portName the name the locations must have in order for it to be deleted.
+     */
+    void deletePortNames(const std::vector<uint32_t> &positions, const std::string &portName)
+    {
+        std::vector<uint32_t> &ports = getPortsRef(portName);
+
+        // The remaining ports keep their emission order.
+        std::vector<uint32_t> sortedPositions { positions };
+        std::sort(sortedPositions.begin(), sortedPositions.end());
+        ports.erase(std::remove_if(ports.begin(), ports.end(), [&](uint32_t port) {
+            return std::binary_search(sortedPositions.begin(), sortedPositions.end(), port);
+        }), ports.end());
+    }
+
+};
+
+
+// Defining static attributes.
+StringPool TAGraph::strings {};
+
+bool TAGraph::lazyComposition { false };
+
+std::unordered_map<uint64_t, LabelExpression> TAGraph::labelExpressions {};
+
+std::mutex TAGraph::labelExpressionsMutex {};
+
+
+#endif //UTOTPARSER_TAGRAPH_H
@@ -0,0 +1,405 @@
+#ifndef UTOTPARSER_TALABELPARSER_H
+#define UTOTPARSER_TALABELPARSER_H
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "defines/UPPAALxmlAttributes.h"
+
+// Grammar of the labels that are parsed into an AST:
+// -------------------------------------------------
+// Guard, Invariant -> Constraint ('&&' Constraint)*
+// Constraint -> Term (RelOp Term)+                   (chained comparisons such as 2 < x <= param are split)
+// Assignment -> Reset ((',' | ';') Reset)*
+// Reset -> Identifier ('=' | ':=') Term
+// Term -> Factor (('+' | '-') Factor)*
+// Factor -> Atom ('*' Atom)*
+// Atom -> Integer | Identifier | '-' Atom | '(' Term ')'
+// RelOp -> '==' | '!=' | '<' | '<=' | '>' | '>='
+// Labels that do not follow the grammar are still tokenized, so that their identifiers and constants are known.
+
+
+/**
+ * Struct representing an arithmetic term as a sum of identifiers (clocks or parameters) multiplied by a coefficient, plus a constant.
+ */
+typedef struct lt {
+    std::vector<std::pair<long long, std::string>> variables {};
+    long long constant {};
+} LabelTerm;
+
+
+/**
+ * Struct representing an atomic constraint of a guard or of an invariant, i.e., lhs op rhs.
+ */
+typedef struct cc {
+    LabelTerm lhs;
+    std::string op;
+    LabelTerm rhs;
+} ClockConstraint;
+
+
+/**
+ * Struct representing a single assignment, i.e., clock = value.
+ */
+typedef struct cr {
+    std::string clock;
+    LabelTerm value;
+} ClockReset;
+
+
+/**
+ * Struct representing a parsed label, together with the information every consumer needs, computed once.
+ */
+typedef struct le {
+    // True if the label follows the grammar, in which case 'constraints' or 'resets' describe it completely.
+    bool isParsed {};
+    // The atomic constraints of a guard or invariant label.
+    std::vector<ClockConstraint> constraints {};
+    // The assignments of an assignment label.
+    std::vector<ClockReset> resets {};
+    // All the identifiers (clocks and parameters) appearing in the label, sorted and without duplicates.
+    std::vector<std::string> identifiers {};
+    // The maximum integer constant appearing in the label (0 if there are none).
+    // Constants are taken without their sign (e.g., 'x - y < -5' gives 5), since C must bound their absolute value.
+    int maxConstant {};
+    // The text of the label with html characters escaped, as written in .dot files.
+    std::string htmlText {};
+    // The text of the label in tChecker syntax, where assignments are separated by ';' instead of ','.
+    std::string tCheckerText {};
+
+
+    /**
+     * Method used to tell if an identifier appears in the label.
+     * @param identifier the identifier to look for.
+     * @return true if the identifier appears in the label as a whole word, false otherwise.
+     */
+    [[nodiscard]] bool references(const std::string &identifier) const
+    {
+        return std::binary_search(identifiers.begin(), identifiers.end(), identifier);
+    }
+
+
+    /**
+     * Method used to tell if a clock is reset by the label.
+     * If the label could not be parsed, every identifier appearing in it is considered as reset.
+     * @param clock the clock to look for.
+     * @return true if the label assigns the clock, false otherwise.
+     */
+    [[nodiscard]] bool isReset(const std::string &clock) const
+    {
+        if (!isParsed)
+            return references(clock);
+        return std::any_of(resets.begin(), resets.end(), [&clock](const ClockReset &reset) { return reset.clock == clock; });
+    }
+} LabelExpression;
+
+
+class TALabelParser {
+
+private:
+    enum TokenKind {
+        integerToken,
+        identifierToken,
+        symbolToken,
+        endToken
+    };
+
+    struct Token {
+        TokenKind kind;
+        std::string_view text;
+        long long value;
+    };
+
+    std::vector<Token> tokens {};
+
+    size_t pos {};
+
+    bool failed {};
+
+
+    /**
+     * Method used to split the label text in tokens with a single scan.
+     * Integers are converted while scanning, hence no exception is ever involved.
+     * @param text the text of the label.
+     * @param expression the expression in which to store the identifiers and the maximum constant.
+     */
+    void tokenize(std::string_view text, LabelExpression &expression)
+    {
+        // Symbols made of two characters are listed first, so that they are preferred over their prefixes.
+        static const std::vector<std::string_view> symbols { "==", "!=", "<=", ">=", "&&", "||", ":=",
+                                                             "<", ">", "=", "+", "-", "*", "/", "(", ")", ",", ";", "!" };
+        size_t i = 0;
+        while (i < text.size())
+        {
+            char c = text[i];
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                i++;
+            } else if (std::isdigit(static_cast<unsigned char>(c)))
+            {
+                size_t start = i;
+                long long value = 0;
+                while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i])))
+                {
+                    value = (value > (LLONG_MAX - 9) / 10) ? LLONG_MAX : value * 10 + (text[i] - '0');
+                    i++;
+                }
+                tokens.push_back({ integerToken, text.substr(start, i - start), value });
+                if (value > expression.maxConstant)
+                    expression.maxConstant = (value > INT_MAX) ? INT_MAX : static_cast<int>(value);
+            } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+            {
+                size_t start = i;
+                while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_'))
+                    i++;
+                std::string_view word = text.substr(start, i - start);
+                // UPPAAL also accepts 'and' as a synonym of '&&'.
+                if (word == "and")
+                    tokens.push_back({ symbolToken, "&&", 0 });
+                else
+                {
+                    tokens.push_back({ identifierToken, word, 0 });
+                    expression.identifiers.emplace_back(word);
+                }
+            } else
+            {
+                auto symbol = std::find_if(symbols.begin(), symbols.end(), [&](std::string_view s) {
+                    return text.compare(i, s.size(), s) == 0;
+                });
+                if (symbol == symbols.end())
+                {
+                    // Unknown characters make the label unparsable, but the scan goes on to collect identifiers and constants.
+                    failed = true;
+                    i++;
+                } else
+                {
+                    tokens.push_back({ symbolToken, *symbol, 0 });
+                    i += symbol->size();
+                }
+            }
+        }
+        tokens.push_back({ endToken, "", 0 });
+
+        std::sort(expression.identifiers.begin(), expression.identifiers.end());
+        expression.identifiers.erase(std::unique(expression.identifiers.begin(), expression.identifiers.end()), expression.identifiers.end());
+    }
+
+
+    [[nodiscard]] const Token &peek() const
+    {
+        return tokens[pos];
+    }
+
+
+    bool accept(std::string_view symbol)
+    {
+        if (peek().kind == symbolToken && peek().text == symbol)
+        {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+
+    static bool isRelOp(const Token &token)
+    {
+        return token.kind == symbolToken
+               && (token.text == "==" || token.text == "!=" || token.text == "<" || token.text == "<=" || token.text == ">" || token.text == ">=");
+    }
+
+
+    /**
+     * Method used to multiply two terms, which is possible only if at least one of them is a constant.
+     */
+    LabelTerm multiply(const LabelTerm &a, const LabelTerm &b)
+    {
+        if (!a.variables.empty() && !b.variables.empty())
+        {
+            failed = true;
+            return a;
+        }
+        const LabelTerm &constantTerm = a.variables.empty() ? a : b;
+        LabelTerm result = a.variables.empty() ? b : a;
+        for (auto &variable: result.variables)
+            variable.first *= constantTerm.constant;
+        result.constant *= constantTerm.constant;
+        return result;
+    }
+
+
+    static void addTo(LabelTerm &result, const LabelTerm &term, long long sign)
+    {
+        for (const auto &variable: term.variables)
+            result.variables.emplace_back(sign * variable.first, variable.second);
+        result.constant += sign * term.constant;
+    }
+
+
+    LabelTerm parseAtom()
+    {
+        const Token &token = peek();
+        if (token.kind == integerToken)
+        {
+            pos++;
+            return { {}, token.value };
+        }
+        if (token.kind == identifierToken)
+        {
+            pos++;
+            return { {{ 1, std::string(token.text) }}, 0 };
+        }
+        if (accept("-"))
+        {
+            LabelTerm result {};
+            addTo(result, parseAtom(), -1);
+            return result;
+        }
+        if (accept("("))
+        {
+            LabelTerm result = parseTerm();
+            if (!accept(")"))
+                failed = true;
+            return result;
+        }
+        failed = true;
+        return {};
+    }
+
+
+    LabelTerm parseFactor()
+    {
+        LabelTerm result = parseAtom();
+        while (!failed && accept("*"))
+            result = multiply(result, parseAtom());
+        return result;
+    }
+
+
+    LabelTerm parseTerm()
+    {
+        LabelTerm result = parseFactor();
+        while (!failed)
+        {
+            if (accept("+"))
+                addTo(result, parseFactor(), 1);
+            else if (accept("-"))
+                addTo(result, parseFactor(), -1);
+            else
+                break;
+        }
+        return result;
+    }
+
+
+    void parseConstraints(LabelExpression &expression)
+    {
+        do
+        {
+            LabelTerm lhs = parseTerm();
+            if (!isRelOp(peek()))
+            {
+                failed = true;
+                return;
+            }
+            while (!failed && isRelOp(peek()))
+            {
+                std::string op(peek().text);
+                pos++;
+                LabelTerm rhs = parseTerm();
+                expression.constraints.push_back({ lhs, op, rhs });
+                lhs = rhs;
+            }
+        } while (!failed && accept("&&"));
+    }
+
+
+    void parseResets(LabelExpression &expression)
+    {
+        do
+        {
+            if (peek().kind != identifierToken)
+            {
+                failed = true;
+                return;
+            }
+            std::string clock(peek().text);
+            pos++;
+            if (!accept("=") && !accept(":="))
+            {
+                failed = true;
+                return;
+            }
+            expression.resets.push_back({ clock, parseTerm() });
+        } while (!failed && (accept(",") || accept(";")));
+    }
+
+
+    /**
+     * Method used to escape the characters having a special meaning in html.
+     * @param text the text to escape.
+     * @return the escaped text.
+     */
+    static std::string htmlEscape(std::string_view text)
+    {
+        std::string result {};
+        result.reserve(text.size() + 8);
+        for (char c: text)
+        {
+            switch (c)
+            {
+                case '&':
+                    result.append("&amp;");
+                    break;
+                case '<':
+                    result.append("&lt;");
+                    break;
+                case '>':
+                    result.append("&gt;");
+                    break;
+                default:
+                    result.push_back(c);
+            }
+        }
+        return result;
+    }
+
+
+public:
+    /**
+     * Method used to parse a label.
+     * Labels are parsed once, when the records of TAGraph are built (see TAGraph::parseLabel), hence no cache is kept here.
+     * @param kind the kind of the label (guard, invariant, assignment, ...).
+     * @param text the text of the label.
+     * @return the parsed representation of the label.
+     */
+    static LabelExpression parse(const std::string &kind, const std::string &text)
+    {
+        TALabelParser parser;
+        LabelExpression expression {};
+
+        parser.tokenize(text, expression);
+
+        if (kind == GUARD || kind == INVARIANT)
+            parser.parseConstraints(expression);
+        else if (kind == ASSIGNMENT)
+            parser.parseResets(expression);
+        else
+            parser.failed = true;
+
+        expression.isParsed = !parser.failed && parser.peek().kind == endToken;
+        expression.htmlText = htmlEscape(text);
+        expression.tCheckerText = text;
+        if (kind == ASSIGNMENT)
+            std::replace(expression.tCheckerText.begin(), expression.tCheckerText.end(), ',', ';');
+        return expression;
+    }
+
+};
+
+
+#endif //UTOTPARSER_TALABELPARSER_H
@@ -0,0 +1,598 @@
+#ifndef UTOTPARSER_TARESULTSSTORE_H
+#define UTOTPARSER_TARESULTSSTORE_H
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include "nlohmann/json.hpp"
+
+#include "utilities/Utils.hpp"
+#include "TAHeaders/TABoundsCalculator.hpp"
+
+using json = nlohmann::json;
+
+
+// The name of the file, inside the testing results directory, in which the results of the tests are stored.
+const std::string RESULTS_STORE_FILE_NAME { "Results.jsonl" };
+
+
+// Store of the results of the tests generated by the tester.
+// ----------------------------------------------------------
+// The store is a JSON Lines file to which a record is appended as soon as a test is complete, hence it can be read while
+// the tests are still running. Each record has the following fields:
+// - "name": the name of the TA.
+// - "regex": the regular expression the TA has been generated from.
+// - "usedTiles": the tiles used by the TA (random and accepting tiles excluded).
+// - "verdict": "empty" or "not empty" if the TA has been checked, "unchecked" otherwise.
+// - "acceptingParameters": the values of the parameter for which an acceptance condition has been found, in the order
+//                          in which they have been found.
+// - "totalLocations", "totalTransitions": the size of the checked TA, null if it has not been measured.
+// - "runs": one entry for each run of tChecker, with the keys below (a key is null if tChecker has not reported it).
+// - "bounds": the bounds found for the parameter, with "l" and "r" null when they are not numbers.
+// - "canonicalHash": the hash of the canonical form of the TA (see TACanonicalHasher).
+// - "duplicateOf": the name of the TA with the same canonical hash whose verdict has been copied instead of running the
+//                  checker (its accepting parameters and size are copied as well, and "runs" is empty), null otherwise.
+// The text reports (Results.txt, ResourceUsages.txt and ParametersBounds.txt) are rendered from the store.
+
+class TAResultsStore {
+
+private:
+    // The path of the store.
+    std::string storePath {};
+
+    // Guards the appends to the store, which may come from different threads.
+    std::mutex mutex {};
+
+    // The records of the checked TAs (duplicates excluded), given their canonical hash.
+    std::unordered_map<std::string, json> checkedRecords {};
+
+    // The keys reported by tChecker for each run, with the names they have inside the records.
+    static const std::vector<std::pair<std::string, std::string>> runKeys;
+
+
+    /**
+     * Method used to get the last word of a line, as done by awk '{print $NF}'.
+     * @param line the line from which to get the last word.
+     * @return the last word of the line, an empty string if the line is blank.
+     */
+    static std::string getLastWord(const std::string &line)
+    {
+        size_t end = line.find_last_not_of(" \t\r");
+        if (end == std::string::npos)
+            return "";
+        size_t begin = line.find_last_of(" \t", end);
+        return line.substr(begin == std::string::npos ? 0 : begin + 1, end - (begin == std::string::npos ? 0 : begin + 1) + 1);
+    }
+
+
+    /**
+     * Method used to get a number out of a word, accepting a comma as decimal separator.
+     * @param word the word to convert.
+     * @return the number, or a json null if the word is not a number.
+     */
+    static json getNumber(std::string word)
+    {
+        std::replace(word.begin(), word.end(), ',', '.');
+        try
+        {
+            return std::stod(word);
+        } catch (std::exception &e)
+        {
+            return nullptr;
+        }
+    }
+
+
+    /**
+     * Method used to collect the values of the parameter for which the checking scripts found an acceptance condition.
+     * Each value follows the '[[ ACC ]]' marker by two lines, and it is already scaled back to the original TA.
+     * @param logPath the path of the log of the TA.
+     * @return the values of the parameter, in the order in which they have been found.
+     */
+    static json getAcceptingParameters(const std::string &logPath)
+    {
+        json parameters = json::array();
+
+        std::ifstream log(logPath);
+        std::string line {};
+        int linesToValue { -1 };
+        while (std::getline(log, line))
+        {
+            if (line.find("[[ ACC ]]") != std::string::npos)
+                linesToValue = 2;
+            else if (linesToValue > 0 && --linesToValue == 0)
+            {
+                json value = getNumber(getLastWord(line));
+                if (!value.is_null())
+                    parameters.push_back(value);
+            }
+        }
+        return parameters;
+    }
+
+
+    /**
+     * Method used to fill a record with the resource usage written by the checking scripts, in a single pass over it.
+     * Each run of tChecker ends with the 'EXECUTION_TIME' line written by the script calling it.
+     * @param resourceUsagePath the path of the resource usage file of the TA.
+     * @param record the record to fill.
+     */
+    static void addResourceUsage(const std::string &resourceUsagePath, json &record)
+    {
+        record["totalLocations"] = nullptr;
+        record["totalTransitions"] = nullptr;
+        record["runs"] = json::array();
+
+        std::ifstream resourceUsage(resourceUsagePath);
+        if (!resourceUsage.is_open())
+            return;
+
+        json run = json::object();
+        std::string line {};
+        while (std::getline(resourceUsage, line))
+        {
+            std::string key { line.substr(0, line.find(' ')) };
+            if (key.empty())
+                continue;
+
+            if (key == "TOTAL_LOCATIONS")
+                record["totalLocations"] = getNumber(getLastWord(line));
+            else if (key == "TOTAL_TRANSITIONS")
+                record["totalTransitions"] = getNumber(getLastWord(line));
+            else if (key == "CYCLE")
+                run["cycle"] = (getLastWord(line) == "true");
+            else
+            {
+                auto runKey = std::find_if(runKeys.begin(), runKeys.end(), [&key](const auto &k) { return k.first == key; });
+                if (runKey != runKeys.end())
+                    run[runKey->second] = getNumber(getLastWord(line));
+
+                if (key == "EXECUTION_TIME")
+                {
+                    for (const auto &k: runKeys)
+                        if (!run.contains(k.second))
+                            run[k.second] = nullptr;
+                    record["runs"].push_back(std::move(run));
+                    run = json::object();
+                }
+            }
+        }
+    }
+
+
+    /**
+     * Method used to get the json representation of the given bounds, where values that are not numbers become nulls.
+     * @param bounds the bounds to represent.
+     * @return a json array containing the bounds.
+     */
+    static json boundsToJson(const std::vector<Bound> &bounds)
+    {
+        auto number = [](double value) { return std::isnan(value) ? json(nullptr) : json(value); };
+
+        json result = json::array();
+        for (const Bound &b: bounds)
+            result.push_back({{ "l",          number(b.l) },
+                              { "r",          number(b.r) },
+                              { "isNan",      b.isNan },
+                              { "isDisjoint", b.isDisjoint }});
+        return result;
+    }
+
+
+    /**
+     * Method used to get the bounds stored inside a record.
+     * @param record the record containing the bounds.
+     * @return the bounds of the record.
+     */
+    static std::vector<Bound> boundsFromJson(const json &record)
+    {
+        auto number = [](const json &value) { return value.is_null() ? std::numeric_limits<double>::quiet_NaN() : value.get<double>(); };
+
+        std::vector<Bound> bounds {};
+        for (const json &b: record.at("bounds"))
+            bounds.push_back({ b.at("isNan").get<bool>(), b.at("isDisjoint").get<bool>(), number(b.at("l")), number(b.at("r")) });
+        return bounds;
+    }
+
+
+    /**
+     * Method used to get the mean and the peak of a value over the runs of a record.
+     * As done so far, the mean is taken over the number of runs reporting a cycle, and it is 0 if no run reports one
+     * (e.g., when tChecker failed on every run), instead of dividing by 0.
+     * @param record the record containing the runs.
+     * @param key the name of the value inside the runs.
+     * @return a pair containing the mean and the peak of the value.
+     */
+    static std::pair<double, double> getMeanAndPeak(const json &record, const std::string &key)
+    {
+        double total { 0 };
+        double peak { 0 };
+        int totalRuns { 0 };
+
+        for (const json &run: record.at("runs"))
+        {
+            if (run.contains("cycle"))
+                totalRuns++;
+            if (run.at(key).is_null())
+                continue;
+            double value { run.at(key).get<double>() };
+            total += value;
+            peak = std::max(peak, value);
+        }
+        if (totalRuns == 0)
+            return { 0, peak };
+        return { total / totalRuns, peak };
+    }
+
+
+    /**
+     * Method used to compare the names of two TAs by the number of the test at their end, so that RegExTA_2 comes before
+     * RegExTA_10 (names with a different prefix are compared by prefix first).
+     * @param name1 the name of the first TA.
+     * @param name2 the name of the second TA.
+     * @return true if the first TA comes before the second one, false otherwise.
+     */
+    static bool isNameBefore(const std::string &name1, const std::string &name2)
+    {
+        size_t digits1 { name1.size() - (name1.find_last_not_of("0123456789") + 1) };
+        size_t digits2 { name2.size() - (name2.find_last_not_of("0123456789") + 1) };
+
+        // Numbers are compared as strings, first by length, hence they can be arbitrarily long.
+        std::string_view prefix1 { name1.data(), name1.size() - digits1 };
+        std::string_view prefix2 { name2.data(), name2.size() - digits2 };
+        std::string_view number1 { name1.data() + prefix1.size(), digits1 };
+        std::string_view number2 { name2.data() + prefix2.size(), digits2 };
+
+        return std::make_tuple(prefix1, digits1, number1) < std::make_tuple(prefix2, digits2, number2);
+    }
+
+
+    /**
+     * Method used to write the entry of a checked TA in the results report.
+     * @param out the stream of the report.
+     * @param record the record of the TA.
+     */
+    static void renderResult(std::ofstream &out, const json &record)
+    {
+        out << record.at("name").get<std::string>() << ".txt\n";
+
+        if (record.at("verdict") == "not empty")
+        {
+            // The last value found is the one reported, as the values are tried in increasing order.
+            out << "Language is not empty with parameter value: ";
+            if (!record.at("acceptingParameters").empty())
+                out << record.at("acceptingParameters").back().get<double>();
+            out << '\n';
+        } else
+            out << "Language is empty\n";
+
+        out << "Tiles used: ";
+        for (const json &tile: record.at("usedTiles"))
+            out << tile.get<std::string>() << ' ';
+        out << "\n\n\n";
+    }
+
+
+    /**
+     * Method used to write the resource usage of a checked TA in the resource usage report.
+     * @param out the stream of the report.
+     * @param record the record of the TA.
+     */
+    static void renderResourceUsage(std::ofstream &out, const json &record)
+    {
+        std::string nameTA { record.at("name").get<std::string>() };
+        auto count = [&record](const std::string &key) { return record.at(key).is_null() ? 0 : record.at(key).get<int>(); };
+
+        int totalRuns { 0 };
+        for (const json &run: record.at("runs"))
+            totalRuns += run.contains("cycle") ? 1 : 0;
+
+        auto [meanRunningTime, peakRunningTime] = getMeanAndPeak(record, "runningTimeSeconds");
+        auto [meanMemoryMaxRSS, peakMemoryMaxRSS] = getMeanAndPeak(record, "memoryMaxRss");
+        auto [meanExecutionTime, peakExecutionTime] = getMeanAndPeak(record, "executionTime");
+
+        out << nameTA << '\n';
+        out << std::string(nameTA.length(), '-') << '\n';
+        out << "Total number of locations:                     " << count("totalLocations") << '\n';
+        out << "Total number of transitions:                   " << count("totalTransitions") << '\n';
+        out << "Total number of runs:                          " << totalRuns << '\n';
+        out << "Mean algorithm running time [milliseconds]:    " << meanRunningTime * 1000 << '\n';
+        out << "Peak algorithm running time [milliseconds]:    " << peakRunningTime * 1000 << '\n';
+        out << "Mean tChecker running time [milliseconds]:     " << meanExecutionTime << '\n';
+        out << "Peak tChecker running time [milliseconds]:     " << peakExecutionTime << '\n';
+        out << "Mean maximum memory utilization [Bytes]:       " << meanMemoryMaxRSS << '\n';
+        out << "Peak maximum memory utilization [Bytes]:       " << peakMemoryMaxRSS << '\n';
+        out << "Mean number of stored zone graph states:       " << getMeanAndPeak(record, "storedStates").first << '\n';
+        out << "Mean number of visited zone graph states:      " << getMeanAndPeak(record, "visitedStates").first << '\n';
+        out << "Mean number of visited zone graph transitions: " << getMeanAndPeak(record, "visitedTransitions").first << '\n';
+        out << "\n\n";
+    }
+
+
+    /**
+     * Method used to write the bounds of a TA in the parameter bounds report, together with the strictest one containing
+     * the value of the parameter found by tChecker.
+     * @param out the stream of the report.
+     * @param record the record of the TA.
+     * @param printAllBounds true if all the bounds found have to be written.
+     */
+    static void renderParameterBounds(std::ofstream &out, const json &record, bool printAllBounds)
+    {
+        std::string nameTA { record.at("name").get<std::string>() };
+        out << nameTA << '\n' << std::string(nameTA.length(), '-') << '\n';
+
+        if (record.at("acceptingParameters").empty())
+        {
+            out << "The language of the given TA is empty and thus no parameter has been found.\n\n\n";
+            return;
+        }
+
+        double parameterValue { record.at("acceptingParameters").back().get<double>() };
+        std::vector<Bound> bounds { boundsFromJson(record) };
+
+        if (printAllBounds)
+        {
+            out << "The following bounds have been found:\n" << TABoundsCalculator::getBoundsAsString(bounds);
+            out << "The parameter value is: " << std::fixed << std::setprecision(1) << parameterValue << '\n';
+        }
+
+        double strictestBoundSize { std::numeric_limits<double>::max() };
+        Bound resultBound {};
+
+        bool isInBound {};
+
+        // Getting the strictest bound as a result.
+        for (const Bound &b: bounds)
+            if (!(b.isDisjoint || b.isNan) && b.l <= parameterValue && parameterValue <= b.r)
+            {
+                isInBound = true;
+                double boundSize { TABoundsCalculator::computeBoundSize(b) };
+                if (boundSize <= strictestBoundSize)
+                {
+                    resultBound = b;
+                    strictestBoundSize = boundSize;
+                }
+            }
+
+        out << "Parameter value: " << std::fixed << std::setprecision(1) << parameterValue
+            << " is within found bound: " << TABoundsCalculator::getBoundAsString(resultBound)
+            << (isInBound ? "true" : "false") << "\n\n";
+    }
+
+
+    /**
+     * Method used to remember the record of a checked TA, so that the TAs with the same canonical hash are not checked again.
+     * Records of unchecked TAs and of duplicates (or without a canonical hash) are ignored, as well as a hash already known.
+     * The caller must hold the lock of the store.
+     * @param record the record to remember.
+     */
+    void indexCheckedRecord(const json &record)
+    {
+        if (record.at("verdict") == "unchecked" || !record.contains("canonicalHash") || !record.at("canonicalHash").is_string() ||
+            !record.value("duplicateOf", json(nullptr)).is_null())
+            return;
+
+        checkedRecords.emplace(record.at("canonicalHash").get<std::string>(), record);
+    }
+
+
+public:
+    /**
+     * Default parametric constructor.
+     * @param testingResultsDirPath the path of the directory containing the store and the reports.
+     */
+    explicit TAResultsStore(const std::string &testingResultsDirPath) : storePath(testingResultsDirPath + "/" + RESULTS_STORE_FILE_NAME)
+    {}
+
+
+    /**
+     * Method used to build the record of a test, gathering the outcome of its check from the files written by the checker.
+     * @param nameTA the name of the TA.
+     * @param regEx the regular expression the TA has been generated from.
+     * @param usedTiles the tiles used by the TA (random and accepting tiles excluded).
+     * @param bounds the bounds found for the parameter.
+     * @param canonicalHash the hash of the canonical form of the TA.
+     * @param isChecked true if the emptiness of the TA has been checked.
+     * @param isAccepting true if the language of the TA is not empty (meaningful only if the TA has been checked).
+     * @param logDirPath the path of the directory containing the logs of the checker.
+     * @param resourceUsageDirPath the path of the directory containing the resource usage of the checker.
+     * @return the record of the test.
+     */
+    static json buildRecord(const std::string &nameTA, const std::string &regEx, const std::vector<std::string> &usedTiles,
+                            const std::vector<Bound> &bounds, const std::string &canonicalHash, bool isChecked, bool isAccepting,
+                            const std::string &logDirPath, const std::string &resourceUsageDirPath)
+    {
+        json record = json::object();
+        record["name"] = nameTA;
+        record["regex"] = regEx;
+        record["usedTiles"] = usedTiles;
+        record["verdict"] = isChecked ? (isAccepting ? "not empty" : "empty") : "unchecked";
+        record["acceptingParameters"] = getAcceptingParameters(logDirPath + "/" + nameTA + ".txt");
+        addResourceUsage(resourceUsageDirPath + "/" + nameTA + ".txt", record);
+        record["bounds"] = boundsToJson(bounds);
+        record["canonicalHash"] = canonicalHash;
+        record["duplicateOf"] = nullptr;
+        return record;
+    }
+
+
+    /**
+     * Method used to build the record of a test whose TA is a duplicate of an already checked one, copying its verdict.
+     * @param nameTA the name of the TA.
+     * @param regEx the regular expression the TA has been generated from.
+     * @param usedTiles the tiles used by the TA (random and accepting tiles excluded).
+     * @param bounds the bounds found for the parameter.
+     * @param original the record of the checked TA with the same canonical hash.
+     * @return the record of the test.
+     */
+    static json buildDuplicateRecord(const std::string &nameTA, const std::string &regEx, const std::vector<std::string> &usedTiles,
+                                     const std::vector<Bound> &bounds, const json &original)
+    {
+        json record = json::object();
+        record["name"] = nameTA;
+        record["regex"] = regEx;
+        record["usedTiles"] = usedTiles;
+        record["verdict"] = original.at("verdict");
+        record["acceptingParameters"] = original.at("acceptingParameters");
+        record["totalLocations"] = original.at("totalLocations");
+        record["totalTransitions"] = original.at("totalTransitions");
+        record["runs"] = json::array();
+        record["bounds"] = boundsToJson(bounds);
+        record["canonicalHash"] = original.at("canonicalHash");
+        record["duplicateOf"] = original.at("name");
+        return record;
+    }
+
+
+    /**
+     * Method used to append a record to the store, flushing it so that it survives a crash of the tester.
+     * @param record the record to append.
+     */
+    void append(const json &record)
+    {
+        std::string line { record.dump() + '\n' };
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ofstream out(storePath, std::ofstream::out | std::ofstream::app);
+        out << line;
+        out.flush();
+
+        indexCheckedRecord(record);
+    }
+
+
+    /**
+     * Method used to get the record of a checked TA given its canonical hash, among the ones appended to the store or
+     * loaded by getStoredNames.
+     * @param canonicalHash the canonical hash of the TA.
+     * @return the record of the first checked TA with the given canonical hash, if any.
+     */
+    std::optional<json> findCheckedRecord(const std::string &canonicalHash)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto record = checkedRecords.find(canonicalHash);
+        if (record == checkedRecords.end())
+            return std::nullopt;
+        return record->second;
+    }
+
+
+    /**
+     * Method used to read all the records of the store.
+     * A truncated last line (e.g., if the tester has been killed while appending it) is ignored.
+     * @return the records of the store, in the order in which they have been appended.
+     */
+    std::vector<json> load()
+    {
+        std::vector<json> records {};
+
+        std::ifstream in(storePath);
+        std::string line {};
+        while (std::getline(in, line))
+        {
+            json record = json::parse(line, nullptr, false);
+            if (!record.is_discarded())
+                records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+
+    /**
+     * Method used to drop a truncated last line from the store (e.g., if the tester has been killed while appending it),
+     * so that the records appended afterwards start on a line of their own.
+     */
+    void recover()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::error_code errorCode {};
+        auto size = std::filesystem::file_size(storePath, errorCode);
+        if (errorCode || size == 0)
+            return;
+
+        std::ifstream in(storePath, std::ifstream::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+
+        if (content.back() != '\n')
+        {
+            size_t lastNewline = content.find_last_of('\n');
+            std::filesystem::resize_file(storePath, (lastNewline == std::string::npos) ? 0 : lastNewline + 1);
+        }
+    }
+
+
+    /**
+     * Method used to get the names of the TAs which have a record in the store, i.e., of the completed tests.
+     * The checked TAs among them are remembered as well, so that their duplicates are not checked again.
+     * @return the names of the TAs in the store.
+     */
+    std::set<std::string> getStoredNames()
+    {
+        std::set<std::string> names {};
+        std::vector<json> records = load();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const json &record: records)
+        {
+            names.insert(record.at("name").get<std::string>());
+            indexCheckedRecord(record);
+        }
+        return names;
+    }
+
+
+    /**
+     * Method used to render the text reports from the store in a single pass over its records, sorted by test number:
+     * - Results.txt: the outcome of the check of each checked TA.
+     * - ResourceUsages.txt: the resources used by tChecker for each TA it has been run on.
+     * - ParametersBounds.txt: the bounds found for the parameter of each TA, compared with the value found by tChecker.
+     * @param testingResultsDirPath the path of the directory in which to write the reports.
+     * @param printAllBounds true if all the bounds found have to be written, not only the strictest one.
+     */
+    void renderReports(const std::string &testingResultsDirPath, bool printAllBounds)
+    {
+        std::vector<json> records = load();
+        std::sort(records.begin(), records.end(), [](const json &r1, const json &r2) {
+            return isNameBefore(r1.at("name").get<std::string>(), r2.at("name").get<std::string>());
+        });
+
+        std::ofstream results(testingResultsDirPath + "/Results.txt", std::ofstream::out | std::ofstream::trunc);
+        std::ofstream resourceUsages(testingResultsDirPath + "/ResourceUsages.txt", std::ofstream::out | std::ofstream::trunc);
+        std::ofstream parametersBounds(testingResultsDirPath + "/ParametersBounds.txt", std::ofstream::out | std::ofstream::trunc);
+
+        for (const json &record: records)
+        {
+            if (record.at("verdict") != "unchecked")
+                renderResult(results, record);
+            if (!record.at("runs").empty())
+                renderResourceUsage(resourceUsages, record);
+            renderParameterBounds(parametersBounds, record, printAllBounds);
+        }
+    }
+
+};
+
+
+// Defining static attributes.
+const std::vector<std::pair<std::string, std::string>> TAResultsStore::runKeys {
+        { "RUNNING_TIME_SECONDS", "runningTimeSeconds" },
+        { "MEMORY_MAX_RSS",       "memoryMaxRss" },
+        { "STORED_STATES",        "storedStates" },
+        { "VISITED_STATES",       "visitedStates" },
+        { "VISITED_TRANSITIONS",  "visitedTransitions" },
+        { "EXECUTION_TIME",       "executionTime" }
+};
+
+
+#endif //UTOTPARSER_TARESULTSSTORE_H
@@ -0,0 +1,477 @@
+#ifndef UTOTPARSER_TASNAPSHOT_H
+#define UTOTPARSER_TASNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unistd.h>
+#include "nlohmann/json.hpp"
+
+#include "utilities/Utils.hpp"
+#include "utilities/MappedFile.hpp"
+
+using json = nlohmann::json;
+
+
+// The extension of the snapshot files, which are stored next to the .xml file they have been generated from.
+const std::string SNAPSHOT_EXTENSION { ".tasnap" };
+
+// Increase this value each time the layout of the snapshot changes: snapshots with a different version are regenerated.
+#define SNAPSHOT_VERSION 2
+
+// Value used in the snapshot nodes to represent a missing key.
+#define SNAPSHOT_NONE 0xFFFFFFFFu
+
+
+// Layout of a snapshot file (every section starts at an offset multiple of 8):
+// 1) SnapshotHeader.
+// 2) String offsets: stringCount + 1 uint64_t values, string i spans [offsets[i], offsets[i + 1]) in the string blob.
+// 3) String blob: all the interned strings of the TA, one after the other and without terminators.
+// 4) Nodes: the json tree of the TA in breadth-first order, so that the children of a container are contiguous.
+// Labels are stored as text and not as parsed expressions: TAGraph parses each distinct label once per run, when the
+// first record holding it is built, and a TA only has a handful of distinct labels, hence storing their ASTs would make
+// the snapshot bigger (and tied to the layout of LabelExpression) without saving any measurable time.
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    int64_t sourceMtime;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+    uint32_t stringCount;
+    uint32_t nodeCount;
+    uint64_t stringBlobSize;
+};
+
+enum SnapshotNodeKind : uint32_t {
+    nullNode,
+    stringNode,
+    objectNode,
+    arrayNode
+};
+
+struct SnapshotNode {
+    SnapshotNodeKind kind;
+    // The index of the key of the node in the string table, SNAPSHOT_NONE if the node is an array element or the root.
+    uint32_t key;
+    // For strings the index of the value in the string table, for containers the index of the first child.
+    uint32_t value;
+    uint32_t childCount;
+};
+
+class TASnapshot {
+
+private:
+    MappedFile file;
+
+    const SnapshotHeader *header { nullptr };
+    const uint64_t *stringOffsets { nullptr };
+    const char *stringBlob { nullptr };
+    const SnapshotNode *nodes { nullptr };
+
+
+    static constexpr char MAGIC[8] { 'T', 'A', 'B', 'E', 'C', 'S', 'N', 'P' };
+
+    static constexpr uint32_t BYTE_ORDER_MARK { 0x01020304u };
+
+
+    /**
+     * Method used to round a size up to the next multiple of 8, so that every section of the snapshot is aligned.
+     * @param size the size to round.
+     * @return the smallest multiple of 8 greater than or equal to 'size'.
+     */
+    static uint64_t alignTo8(uint64_t size)
+    {
+        return (size + 7) & ~static_cast<uint64_t>(7);
+    }
+
+
+    /**
+     * Method used to get the last modification time of a file as an integer.
+     * @param path the path to the file.
+     * @return the last modification time of the file, expressed in the file clock ticks.
+     */
+    static int64_t getMtime(const std::string &path)
+    {
+        return static_cast<int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+    }
+
+
+    /**
+     * Method used to check that the mapped file is a well-formed snapshot, setting the pointers to its sections.
+     * Every offset is checked against the size of the file, so that a truncated or corrupted snapshot is never read.
+     * @return true if the mapped file is a valid snapshot of the current version, false otherwise.
+     */
+    bool mapSections()
+    {
+        if (!file.isOpen() || file.getSize() < sizeof(SnapshotHeader))
+            return false;
+
+        header = reinterpret_cast<const SnapshotHeader *>(file.getData());
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+            || header->version != SNAPSHOT_VERSION
+            || header->byteOrderMark != BYTE_ORDER_MARK
+            || header->nodeCount == 0)
+            return false;
+
+        uint64_t offset { alignTo8(sizeof(SnapshotHeader)) };
+        uint64_t offsetsStart { offset };
+        offset += alignTo8((static_cast<uint64_t>(header->stringCount) + 1) * sizeof(uint64_t));
+        uint64_t blobStart { offset };
+        offset += alignTo8(header->stringBlobSize);
+        uint64_t nodesStart { offset };
+        offset += alignTo8(static_cast<uint64_t>(header->nodeCount) * sizeof(SnapshotNode));
+
+        if (offset != file.getSize())
+            return false;
+
+        stringOffsets = reinterpret_cast<const uint64_t *>(file.getData() + offsetsStart);
+        stringBlob = file.getData() + blobStart;
+        nodes = reinterpret_cast<const SnapshotNode *>(file.getData() + nodesStart);
+
+        // The string offsets must be non-decreasing and inside the blob.
+        for (uint32_t i = 0; i < header->stringCount; i++)
+            if (stringOffsets[i] > stringOffsets[i + 1])
+                return false;
+        if (stringOffsets[header->stringCount] > header->stringBlobSize)
+            return false;
+
+        // Every node must reference existing strings and children laying after the node itself.
+        for (uint32_t i = 0; i < header->nodeCount; i++)
+        {
+            const SnapshotNode &node = nodes[i];
+            if (node.key != SNAPSHOT_NONE && node.key >= header->stringCount)
+                return false;
+            if (node.kind == stringNode && node.value >= header->stringCount)
+                return false;
+            if ((node.kind == objectNode || node.kind == arrayNode)
+                && node.childCount > 0
+                && (node.value <= i || static_cast<uint64_t>(node.value) + node.childCount > header->nodeCount))
+                return false;
+            if (node.kind > arrayNode)
+                return false;
+        }
+        return true;
+    }
+
+
+    /**
+     * Method used to get a string from the string table of the snapshot, without copying it.
+     * @param index the index of the string in the string table.
+     * @return a view of the string, which is valid as long as the snapshot is alive.
+     */
+    [[nodiscard]] std::string_view getString(uint32_t index) const
+    {
+        if (index == SNAPSHOT_NONE)
+            return {};
+        return { stringBlob + stringOffsets[index], static_cast<size_t>(stringOffsets[index + 1] - stringOffsets[index]) };
+    }
+
+
+    /**
+     * Method used to rebuild the json subtree rooted in a given node.
+     * @param index the index of the node from which to start.
+     * @return a json representation of the subtree rooted in the node at position 'index'.
+     */
+    json buildJson(uint32_t index) const
+    {
+        const SnapshotNode &node = nodes[index];
+        switch (node.kind)
+        {
+            case stringNode:
+                return json(std::string(getString(node.value)));
+
+            case objectNode:
+            {
+                // Children have been written in the (sorted) iteration order of the json object, hence each
+                // insertion can be hinted at the end of the object, avoiding a lookup for every key.
+                json result = json::object();
+                auto &obj = result.get_ref<json::object_t &>();
+                for (uint32_t i = 0; i < node.childCount; i++)
+                {
+                    uint32_t child = node.value + i;
+                    obj.emplace_hint(obj.end(), std::string(getString(nodes[child].key)), buildJson(child));
+                }
+                return result;
+            }
+
+            case arrayNode:
+            {
+                json result = json::array();
+                result.get_ref<json::array_t &>().reserve(node.childCount);
+                for (uint32_t i = 0; i < node.childCount; i++)
+                    result.push_back(buildJson(node.value + i));
+                return result;
+            }
+
+            default:
+                return nullptr;
+        }
+    }
+
+
+    /**
+     * Method used to read the whole content of a file.
+     * @param path the path to the file to read.
+     * @return a string containing the bytes of the file.
+     */
+    static std::string readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+
+    /**
+     * Method used to check whether the snapshot is still valid for the given .xml file.
+     * If the modification time differs but the size is the same, the content of the .xml file is hashed to decide:
+     * in that case 'xmlContent' is not empty when the method returns, whatever the result.
+     * @param xmlPath the path to the .xml file from which the snapshot has been generated.
+     * @param xmlContent a string that is filled with the content of the .xml file if it had to be read.
+     * @return true if the snapshot represents the current content of the .xml file, false otherwise.
+     */
+    bool isValidFor(const std::string &xmlPath, std::string &xmlContent) const
+    {
+        if (header->sourceSize != std::filesystem::file_size(xmlPath))
+            return false;
+        if (header->sourceMtime == getMtime(xmlPath))
+            return true;
+
+        xmlContent = readFile(xmlPath);
+        return header->sourceHash == computeFNV1aHash(xmlContent);
+    }
+
+
+    /**
+     * Method used to store a new modification time of the .xml file in the header of a snapshot which is still valid,
+     * so that the content of the .xml file is not hashed again at every load. The write is done in place, since the
+     * header has a fixed size and both the old and the new value describe a valid snapshot.
+     * As for the whole snapshot, failures are silently ignored.
+     * @param snapshotPath the path of the snapshot to refresh.
+     * @param xmlPath the path to the .xml file from which the snapshot has been generated.
+     */
+    static void refreshSourceMtime(const std::string &snapshotPath, const std::string &xmlPath)
+    {
+        int64_t sourceMtime = getMtime(xmlPath);
+        std::fstream out(snapshotPath, std::ios::binary | std::ios::in | std::ios::out);
+        if (!out.is_open())
+            return;
+
+        out.seekp(static_cast<std::streamoff>(offsetof(SnapshotHeader, sourceMtime)));
+        out.write(reinterpret_cast<const char *>(&sourceMtime), sizeof(sourceMtime));
+    }
+
+
+    /**
+     * Method used to serialize a TA into the snapshot format and to write it on disk.
+     * The file is first written with a temporary name and then renamed, so that concurrent readers never see a partial snapshot.
+     * Failures are silently ignored, since the snapshot is only a cache: the next run will simply parse the .xml file again.
+     * @param ta the json representation of the TA.
+     * @param snapshotPath the path of the snapshot to write.
+     * @param xmlPath the path to the .xml file from which the TA has been parsed.
+     * @param xmlContent the content of the .xml file.
+     */
+    static void writeSnapshot(const json &ta, const std::string &snapshotPath, const std::string &xmlPath, const std::string &xmlContent)
+    {
+        std::vector<std::string_view> strings {};
+        std::unordered_map<std::string_view, uint32_t> stringIndexes {};
+        uint64_t stringBlobSize {};
+
+        // Strings are interned, since keys like "@id" or "#text" are repeated for every location and transition.
+        auto intern = [&](const std::string &str) -> uint32_t {
+            auto found = stringIndexes.find(str);
+            if (found != stringIndexes.end())
+                return found->second;
+            auto index = static_cast<uint32_t>(strings.size());
+            strings.emplace_back(str);
+            stringIndexes.emplace(strings.back(), index);
+            stringBlobSize += str.size();
+            return index;
+        };
+
+        // The tree is visited in breadth-first order, reserving contiguous slots for the children of each container.
+        std::vector<SnapshotNode> nodes {};
+        std::vector<const json *> visited {};
+        nodes.push_back({ nullNode, SNAPSHOT_NONE, 0, 0 });
+        visited.push_back(&ta);
+
+        for (size_t i = 0; i < visited.size(); i++)
+        {
+            const json &current = *visited[i];
+            if (current.is_string())
+            {
+                nodes[i].kind = stringNode;
+                nodes[i].value = intern(current.get_ref<const std::string &>());
+            } else if (current.is_object() || current.is_array())
+            {
+                nodes[i].kind = current.is_object() ? objectNode : arrayNode;
+                nodes[i].value = static_cast<uint32_t>(nodes.size());
+                nodes[i].childCount = static_cast<uint32_t>(current.size());
+                for (auto it = current.begin(); it != current.end(); ++it)
+                {
+                    nodes.push_back({ nullNode, current.is_object() ? intern(it.key()) : SNAPSHOT_NONE, 0, 0 });
+                    visited.push_back(&it.value());
+                }
+            } else if (!current.is_null())
+                // Values are always strings when coming from xml2json: anything else cannot be stored.
+                return;
+        }
+
+        SnapshotHeader header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = SNAPSHOT_VERSION;
+        header.byteOrderMark = BYTE_ORDER_MARK;
+        header.sourceMtime = getMtime(xmlPath);
+        header.sourceSize = xmlContent.size();
+        header.sourceHash = computeFNV1aHash(xmlContent);
+        header.stringCount = static_cast<uint32_t>(strings.size());
+        header.nodeCount = static_cast<uint32_t>(nodes.size());
+        header.stringBlobSize = stringBlobSize;
+
+        std::vector<uint64_t> stringOffsets {};
+        stringOffsets.reserve(strings.size() + 1);
+        uint64_t currentOffset {};
+        for (const auto &str: strings)
+        {
+            stringOffsets.push_back(currentOffset);
+            currentOffset += str.size();
+        }
+        stringOffsets.push_back(currentOffset);
+
+        // The temporary name is unique to the process and to the thread, since the same tile may be loaded concurrently.
+        std::string tmpPath = snapshotPath + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+                return;
+
+            const char padding[8] {};
+            auto writeSection = [&](const void *data, uint64_t size) {
+                out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+                out.write(padding, static_cast<std::streamsize>(alignTo8(size) - size));
+            };
+
+            writeSection(&header, sizeof(header));
+            writeSection(stringOffsets.data(), stringOffsets.size() * sizeof(uint64_t));
+            for (const auto &str: strings)
+                out.write(str.data(), static_cast<std::streamsize>(str.size()));
+            out.write(padding, static_cast<std::streamsize>(alignTo8(stringBlobSize) - stringBlobSize));
+            writeSection(nodes.data(), nodes.size() * sizeof(SnapshotNode));
+
+            if (!out.good())
+            {
+                out.close();
+                std::filesystem::remove(tmpPath);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, snapshotPath, ec);
+        if (ec)
+            std::filesystem::remove(tmpPath, ec);
+    }
+
+
+public:
+    /**
+     * Default parametric constructor, mapping a snapshot file in memory.
+     * Use isValid() to check whether the mapped file is actually a readable snapshot.
+     * @param snapshotPath the path to the snapshot file.
+     */
+    explicit TASnapshot(const std::string &snapshotPath) : file(snapshotPath)
+    {
+        if (!mapSections())
+            header = nullptr;
+    }
+
+
+    [[nodiscard]] bool isValid() const
+    {
+        return header != nullptr;
+    }
+
+
+    /**
+     * Method used to rebuild the json representation of the TA stored in the snapshot.
+     * The result is identical to the one obtained by parsing the original .xml file.
+     * @return a json representation of the TA.
+     */
+    [[nodiscard]] json toJson() const
+    {
+        return buildJson(0);
+    }
+
+
+    /**
+     * Method used to get the path of the snapshot associated to an .xml file.
+     * @param xmlPath the path to the .xml file.
+     * @return the path of the snapshot, located in the same directory of the .xml file.
+     */
+    static std::string getSnapshotPath(const std::string &xmlPath)
+    {
+        return std::filesystem::path(xmlPath).replace_extension(SNAPSHOT_EXTENSION).string();
+    }
+
+
+    /**
+     * Method used to get the json representation of a TA stored in an .xml file, using its snapshot if it is up-to-date.
+     * If the snapshot is missing or stale, the .xml file is parsed and a new snapshot is written next to it,
+     * so that subsequent loads of the same file avoid the xml to json conversion.
+     * @param xmlPath the path to the .xml file containing the TA.
+     * @return a json representation of the TA.
+     */
+    static json loadTA(const std::string &xmlPath)
+    {
+        std::string snapshotPath = getSnapshotPath(xmlPath);
+        std::string xmlContent {};
+
+        {
+            TASnapshot snapshot(snapshotPath);
+            if (snapshot.isValid() && snapshot.isValidFor(xmlPath, xmlContent))
+            {
+                json ta = snapshot.toJson();
+                // The .xml file has been hashed only if its modification time changed (e.g., it has been touched).
+                if (!xmlContent.empty())
+                    refreshSourceMtime(snapshotPath, xmlPath);
+                return ta;
+            }
+        }
+
+        if (xmlContent.empty())
+            xmlContent = readFile(xmlPath);
+
+        // The content is still needed for hashing, hence the conversion is given a copy of it.
+        json ta = getJsonFromXmlContent(xmlContent);
+
+        writeSnapshot(ta, snapshotPath, xmlPath, xmlContent);
+        return ta;
+    }
+
+
+    /**
+     * Method used to remove the snapshots of a directory whose .xml file does not exist anymore.
+     * @param dirPath the path to the directory containing the .xml files and their snapshots.
+     */
+    static void removeOrphanSnapshots(const std::string &dirPath)
+    {
+        std::error_code ec;
+        for (const auto &entry: std::filesystem::directory_iterator(dirPath, ec))
+        {
+            if (entry.path().extension() != SNAPSHOT_EXTENSION)
+                continue;
+            if (!std::filesystem::exists(std::filesystem::path(entry.path()).replace_extension(".xml"), ec))
+                std::filesystem::remove(entry.path(), ec);
+        }
+    }
+
+};
+
+
+#endif //UTOTPARSER_TASNAPSHOT_H
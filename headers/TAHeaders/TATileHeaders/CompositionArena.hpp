@@ -0,0 +1,81 @@
+#ifndef UTOTPARSER_COMPOSITIONARENA_H
+#define UTOTPARSER_COMPOSITIONARENA_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// The number of bytes available to the arena before it has to ask the system for more memory.
+#define COMPOSITION_ARENA_INITIAL_SIZE (1 << 16)
+
+
+// Arena for the short-lived objects created while composing a TA.
+// ----------------------------------------------------------------
+// Actions, operators, connectors and random creators only live while a single token is processed, and are created by
+// factories as pointers to their base class. Instead of allocating each of them on the heap (and never freeing it),
+// they are placed one after the other in a buffer which is released as a whole when the TA has been composed.
+// Objects are destroyed by their actual type, hence their base classes do not need a virtual destructor.
+// Each thread has its own arena, since each thread composes its own TAs.
+
+class CompositionArena {
+
+private:
+    // The buffer used before any memory is requested to the system, so that composing a small TA never allocates.
+    static thread_local std::array<std::byte, COMPOSITION_ARENA_INITIAL_SIZE> initialBuffer;
+
+    static thread_local std::pmr::monotonic_buffer_resource resource;
+
+    // The objects that have to be destroyed when the arena is reset, together with the function destroying them.
+    static thread_local std::vector<std::pair<void *, void (*)(void *)>> objects;
+
+
+public:
+    /**
+     * Method used to create an object inside the arena.
+     * The object must not be deleted: it is destroyed when the arena is reset.
+     * @tparam T the type of the object.
+     * @param args the arguments to pass to the constructor of the object.
+     * @return a pointer to the object, valid until the arena is reset.
+     */
+    template<typename T, typename... Args>
+    static T *create(Args &&... args)
+    {
+        void *memory = resource.allocate(sizeof(T), alignof(T));
+        T *object = new(memory) T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            objects.emplace_back(object, [](void *ptr) { static_cast<T *>(ptr)->~T(); });
+
+        return object;
+    }
+
+
+    /**
+     * Method used to destroy all the objects of the arena and to make its memory available again.
+     * It must be called only when none of the created objects is in use anymore, i.e., after a TA has been composed.
+     */
+    static void reset()
+    {
+        for (auto object = objects.rbegin(); object != objects.rend(); ++object)
+            object->second(object->first);
+        objects.clear();
+        resource.release();
+    }
+
+};
+
+
+// Defining static attributes.
+thread_local std::array<std::byte, COMPOSITION_ARENA_INITIAL_SIZE> CompositionArena::initialBuffer {};
+
+thread_local std::pmr::monotonic_buffer_resource CompositionArena::resource { CompositionArena::initialBuffer.data(), CompositionArena::initialBuffer.size() };
+
+thread_local std::vector<std::pair<void *, void (*)(void *)>> CompositionArena::objects {};
+
+
+#endif //UTOTPARSER_COMPOSITIONARENA_H
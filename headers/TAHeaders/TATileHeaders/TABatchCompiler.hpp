@@ -0,0 +1,172 @@
+#ifndef UTOTPARSER_TABATCHCOMPILER_H
+#define UTOTPARSER_TABATCHCOMPILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utilities/StringsGetter.hpp"
+#include "TAHeaders/TABoundsCalculator.hpp"
+#include "TAHeaders/TADotConverter.hpp"
+#include "TAHeaders/TAGraph.hpp"
+#include "TAHeaders/TAutotTranslator.hpp"
+#include "TAHeaders/TATileHeaders/TATileRenamer.hpp"
+#include "TAHeaders/TATileHeaders/lexerAndParser/TATileInputParser.hpp"
+#include "defines/ANSI-color-codes.h"
+
+
+/**
+ * Struct representing a compositional string of a batch, together with the result of its compilation.
+ */
+typedef struct bcs {
+    // The number of the line containing the string, starting from 1.
+    size_t line;
+    std::string compositionalString;
+    // The name given to the TA, which is also the name of its .tck and .dot files.
+    std::string taName;
+    // The message of the error raised while compiling the string, empty if the string has been compiled successfully.
+    std::string error;
+} BatchString;
+
+
+// Compiler of batches of compositional strings.
+// ---------------------------------------------
+// The strings are compiled concurrently by a pool of threads, each with its own parser, while the tiles are read
+// from the TileLibrary, which is shared by all the threads. Everything else a composition changes (the nonce used to
+// rename tiles, the bounds, the composition arena) is kept separately by each thread.
+// Each string is compiled exactly as it would be compiled alone, and a failing string never stops the batch.
+
+class TABatchCompiler {
+
+private:
+    StringsGetter &stringsGetter;
+
+    std::vector<BatchString> batch {};
+
+
+    /**
+     * Method used to compile a single string of the batch, writing the .tck and .dot files of the resulting TA.
+     * A string whose files cannot be written is not compiled, as it happens when its composition fails.
+     * @param batchString the string to compile, where the error is stored if the compilation fails.
+     * @param taTileInputParser the parser of the thread compiling the string.
+     */
+    void compile(BatchString &batchString, TATileInputParser &taTileInputParser)
+    {
+        // The nonce and the bounds are reset so that the TA is the same it would be if the string were compiled alone.
+        TATileRenamer::resetTANonce();
+        TABoundsCalculator::resetBoundCalculator();
+
+        try
+        {
+            TAGraph tiledTA = taTileInputParser.getTiledTA(batchString.compositionalString);
+
+            std::string dotFilePath { stringsGetter.getOutputDOTsDirPath() + "/" += (batchString.taName + ".dot") };
+            TADotConverter taDotConverter(dotFilePath);
+            bool isDotWritten = taDotConverter.translateTAtoDot(batchString.taName, tiledTA);
+
+            std::string tckFilePath { stringsGetter.getOutputDirPath() + "/" += (batchString.taName + ".tck") };
+            Translator translator(tckFilePath);
+            bool isTckWritten = translator.translateTA(batchString.taName, tiledTA);
+
+            if (!isDotWritten || !isTckWritten)
+                batchString.error = "Failed to write file: " + (isTckWritten ? dotFilePath : tckFilePath);
+        } catch (std::exception &e)
+        {
+            batchString.error = e.what();
+        }
+    }
+
+
+public:
+    explicit TABatchCompiler(StringsGetter &stringsGetter) : stringsGetter(stringsGetter)
+    {};
+
+
+    /**
+     * Method used to read the compositional strings of a batch, one per line.
+     * Empty lines and lines starting with '#' are skipped, but they are still counted when numbering the strings.
+     * @param in the stream from which to read the strings.
+     * @param namePrefix the prefix of the names given to the TAs, which are followed by the number of their line.
+     */
+    void readBatch(std::istream &in, const std::string &namePrefix)
+    {
+        std::string line {};
+        size_t lineNumber = 0;
+        while (std::getline(in, line))
+        {
+            lineNumber++;
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+
+            size_t last = line.find_last_not_of(" \t\r");
+            batch.push_back({ lineNumber, line.substr(first, last - first + 1), namePrefix + std::to_string(lineNumber), "" });
+        }
+    }
+
+
+    /**
+     * Method used to compile all the strings of the batch.
+     * While the strings are compiled, the standard output is silenced, since the logs of concurrent compositions
+     * would be interleaved: the outcome of each string is given by getBatch once the compilation is over.
+     * @param threads the number of threads compiling the strings (at least one).
+     */
+    void compileBatch(unsigned int threads)
+    {
+        threads = std::max(1u, std::min<unsigned int>(threads, static_cast<unsigned int>(batch.size())));
+        std::atomic<size_t> next { 0 };
+
+        auto worker = [&]() {
+            TATileInputParser taTileInputParser(stringsGetter);
+            for (size_t i = next++; i < batch.size(); i = next++)
+                compile(batch[i], taTileInputParser);
+        };
+
+        std::cout.setstate(std::ios::badbit);
+
+        std::vector<std::thread> pool {};
+        for (unsigned int i = 1; i < threads; i++)
+            pool.emplace_back(worker);
+        worker();
+        for (std::thread &thread: pool)
+            thread.join();
+
+        std::cout.clear();
+    }
+
+
+    [[nodiscard]] const std::vector<BatchString> &getBatch() const
+    {
+        return batch;
+    }
+
+
+    /**
+     * Method used to print the outcome of the compilation: every failed string is reported with its error.
+     * @return the number of strings that could not be compiled.
+     */
+    [[nodiscard]] size_t printReport() const
+    {
+        size_t failed = 0;
+        for (const BatchString &batchString: batch)
+        {
+            if (batchString.error.empty())
+                continue;
+            failed++;
+            std::cerr << BHRED << "Line " << batchString.line << " (" << batchString.taName << "): " << batchString.error << rstColor << '\n';
+            std::cerr << BHRED << "$> " << batchString.compositionalString << rstColor << '\n';
+        }
+
+        std::cout << ((failed == 0) ? BHGRN : BHYEL) << "Compiled " << (batch.size() - failed) << " out of "
+                  << batch.size() << " compositional strings" << rstColor << std::endl;
+        return failed;
+    }
+
+};
+
+
+#endif //UTOTPARSER_TABATCHCOMPILER_H
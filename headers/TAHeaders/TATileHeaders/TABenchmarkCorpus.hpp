@@ -0,0 +1,372 @@
+#ifndef UTOTPARSER_TABENCHMARKCORPUS_H
+#define UTOTPARSER_TABENCHMARKCORPUS_H
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+#include "utilities/StringsGetter.hpp"
+#include "utilities/MappedFile.hpp"
+#include "utilities/OutputBuffer.hpp"
+#include "utilities/RandomStream.hpp"
+#include "TAHeaders/TABoundsCalculator.hpp"
+#include "TAHeaders/TAGraph.hpp"
+#include "TAHeaders/TAXmlConverter.hpp"
+#include "TAHeaders/TAutotTranslator.hpp"
+#include "TAHeaders/TATileHeaders/TATileRenamer.hpp"
+#include "TAHeaders/TATileHeaders/lexerAndParser/TATileInputParser.hpp"
+#include "defines/ANSI-color-codes.h"
+
+using json = nlohmann::json;
+
+
+/**
+ * Struct representing a TA of the benchmark corpus, together with the properties written in the manifest.
+ */
+typedef struct bmt {
+    // The name of the TA, followed by '_Param' or '_NoParam' in the names of its files and of their systems.
+    std::string name;
+    // The number of locations the TA is built to have.
+    uint32_t targetLocations;
+    // True if the language of the TA is empty whatever the value of the parameter.
+    bool isEmpty;
+    // The index of the random stream the TA is generated from (together with the seed of the corpus).
+    uint64_t streamIndex;
+    std::string compositionalString;
+    uint32_t locations;
+    uint32_t transitions;
+    uint32_t finalLocations;
+} BenchmarkTA;
+
+
+// Corpus of TAs used to benchmark the tools.
+// ------------------------------------------
+// For each size of the ladder, two TAs are composed out of the tiles in 'inputTiles' and of Barabasi-Albert random tiles:
+// - A known-non-empty TA: bin_acc_2_8 + FILL. The 'out' location of bin_acc_2_8 is final and has a self-loop without
+//   guards, hence every value 2 < param < 8 is accepted, whatever FILL (which is only reached after it) contains.
+// - A known-empty TA: FILL + bin_1_1 + bin_3_inf + acc. The only final location is the one of acc, which can only be
+//   reached with param = 1 and param > 3 at once, hence no value of param is accepted (FILL has no final locations).
+// FILL is a chain of Barabasi-Albert tiles (t:BA[n] has n + 2 locations) sized so that the TA has exactly the number of
+// locations of its rung (a binary tile is used when only 3 locations are missing). Every tile is nrt, and so are the
+// transitions added by the binary operator, hence every TA of the corpus is nrt.
+// Each TA is written both as it is (parametric) and with param replaced by 'nonParametricValue' (non-parametric), as the
+// checking scripts do. The verdicts hold for the non-parametric TAs as well, since 2 < 4 < 8 and no value is ever accepted
+// by the empty TAs. Every TA is written in UPPAAL's xml format (for the converter) and in tChecker's format (for the checker),
+// and the manifest lists the properties of all of them.
+// Random tiles are drawn from the stream given by the seed of the corpus and by the index of the TA only, hence the same
+// seed always gives the same corpus.
+
+class TABenchmarkCorpus {
+
+private:
+    // The sizes of the ladder, i.e., the number of locations of the TAs.
+    static const std::vector<uint32_t> ladder;
+
+    // The maximum number of nodes of each Barabasi-Albert tile of FILL.
+    static const uint32_t maxRandomTileNodes;
+
+    // The value given to param in the non-parametric TAs.
+    static const int nonParametricValue;
+
+    // The open interval of the values of param accepted by the known-non-empty TAs.
+    static const std::pair<int, int> acceptedParameters;
+
+    StringsGetter &stringsGetter;
+
+    // The path of the directory where the corpus is written.
+    std::string corpusDirPath {};
+
+    uint64_t seed {};
+
+    // The number of locations after which the ladder stops.
+    uint32_t maxLocations {};
+
+    std::vector<BenchmarkTA> corpus {};
+
+
+    /**
+     * Method used to get a chain of tiles having exactly the given number of locations and no final locations.
+     * @param locations the number of locations of the chain (either 3 or at least 6).
+     * @return the tiles of the chain, joined by the binary operator.
+     */
+    static std::string getFill(uint32_t locations)
+    {
+        if (locations == 3)
+            return "bin_0_5";
+
+        // The locations are shared evenly among the fewest tiles having at most 'maxRandomTileNodes' nodes each.
+        uint32_t tiles { (locations + maxRandomTileNodes + 1) / (maxRandomTileNodes + 2) };
+        std::string fill {};
+        for (uint32_t i = 0; i < tiles; i++)
+        {
+            uint32_t tileLocations { locations / tiles + (i < locations % tiles ? 1 : 0) };
+            if (!fill.empty())
+                fill.append(" + ");
+            fill.append("t:BA[" + std::to_string(tileLocations - 2) + "]");
+        }
+        return fill;
+    }
+
+
+    /**
+     * Method used to get the compositional string of a TA of the corpus.
+     * @param locations the number of locations of the TA.
+     * @param isEmpty true if the language of the TA has to be empty.
+     * @return the compositional string of the TA.
+     */
+    static std::string getCompositionalString(uint32_t locations, bool isEmpty)
+    {
+        // bin_acc_2_8 has 3 locations, while bin_1_1 + bin_3_inf + acc has 7 locations.
+        return isEmpty ? getFill(locations - 7) + " + bin_1_1 + bin_3_inf + acc" : "bin_acc_2_8 + " + getFill(locations - 3);
+    }
+
+
+    /**
+     * Method used to copy a file replacing some words with other ones, e.g., the parameter keyword with a value.
+     * Only whole words are replaced, so that identifiers merely containing one of the words are left untouched.
+     * @param inFilePath the path of the file to copy.
+     * @param outFilePath the path of the copy.
+     * @param substitutions the words to replace, each one together with its replacement.
+     * @return true if the copy has been written, false otherwise.
+     */
+    static bool writeWithSubstitutions(const std::string &inFilePath, const std::string &outFilePath,
+                                       const std::vector<std::pair<std::string, std::string>> &substitutions)
+    {
+        MappedFile in(inFilePath);
+        if (!in.isOpen())
+            return false;
+
+        auto isIdentifierChar = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+        std::string_view text(in.getData(), in.getSize());
+        OutputBuffer out {};
+        bool isStreaming = out.startStreaming(outFilePath);
+
+        // The text is copied up to 'start', and each word is looked up among the ones to replace.
+        size_t start = 0;
+        size_t i = 0;
+        while (i < text.size())
+        {
+            if (!isIdentifierChar(text[i]))
+            {
+                i++;
+                continue;
+            }
+
+            size_t end = i;
+            while (end < text.size() && isIdentifierChar(text[end]))
+                end++;
+
+            std::string_view word { text.substr(i, end - i) };
+            for (const auto &substitution: substitutions)
+                if (word == substitution.first)
+                {
+                    out << text.substr(start, i - start) << substitution.second;
+                    start = end;
+                    out.flushIfFull();
+                    break;
+                }
+            i = end;
+        }
+        out << text.substr(start);
+
+        return isStreaming && out.finishStreaming();
+    }
+
+
+    /**
+     * Method used to compose a TA of the corpus and to write its parametric and non-parametric files.
+     * @param benchmarkTA the TA to compose, where the properties of the composed TA are stored.
+     * @param taTileInputParser the parser used to compose the TA.
+     * @return true if the TA has the wanted number of locations and all its files have been written, false otherwise.
+     */
+    bool generate(BenchmarkTA &benchmarkTA, TATileInputParser &taTileInputParser)
+    {
+        // The nonce and the bounds are reset so that the TA does not depend on the TAs generated before it.
+        RandomStream::seed(seed, benchmarkTA.streamIndex);
+        TATileRenamer::resetTANonce();
+        TABoundsCalculator::resetBoundCalculator();
+
+        TAGraph tiledTA = taTileInputParser.getTiledTA(benchmarkTA.compositionalString);
+
+        benchmarkTA.locations = tiledTA.getLocationCount();
+        benchmarkTA.transitions = tiledTA.getEdgeCount();
+        benchmarkTA.finalLocations = 0;
+        tiledTA.forEachLocation([&](uint32_t, const GraphLocation &location) {
+            benchmarkTA.finalLocations += location.isFinal;
+        });
+
+        std::string parametricName { getTAName(benchmarkTA, true) };
+        std::string nonParametricName { getTAName(benchmarkTA, false) };
+
+        TAXmlConverter taXmlConverter(getXmlFilePath(parametricName));
+        bool isWritten = taXmlConverter.translateTAtoXml(parametricName, tiledTA);
+
+        Translator translator(getTckFilePath(parametricName));
+        isWritten = translator.translateTA(parametricName, tiledTA) && isWritten;
+
+        // The files of the non-parametric TA are copies of the parametric ones, where the system is also renamed.
+        std::vector<std::pair<std::string, std::string>> substitutions {{ "param",        std::to_string(nonParametricValue) },
+                                                                        { parametricName, nonParametricName }};
+        isWritten = writeWithSubstitutions(getXmlFilePath(parametricName), getXmlFilePath(nonParametricName), substitutions) && isWritten;
+        isWritten = writeWithSubstitutions(getTckFilePath(parametricName), getTckFilePath(nonParametricName), substitutions) && isWritten;
+
+        return isWritten && benchmarkTA.locations == benchmarkTA.targetLocations;
+    }
+
+
+    /**
+     * Method used to get the name of a TA of the corpus, written either as it is or with a value for param.
+     * @param benchmarkTA the TA.
+     * @param isParametric true for the parametric TA, false for the non-parametric one.
+     * @return the name of the system of the TA, which is also the name of its files (without the extension).
+     */
+    static std::string getTAName(const BenchmarkTA &benchmarkTA, bool isParametric)
+    {
+        return benchmarkTA.name + (isParametric ? "_Param" : "_NoParam");
+    }
+
+
+    [[nodiscard]] std::string getXmlFilePath(const std::string &name) const
+    {
+        return corpusDirPath + "/xml/" + name + ".xml";
+    }
+
+
+    [[nodiscard]] std::string getTckFilePath(const std::string &name) const
+    {
+        return corpusDirPath + "/tck/" + name + ".tck";
+    }
+
+
+    /**
+     * Method used to get the manifest entry of a TA of the corpus, written either as it is or with a value for param.
+     * @param benchmarkTA the TA.
+     * @param isParametric true for the entry of the parametric TA, false for the one of the non-parametric TA.
+     * @return the json representation of the entry.
+     */
+    [[nodiscard]] json getManifestEntry(const BenchmarkTA &benchmarkTA, bool isParametric) const
+    {
+        std::string name { getTAName(benchmarkTA, isParametric) };
+
+        // The values of param accepted by the TA (an open interval), only given for the parametric non-empty TAs.
+        json accepted = nullptr;
+        if (isParametric && !benchmarkTA.isEmpty)
+            accepted = {{ "l", acceptedParameters.first }, { "r", acceptedParameters.second }};
+
+        return {{ "name",                name },
+                { "xmlFile",             "xml/" + name + ".xml" },
+                { "tckFile",             "tck/" + name + ".tck" },
+                { "targetLocations",     benchmarkTA.targetLocations },
+                { "locations",           benchmarkTA.locations },
+                { "transitions",         benchmarkTA.transitions },
+                { "finalLocations",      benchmarkTA.finalLocations },
+                { "isNRT",               true },
+                { "isParametric",        isParametric },
+                { "parameterValue",      isParametric ? json(nullptr) : json(nonParametricValue) },
+                { "expectedVerdict",     benchmarkTA.isEmpty ? "empty" : "not empty" },
+                { "acceptedParameters",  accepted },
+                { "streamIndex",         benchmarkTA.streamIndex },
+                { "compositionalString", benchmarkTA.compositionalString }};
+    }
+
+
+public:
+    /**
+     * Default parametric constructor.
+     * @param stringsGetter the getter of the paths to the input directories.
+     * @param corpusDirPath the path of the directory where the corpus will be written.
+     * @param seed the seed from which the random tiles are drawn.
+     * @param maxLocations the number of locations after which the ladder stops.
+     */
+    TABenchmarkCorpus(StringsGetter &stringsGetter, std::string corpusDirPath, uint64_t seed, uint32_t maxLocations) :
+            stringsGetter(stringsGetter), corpusDirPath(std::move(corpusDirPath)), seed(seed), maxLocations(maxLocations)
+    {
+        for (uint32_t locations: ladder)
+        {
+            if (locations > maxLocations)
+                break;
+            for (bool isEmpty: { false, true })
+            {
+                std::string name { "BenchTA_" + std::to_string(locations) + (isEmpty ? "_Empty" : "_NonEmpty") };
+                corpus.push_back({ name, locations, isEmpty, static_cast<uint64_t>(corpus.size()),
+                                   getCompositionalString(locations, isEmpty), 0, 0, 0 });
+            }
+        }
+    }
+
+
+    /**
+     * Method used to generate the whole corpus and its manifest.
+     * The logs of the compositions are silenced, while a line is printed for each TA once it has been written.
+     * @return the number of TAs that could not be generated as expected.
+     */
+    size_t generateCorpus()
+    {
+        std::filesystem::create_directories(corpusDirPath + "/xml");
+        std::filesystem::create_directories(corpusDirPath + "/tck");
+
+        TATileInputParser taTileInputParser(stringsGetter);
+
+        json manifest = {{ "seed",               seed },
+                         { "nonParametricValue", nonParametricValue },
+                         { "maxRandomTileNodes", maxRandomTileNodes },
+                         { "tas",                json::array() }};
+
+        size_t failed = 0;
+        for (BenchmarkTA &benchmarkTA: corpus)
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            std::string error {};
+            std::cout.setstate(std::ios::badbit);
+            try
+            {
+                if (!generate(benchmarkTA, taTileInputParser))
+                    error = "expected " + std::to_string(benchmarkTA.targetLocations) + " locations, got " +
+                            std::to_string(benchmarkTA.locations) + " (or its files could not be written)";
+            } catch (std::exception &e)
+            {
+                error = e.what();
+            }
+            std::cout.clear();
+
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (!error.empty())
+            {
+                failed++;
+                std::cerr << BHRED << benchmarkTA.name << ": " << error << rstColor << std::endl;
+            } else
+                std::cout << BHGRN << benchmarkTA.name << rstColor << ": " << benchmarkTA.locations << " locations, "
+                          << benchmarkTA.transitions << " transitions (" << std::fixed << std::setprecision(2)
+                          << elapsed.count() << " s)" << std::endl;
+
+            manifest["tas"].push_back(getManifestEntry(benchmarkTA, true));
+            manifest["tas"].push_back(getManifestEntry(benchmarkTA, false));
+        }
+
+        std::ofstream out(corpusDirPath + "/Manifest.json", std::ofstream::out | std::ofstream::trunc);
+        out << std::setw(4) << manifest << std::endl;
+        return failed;
+    }
+
+};
+
+
+// Defining static attributes.
+const std::vector<uint32_t> TABenchmarkCorpus::ladder { 10, 100, 1000, 10000, 100000, 1000000 };
+const uint32_t TABenchmarkCorpus::maxRandomTileNodes { 1000 };
+const int TABenchmarkCorpus::nonParametricValue { 4 };
+const std::pair<int, int> TABenchmarkCorpus::acceptedParameters { 2, 8 };
+
+
+#endif //UTOTPARSER_TABENCHMARKCORPUS_H
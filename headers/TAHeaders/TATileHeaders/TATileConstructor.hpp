@@ -6,6 +6,8 @@
 
 #include "defines/UPPAALxmlAttributes.h"
 #include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TAGraph.hpp"
+#include "TAHeaders/TATileHeaders/CompositionArena.hpp"
 #include "TAHeaders/TATileHeaders/TATileRenamer.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/Connector.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/ConnectorFactory.hpp"
@@ -26,26 +28,41 @@ private:
 
     /**
      * Method used to call auxiliary methods that will then merge locations and transitions.
-     * @param destTile the destination tile in which all the tiles will be merged.
+     * @param destTile the destination tile in which all the tiles will be merged, initially containing only the first one.
+     * @param graphs the graphs of the tiles to merge into destTile (except the first one).
      */
-    void mergeTiles(json &destTile)
+    static void mergeTiles(TAGraph &destTile, std::vector<TAGraph> &graphs)
     {
         std::cout << "Starting tile merging process." << std::endl;
 
+        // The 'out' locations of each tile and the 'in' locations of the following one, as positions inside destTile.
+        std::vector<std::vector<uint32_t>> outLocs { destTile.getPorts(OUT) };
+        std::vector<std::vector<uint32_t>> inLocs { {} };
+
         // For each tile, we have to merge it with the destination one.
-        for (int i = 1; i < tiles.size(); i++)
+        for (auto &graph: graphs)
         {
-            mergeLocations(tiles[i].second, destTile);
-            mergeTransitions(tiles[i].second, destTile);
+            outLocs.push_back(graph.getPorts(OUT));
+            inLocs.push_back(graph.getPorts(IN));
+
+            // Since only the records of the smaller tile are moved, the positions of the tiles merged so far may be shifted.
+            std::pair<uint32_t, uint32_t> offsets = mergeTile(std::move(graph), destTile);
+            for (size_t i = 0; i < outLocs.size() - 1; i++)
+            {
+                TAGraph::shiftPositions(outLocs[i], offsets.first);
+                TAGraph::shiftPositions(inLocs[i], offsets.first);
+            }
+            TAGraph::shiftPositions(outLocs.back(), offsets.second);
+            TAGraph::shiftPositions(inLocs.back(), offsets.second);
         }
 
-        TileConnectorFactory *tileConnectorFactory = new ConnectorFactory;
+        ConnectorFactory tileConnectorFactory;
 
         // For each tile couple, we have to make new transitions to let them be connected.
-        for (int i = 0; i < tiles.size() - 1; i++)
+        for (size_t i = 0; i + 1 < outLocs.size(); i++)
         {
             Connector *connector;
-            connector = tileConnectorFactory->createConnector(tiles[i].second, tiles[i + 1].second, destTile, only_one_out);
+            connector = tileConnectorFactory.createConnector(outLocs[i], inLocs[i + 1], destTile, only_one_out);
             connector->connectTiles();
         }
     }
@@ -60,42 +77,18 @@ public:
 
 
     /**
-     * Method used to merge two tiles' locations into one single tile.
-     * @param sourceTile the tile which locations will be merged into the destTile tile.
-     * @param destTile the tile in which locations will be merged from sourceTile tile.
+     * Method used to merge two tiles' locations and transitions into one single tile.
+     * The locations and transitions of sourceTile come after the ones of destTile, in this order.
+     * @param sourceTile the tile which locations and transitions will be moved into the destTile tile.
+     * @param destTile the tile in which locations and transitions will be merged from sourceTile tile.
+     * @return the offsets to add to the positions of destTile and of sourceTile, respectively, to get their positions in the merged tile.
      */
-    static void mergeLocations(const json &sourceTile, json &destTile)
+    static std::pair<uint32_t, uint32_t> mergeTile(TAGraph &&sourceTile, TAGraph &destTile)
     {
         std::cout << "Now merging locations." << std::endl;
-
-        // A json representation of the locations section of the source tile, given as a json array.
-        json sourceTileLocations = getJsonAsArray(TAContentExtractor::getLocations(sourceTile));
-
-        // A pointer to the json representation of the locations section of the destination tile.
-        json *destTileLocationsPtr = getJsonPtrAsArray(TAContentExtractor::getLocationsPtr(destTile));
-
-        for (const auto &loc: sourceTileLocations)
-            destTileLocationsPtr->push_back(loc);
-    }
-
-
-    /**
-     * Method used to merge two tiles' transitions into one single tile.
-     * @param sourceTile the tile which transitions will be merged into the destTile tile.
-     * @param destTile the tile in which transitions will be merged from sourceTile tile.
-     */
-    static void mergeTransitions(const json &sourceTile, json &destTile)
-    {
         std::cout << "Now merging transitions." << std::endl;
 
-        // A json representation of the transitions section of the source tile, given as a json array.
-        json sourceTileTransitions = getJsonAsArray(TAContentExtractor::getTransitions(sourceTile));
-
-        // A pointer to the json representation of the transitions section of the destination tile.
-        json *destTileTransitionsPtr = getJsonPtrAsArray(TAContentExtractor::getTransitionsPtr(destTile));
-
-        for (const auto &trans: sourceTileTransitions)
-            destTileTransitionsPtr->push_back(trans);
+        return destTile.append(std::move(sourceTile));
     }
 
 
@@ -111,14 +104,22 @@ public:
         std::cout << "Renaming IDs." << std::endl;
         TATileRenamer::renameIDs(tiles);
 
+        std::vector<TAGraph> graphs {};
+        for (const auto &tile: tiles)
+            graphs.push_back(TAGraph::fromJson(std::make_shared<const json>(tile.second)));
+
         // Destination tile, the one in which all the other tiles will be merged.
-        json destTile = tiles[0].second;
+        TAGraph destTile = std::move(graphs.front());
+        graphs.erase(graphs.begin());
 
         // If we have 2 or more tiles, we can merge all of them together.
-        if (tiles.size() > 1)
-            mergeTiles(destTile);
+        if (!graphs.empty())
+            mergeTiles(destTile, graphs);
+
+        // The connectors used to merge the tiles are not needed anymore.
+        CompositionArena::reset();
 
-        return destTile;
+        return destTile.toJson();
     }
 
 };
@@ -4,6 +4,7 @@
 #include "nlohmann/json.hpp"
 
 #include "utilities/JsonHelper.hpp"
+#include "TAHeaders/TAGraph.hpp"
 
 using json = nlohmann::json;
 
@@ -11,8 +12,8 @@ using json = nlohmann::json;
 class TATileRenamer {
 
 private:
-    // An integer that will be used to keep identifiers unique.
-    static int taNonce;
+    // An integer that will be used to keep identifiers unique, separately for each thread composing TAs.
+    static thread_local int taNonce;
 
 
     /**
@@ -106,6 +107,19 @@ public:
     }
 
 
+    /**
+     * Method used to rename all the id occurrences inside a single tile's graph representation
+     * in order to avoid name conflicts when merging states into one single tile.
+     * The ids are not rewritten: the tile becomes instance 'taNonce', and the suffix is added only when it is emitted.
+     * @param tile the graph representation of the tile which ids have to be renamed.
+     */
+    static void renameIDs(TAGraph &tile)
+    {
+        tile.setInstance(static_cast<uint32_t>(taNonce));
+        taNonce++;
+    }
+
+
     /**
      * Method used to reset the 'taNonce' attribute to 0.
      */
@@ -117,7 +131,7 @@ public:
 };
 
 // Defining static attribute taNonce.
-int TATileRenamer::taNonce { 0 };
+thread_local int TATileRenamer::taNonce { 0 };
 
 
 #endif //UTOTPARSER_TATILERENAMER_H
@@ -0,0 +1,102 @@
+#ifndef UTOTPARSER_TILELIBRARY_H
+#define UTOTPARSER_TILELIBRARY_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "nlohmann/json.hpp"
+
+#include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TAGraph.hpp"
+#include "TAHeaders/TASnapshot.hpp"
+
+using json = nlohmann::json;
+
+
+class TileLibrary {
+
+private:
+    // The tiles loaded so far, indexed by the path to their .xml file, already normalized.
+    // They are immutable and shared, since the graphs built from them keep referring to their elements.
+    static std::unordered_map<std::string, std::shared_ptr<const json>> tiles;
+
+    // The graphs built from the tiles, indexed as the tiles. Their records are shared by all the instances of the tiles.
+    static std::unordered_map<std::string, TAGraph> prototypes;
+
+    // The lock guarding the maps, since the library is shared by all the threads composing TAs.
+    // The tiles and the prototypes are never changed once added, hence they can be used without holding the lock.
+    static std::mutex mutex;
+
+
+    /**
+     * Method used to get the json representation of a tile, loading it if needed. The lock must be held by the caller.
+     */
+    static const std::shared_ptr<const json> &loadTile(const std::string &tilePath)
+    {
+        auto found = tiles.find(tilePath);
+        if (found != tiles.end())
+            return found->second;
+
+        json tile = TASnapshot::loadTA(tilePath);
+        TAContentExtractor::normalizeTA(tile);
+        return tiles.emplace(tilePath, std::make_shared<const json>(std::move(tile))).first->second;
+    }
+
+
+public:
+    /**
+     * Method used to get the json representation of a tile.
+     * Each tile is read from disk (or from its snapshot) only the first time it is requested: since the same tiles are
+     * used many times in a compositional string, and in all the TAs generated during the same run, every following
+     * request is answered from memory.
+     * @param tilePath the path to the .xml file of the tile.
+     * @return a shared pointer to the normalized json representation of the tile.
+     */
+    static const std::shared_ptr<const json> &getTile(const std::string &tilePath)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return loadTile(tilePath);
+    }
+
+
+    /**
+     * Method used to get the prototype graph of a tile, from which all the instances of the tile are obtained.
+     * The graph is built only the first time it is requested, then its records are shared by every instance.
+     * @param tilePath the path to the .xml file of the tile.
+     * @return a reference to the prototype graph of the tile.
+     */
+    static const TAGraph &getPrototype(const std::string &tilePath)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto found = prototypes.find(tilePath);
+        if (found != prototypes.end())
+            return found->second;
+
+        return prototypes.emplace(tilePath, TAGraph::fromJson(loadTile(tilePath))).first->second;
+    }
+
+
+    /**
+     * Method used to forget all the loaded tiles, so that they will be read again from disk when requested.
+     * It must not be called while other threads are composing TAs.
+     */
+    static void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        prototypes.clear();
+        tiles.clear();
+    }
+
+};
+
+
+std::unordered_map<std::string, std::shared_ptr<const json>> TileLibrary::tiles {};
+
+std::unordered_map<std::string, TAGraph> TileLibrary::prototypes {};
+
+std::mutex TileLibrary::mutex {};
+
+
+#endif //UTOTPARSER_TILELIBRARY_H
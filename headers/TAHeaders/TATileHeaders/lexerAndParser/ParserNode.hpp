@@ -4,16 +4,32 @@
 #include <stack>
 #include "nlohmann/json.hpp"
 
+#include "TAHeaders/TAGraph.hpp"
+
 using json = nlohmann::json;
 
 
+/**
+ * A stack whose content can also be read without popping it, which allows to print a ParserNode without copying its tiles.
+ */
+template<typename T>
+struct ParserStack : public std::stack<T> {
+
+    [[nodiscard]] const typename std::stack<T>::container_type &getContent() const
+    {
+        return this->c;
+    }
+
+};
+
+
 struct ParserNode {
 
     friend std::ostream &operator<<(std::ostream &strm, const ParserNode &pn);
 
     int nestingLevel {};
-    std::stack<json> tileStack {};
-    std::stack<std::string> operatorStack {};
+    ParserStack<TAGraph> tileStack {};
+    ParserStack<std::string> operatorStack {};
 
 
     ParserNode() = default;
@@ -22,31 +38,40 @@ struct ParserNode {
     explicit ParserNode(int nestingLevel) : nestingLevel(nestingLevel)
     {};
 
+
+    // Nodes own the tiles on their stack, hence they can only be moved.
+    ParserNode(const ParserNode &) = delete;
+
+
+    ParserNode &operator=(const ParserNode &) = delete;
+
+
+    ParserNode(ParserNode &&) = default;
+
+
+    ParserNode &operator=(ParserNode &&) = default;
+
 };
 
 
 std::ostream &operator<<(std::ostream &strm, const ParserNode &pn)
 {
-    ParserNode pnCopy = pn;
-    strm << "nestingLevel: " << pnCopy.nestingLevel
-         << ", tileStackSize: " << pnCopy.tileStack.size()
-         << ", operatorStackSize: " << pnCopy.operatorStack.size();
+    strm << "nestingLevel: " << pn.nestingLevel
+         << ", tileStackSize: " << pn.tileStack.size()
+         << ", operatorStackSize: " << pn.operatorStack.size();
 
+    // Both stacks are printed starting from their top.
     strm << "\nOperator stack:\n";
 
-    while (!pnCopy.operatorStack.empty())
-    {
-        strm << "\n" << pnCopy.operatorStack.top() << "\n";
-        pnCopy.operatorStack.pop();
-    }
+    const auto &operators = pn.operatorStack.getContent();
+    for (auto op = operators.rbegin(); op != operators.rend(); ++op)
+        strm << "\n" << *op << "\n";
 
     strm << "\nTile stack:\n";
 
-    while (!pnCopy.tileStack.empty())
-    {
-        strm << "\n" << std::setw(4) << pnCopy.tileStack.top() << "\n";
-        pnCopy.tileStack.pop();
-    }
+    const auto &tiles = pn.tileStack.getContent();
+    for (auto tile = tiles.rbegin(); tile != tiles.rend(); ++tile)
+        strm << "\n" << std::setw(4) << tile->toJson() << "\n";
 
     return strm;
 }
@@ -1,8 +1,17 @@
 #ifndef UTOTPARSER_TATILEINPUTLEXER_H
 #define UTOTPARSER_TATILEINPUTLEXER_H
 
+#include <cctype>
+#include <climits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Exceptions.h"
 #include "utilities/Utils.hpp"
 #include "utilities/StringsGetter.hpp"
+#include "TAHeaders/TASnapshot.hpp"
+#include "TAHeaders/TATileHeaders/lexerAndParser/TileExpression.hpp"
+#include "TAHeaders/TATileHeaders/tileEnums/TileTokensEnum.h"
 #include "TAHeaders/TATileHeaders/tileEnums/TileTypeEnum.h"
 
 // Context-free grammar describing our compositional language:
@@ -17,7 +26,8 @@
 // 1) Add the new tokens in the enum in TileTokens.h.
 // 2) Update accordingly the fromStrTileTokenEnum method in TileTokens.h.
 // 3) Add the tokens and their respective symbol in the operatorTokens vector in TATileInputLexer.hpp.
-// 4) Add the corresponding actions creating a new Action in the parserActionFactory folder or modify existing ones.
+// 4) If the token is a new operator, update accordingly the parseExpression method in TATileInputParser.hpp.
+// 5) Add the corresponding actions creating a new Action in the parserActionFactory folder or modify existing ones.
 
 class TATileInputLexer {
 
@@ -27,6 +37,10 @@ private:
     // A vector comprising both operator and tile tokens.
     std::vector<std::pair<std::string, std::string>> tokens {};
 
+    // The tokens corresponding to each symbol, used to tokenize a string in a single pass.
+    // Tokens are also indexed by their own name, hence they can be written directly in the compositional string.
+    std::unordered_map<std::string, TileToken> symbolTable {};
+
     // A vector of pairs defining in the second element the actual symbol appearing in the
     // compositional tile string, while in the first element the token corresponding to that symbol.
     std::vector<std::pair<std::string, std::string>> operatorTokens
@@ -54,7 +68,10 @@ private:
     // Vector representing randomly-generated tiles.
     std::vector<std::pair<std::string, std::string>> rngTileTokens
             {
-                    { "t_barabasi_albert", "t:BA" } // Random-generated tile.
+                    { "t_barabasi_albert", "t:BA" },  // Random-generated tile (Barabasi-Albert network).
+                    { "t_erdos_renyi",     "t:ER" },  // Random-generated tile (Erdos-Renyi network).
+                    { "t_watts_strogatz",  "t:WS" },  // Random-generated tile (Watts-Strogatz small-world network).
+                    { "t_layered_dag",     "t:DAG" }  // Random-generated tile (layered DAG with back links).
             };
 
     // Vector representing acceptance tiles.
@@ -79,9 +96,16 @@ private:
      */
     static int emplaceTile(int startId, const std::string &directoryPath, std::vector<std::pair<std::string, std::string>> &tileTokens)
     {
+        // The snapshots of the tiles that have been removed from the directory are removed too.
+        TASnapshot::removeOrphanSnapshots(directoryPath);
+
         int tileId = startId;
         for (const auto &entry: getEntriesInAlphabeticalOrder(directoryPath))
         {
+            // Only .xml files are tiles, other files (e.g., their snapshots) must not be given a symbol.
+            if (entry.path().extension() != ".xml")
+                continue;
+
             std::string tileName = getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0);
             tileTokens.emplace_back(tileName, "t" + std::to_string(tileId));
             tileId++;
@@ -143,32 +167,88 @@ private:
 
 
     /**
-     * Method used to get a tokenized representation of the given string.
+     * Method used to get the token starting at a given position of the string, looking for the longest symbol.
+     * Words (tiles' symbols, e.g., 't12' or 't:BA') are read entirely, so that a symbol is never matched as a prefix of a longer word.
      * @param str the string to tokenize.
-     * @return a tokenized version of the string.
+     * @param pos the position of the first character of the token, moved past the token.
+     * @return the entry of the symbol table corresponding to the token, nullptr if no symbol starts at that position.
      */
-    std::string tokenizeString(std::string &str)
+    const std::pair<const std::string, TileToken> *scanSymbol(const std::string &str, size_t &pos) const
     {
-        // Sort the 'tokens' vector based on the length of the second element. This ensures correctness while tokenizing the string.
-        std::sort(tokens.begin(), tokens.end(), sortPairBySecondElementLength);
+        auto isWordChar = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == ':'; };
 
-        // For each token, check all its occurrences inside the string and convert it.
-        for (auto &token: tokens)
+        size_t length = 0;
+        if (isWordChar(str[pos]))
+        {
+            while (pos + length < str.length() && isWordChar(str[pos + length]))
+                ++length;
+        } else
         {
-            // First, find the position of the token in the string.
-            size_t pos = str.find(token.second);
+            // Operators and parentheses are at most two characters long (e.g., '++' and '+1').
+            length = std::min<size_t>(2, str.length() - pos);
+            while (length > 0 && symbolTable.find(str.substr(pos, length)) == symbolTable.end())
+                --length;
+        }
 
-            // Then, replace all occurrences of the token in the string.
-            while (pos != std::string::npos)
-            {
-                // Replace token with its corresponding key.
-                str.replace(pos, token.second.length(), token.first);
+        auto found = (length > 0) ? symbolTable.find(str.substr(pos, length)) : symbolTable.end();
+        if (found == symbolTable.end())
+            return nullptr;
+
+        pos += length;
+        return &*found;
+    }
+
+
+    /**
+     * Method used to get a tokenized representation of the given string, scanning it once from left to right.
+     * @param str the string to tokenize.
+     * @param tokenizedString the string in which to write a readable version of the tokens, where each symbol is
+     *                        replaced by its token and whitespaces are kept.
+     * @return the tokens of the string, terminated by an 'end_of_input' token.
+     */
+    std::vector<TileToken> tokenizeString(const std::string &str, std::string &tokenizedString) const
+    {
+        std::vector<TileToken> result {};
+        tokenizedString.clear();
 
-                // Find the next occurrence of the token.
-                pos = str.find(token.second, pos + token.first.length());
+        size_t pos = 0;
+        while (pos < str.length())
+        {
+            size_t start = pos;
+
+            if (std::isspace(static_cast<unsigned char>(str[pos])))
+            {
+                tokenizedString.push_back(str[pos]);
+                ++pos;
+            } else if (std::isdigit(static_cast<unsigned char>(str[pos])))
+            {
+                // Integers are only used as syntax parameters, e.g., t:BA[5].
+                int value = 0;
+                while (pos < str.length() && std::isdigit(static_cast<unsigned char>(str[pos])))
+                {
+                    int digit = str[pos] - '0';
+                    if (value > (INT_MAX - digit) / 10)
+                        throw TileSyntaxException("Exception: integer too large at position " + std::to_string(start) + " of the compositional string");
+                    value = value * 10 + digit;
+                    ++pos;
+                }
+                result.push_back({ integer_literal, nullptr, value, start });
+                tokenizedString.append(str, start, pos - start);
+            } else
+            {
+                const auto *symbol = scanSymbol(str, pos);
+                if (symbol == nullptr)
+                    throw TileSyntaxException("Exception: unknown symbol at position " + std::to_string(start) + " of the compositional string");
+
+                TileToken token = symbol->second;
+                token.position = start;
+                result.push_back(token);
+                tokenizedString.append(*token.token);
             }
         }
-        return str;
+
+        result.push_back({ end_of_input, nullptr, 0, str.length() });
+        return result;
     }
 
 
@@ -181,6 +261,13 @@ public:
         tokens.insert(tokens.end(), binTileTokens.begin(), binTileTokens.end());
         tokens.insert(tokens.end(), triTileTokens.begin(), triTileTokens.end());
         tokens.insert(tokens.end(), rngTileTokens.begin(), rngTileTokens.end());
+
+        for (const auto &token: tokens)
+        {
+            TileToken tileToken { fromStrTileTokenEnum(token.first), &token.first, 0, 0 };
+            symbolTable.emplace(token.first, tileToken);
+            symbolTable.emplace(token.second, tileToken);
+        }
     };
 
 
@@ -198,8 +285,11 @@ public:
 
     /**
      * Method used to get, from the user, a string representing the way in which tiles will be merged together.
+     * @param showHelp true if the available tiles and operators have to be displayed first.
+     * @param tokenizedString the string in which to write a readable version of the tokens.
+     * @return the tokens of the string given by the user.
      */
-    std::string getTokenizedCompositionalString(bool showHelp)
+    std::vector<TileToken> getTokenizedCompositionalString(bool showHelp, std::string &tokenizedString)
     {
         if (showHelp)
             showHelpMessage();
@@ -222,24 +312,22 @@ public:
             std::cin.ignore();
         }
 
-        std::string tokenizedString { tokenizeString(userInput) };
-        std::cout << "The tokenized string is: " << tokenizedString << std::endl;
-
-        return tokenizedString;
+        return getTokenizedCompositionalString(userInput, tokenizedString);
     }
 
 
     /**
      * Method used to get a tokenized version of a given string.
      * @param str the string to tokenize.
-     * @return a tokenized version of the 'str' parameter.
+     * @param tokenizedString the string in which to write a readable version of the tokens.
+     * @return the tokens of the 'str' parameter.
      */
-    std::string getTokenizedCompositionalString(std::string &str)
+    std::vector<TileToken> getTokenizedCompositionalString(const std::string &str, std::string &tokenizedString) const
     {
-        std::string tokenizedString { tokenizeString(str) };
+        std::vector<TileToken> result { tokenizeString(str, tokenizedString) };
         std::cout << "The tokenized string is: " << tokenizedString << std::endl;
 
-        return tokenizedString;
+        return result;
     }
 
 
@@ -269,6 +357,22 @@ public:
     }
 
 
+    /**
+     * Methods used to get the tokens of the parentheses, which are needed to open and close nesting levels.
+     * The returned references stay valid as long as the lexer exists.
+     */
+    [[nodiscard]] const std::string &getLParenToken() const
+    {
+        return operatorTokens[0].first;
+    }
+
+
+    [[nodiscard]] const std::string &getRParenToken() const
+    {
+        return operatorTokens[1].first;
+    }
+
+
     /**
      * Method used to get only the tokens associated with randomly-generated tiles.
      * The return is made by value, since otherwise the returned vector may be deallocated before being utilized.
@@ -370,6 +474,30 @@ public:
         return result;
     }
 
+
+    /**
+     * Method used to get the binary and ternary tiles appearing in a compositional string.
+     * The string is tokenized, hence symbols are matched as whole words (e.g., 't1' is not found in 't10').
+     * @param str the compositional string.
+     * @return the tokens of the binary tiles appearing in 'str', followed by the ones of the ternary tiles.
+     */
+    std::vector<std::string> getUsedBinAndTriTiles(const std::string &str) const
+    {
+        std::string tokenizedString {};
+        std::unordered_set<std::string> usedTokens {};
+        for (const auto &token: tokenizeString(str, tokenizedString))
+            if (token.token != nullptr)
+                usedTokens.insert(*token.token);
+
+        std::vector<std::string> result {};
+        for (const auto *tileTokens: { &binTileTokens, &triTileTokens })
+            for (const auto &tile: *tileTokens)
+                if (usedTokens.count(tile.first) > 0)
+                    result.push_back(tile.first);
+
+        return result;
+    }
+
 };
 
 
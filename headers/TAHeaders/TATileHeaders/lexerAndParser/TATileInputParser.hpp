@@ -1,6 +1,7 @@
 #ifndef UTOTPARSER_TATILEINPUTPARSER_H
 #define UTOTPARSER_TATILEINPUTPARSER_H
 
+#include <memory>
 #include <stack>
 #include "nlohmann/json.hpp"
 
@@ -8,10 +9,12 @@
 #include "DoublyLinkedList.hpp"
 #include "utilities/StringsGetter.hpp"
 #include "utilities/Utils.hpp"
+#include "TAHeaders/TATileHeaders/CompositionArena.hpp"
 #include "TAHeaders/TATileHeaders/TATileConstructor.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/Connector.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/ConnectorFactory.hpp"
 #include "TAHeaders/TATileHeaders/lexerAndParser/ParserNode.hpp"
+#include "TAHeaders/TATileHeaders/lexerAndParser/TileExpression.hpp"
 #include "TAHeaders/TATileHeaders/lexerAndParser/TATileInputLexer.hpp"
 #include "TAHeaders/TATileHeaders/TATileRenamer.hpp"
 #include "TAHeaders/TATileHeaders/parserActionFactory/Action.hpp"
@@ -22,14 +25,30 @@
 using json = nlohmann::json;
 
 
+// The parser is a recursive-descent parser for the grammar in TATileInputLexer.hpp, rewritten without left recursion:
+// ----------------------------------------------------------------------------------------------------------------
+// TiledTA -> Primary (Bin TiledTA | Tri TiledTA TiledTA)?
+// Primary -> Tile | '(' TiledTA ')'
+// Operators are hence right-associative (t1 + t2 + t3 is t1 + (t2 + t3)), which is the order in which they have always
+// been applied. Parsing builds an expression tree, which is then evaluated in a separate step.
+
 class TATileInputParser {
 
 private:
     StringsGetter &stringsGetter;
 
-    // A string containing the user input describing how to merge the tiles.
+    // A string containing the tokenized user input describing how to merge the tiles.
     std::string compositionalTileString {};
 
+    // The tokens of the compositional string, terminated by an 'end_of_input' token.
+    std::vector<TileToken> tokens {};
+
+    // The position of the next token to parse.
+    size_t cursor {};
+
+    // The expression tree of the compositional string.
+    TileExpressionTree expressionTree {};
+
     // A doubly linked list that will be used to build stacks in order to keep track of the tiles and operators.
     DoublyLinkedList<ParserNode> parserList {};
 
@@ -38,169 +57,207 @@ private:
 
 
     /**
-     * Method used to delete the first 'trimLength' characters from the given string.
-     * @param str the string in which to delete the first 'trimLength' characters.
-     * @param trimLength the number of characters to delete from the string starting from the first character.
+     * Method used to throw an exception describing a syntax error at the current token.
+     * @param expected a description of what was expected instead of the current token.
      */
-    static void trimStringFromStart(std::string &str, int trimLength)
+    [[noreturn]] void syntaxError(const std::string &expected) const
     {
-        str = str.substr(trimLength);
+        throw TileSyntaxException("Exception: expected " + expected + " at position " +
+                                  std::to_string(tokens[cursor].position) + " of the compositional string");
     }
 
 
-    /**
-     * Method used to skip whitespaces while parsing a string starting from the initial character of the string.
-     * The procedure is stopped when encountering the first non-whitespace character.
-     * The string is then trimmed starting from the first character by an amount of characters equal to the number
-     * of whitespace characters encountered.
-     * @param tokenizedStringToParse the string in which to ignore whitespace characters.
-     */
-    static void skipWhitespaces(std::string &tokenizedStringToParse)
+    static bool isOperator(TileTokensEnum kind)
     {
-        int cursor = 0;
-        while (cursor < tokenizedStringToParse.length() && std::isspace(tokenizedStringToParse[cursor]))
-            ++cursor;
-        trimStringFromStart(tokenizedStringToParse, cursor);
+        return kind == only_one_out || kind == match_inout_size || kind == tree_op;
     }
 
 
     /**
-     * Method used to check if the next symbol is the one specified in the argument.
-     * If this is the case, consume such symbol, moving forward inside the string to
-     * parse by an amount of characters equal to the symbol's length.
-     * @param tokenizedStringToParse the string in which to check if 'symbol' is present.
-     * @param symbol string that must be found (or not) inside the given string to parse.
-     * @return true if the specified symbol is present, false otherwise.
+     * Method used to parse a tile or a parenthesized expression.
+     * @return the position of the corresponding node inside the expression tree.
      */
-    static bool expectSymbol(std::string &tokenizedStringToParse, const std::string &symbol)
+    uint32_t parsePrimary()
     {
-        skipWhitespaces(tokenizedStringToParse);
+        const TileToken &token = tokens[cursor];
 
-        // Checking if the expected symbol is present.
-        if (tokenizedStringToParse.find(symbol) == 0)
+        if (token.kind == lparen)
         {
-            // If the symbol is found, move forward inside the string to parse.
-            trimStringFromStart(tokenizedStringToParse, static_cast<int>(symbol.length()));
-            return true;
+            ++cursor;
+            uint32_t content = parseExpression();
+            if (tokens[cursor].kind != rparen)
+                syntaxError("')'");
+            ++cursor;
+            return expressionTree.addNode({ lparen, token.token, false, 0, { content, TILE_EXPRESSION_NONE, TILE_EXPRESSION_NONE }});
         }
-        return false;
+
+        if (token.kind != maybe_tile && !isRandomTileToken(token.kind))
+            syntaxError("a tile or '('");
+        ++cursor;
+
+        TileExpressionNode tile { token.kind, token.token, false, 0, { TILE_EXPRESSION_NONE, TILE_EXPRESSION_NONE, TILE_EXPRESSION_NONE }};
+
+        // Looking for a syntax parameter, i.e., an optional integer enclosed in square brackets.
+        if (tokens[cursor].kind == lsqparen)
+        {
+            ++cursor;
+            tile.hasSyntaxParameter = true;
+            if (tokens[cursor].kind == integer_literal)
+                tile.syntaxParameter = tokens[cursor++].value;
+            if (tokens[cursor].kind != rsqparen)
+                syntaxError("']'");
+            ++cursor;
+        }
+        return expressionTree.addNode(tile);
     }
 
 
     /**
-     * Method used to read a sequence of digits inside a string and return it as a decimal number.
-     * The digits are read until a non-digit character is found.
-     * @param tokenizedStringToParse the string in which to read the number.
-     * @return a decimal representation of the read number.
+     * Method used to parse an expression, i.e., a primary optionally followed by an operator and its other operands.
+     * Chains of operators are parsed with a loop and then folded from the right, hence their length does not affect the recursion depth.
+     * @return the position of the corresponding node inside the expression tree.
      */
-    static int readIntegerFromString(std::string &tokenizedStringToParse)
+    uint32_t parseExpression()
     {
-        int res = 0;
-        int cursor = 0;
+        // Each element holds the left operand and the operator, together with the middle operand of ternary operators.
+        std::vector<std::pair<TileExpressionNode, uint32_t>> pendingOperators {};
+
+        uint32_t operand = parsePrimary();
+        while (isOperator(tokens[cursor].kind))
+        {
+            const TileToken &op = tokens[cursor++];
+            TileExpressionNode node { op.kind, op.token, false, 0, { operand, TILE_EXPRESSION_NONE, TILE_EXPRESSION_NONE }};
+
+            // Ternary operators take an additional operand, which is a whole expression as well.
+            if (op.kind == tree_op)
+                node.operands[1] = parseExpression();
 
-        skipWhitespaces(tokenizedStringToParse);
+            pendingOperators.emplace_back(node, 0);
+            operand = parsePrimary();
+        }
 
-        // Reading digits until a non-digit character is encountered.
-        while (cursor < tokenizedStringToParse.length() && std::isdigit(tokenizedStringToParse[cursor]))
+        // The last operand parsed is the right operand of the last operator, whose node is the right operand of the previous one, and so on.
+        for (auto it = pendingOperators.rbegin(); it != pendingOperators.rend(); ++it)
         {
-            res = res * 10 + (tokenizedStringToParse[cursor] - '0');
-            ++cursor;
+            TileExpressionNode &node = it->first;
+            node.operands[(node.kind == tree_op) ? 2 : 1] = operand;
+            operand = expressionTree.addNode(node);
         }
+        return operand;
+    }
 
-        // Moving forward inside the string to parse by an amount of characters equals to the ones read by the while loop.
-        trimStringFromStart(tokenizedStringToParse, cursor);
 
-        return res;
+    /**
+     * Method used to parse the whole compositional string.
+     */
+    void parseTokens()
+    {
+        expressionTree = {};
+        cursor = 0;
+
+        expressionTree.root = parseExpression();
+        if (tokens[cursor].kind != end_of_input)
+            syntaxError("an operator or the end of the string");
     }
 
 
     /**
-     * Method used to look for a syntax parameter inside the string to parse.
-     * The presence of a syntax parameter is denoted by a '[' character.
-     * Remember that, in order to be syntactically correct, a ']' must then be found to match the opening one.
-     * @param tokenizedStringToParse the string in which to look for a syntax parameter.
-     * @param parameterValue the numeric value of the found parameter.
-     * @return true if a parameter has been found, false otherwise.
+     * Method used to perform an action based on a token.
+     * @param actionFactory the factory creating the actions.
+     * @param token the token that will determine the action to execute.
+     * @param syntaxParameter the syntax parameter given to the token, if any.
      */
-    static bool lookForSyntaxParameter(std::string &tokenizedStringToParse, int &parameterValue)
+    void performAction(ActionFactory &actionFactory, const std::string &token, int syntaxParameter)
     {
-        // If a left square bracket has been found, consume it and read the parameter value (if present).
-        if (expectSymbol(tokenizedStringToParse, "lsqparen"))
-        {
-            // Obtaining the parameter value.
-            parameterValue = readIntegerFromString(tokenizedStringToParse);
+        Action *action = actionFactory.createAction(parserList, token, syntaxParameter);
+        action->performAction();
+    }
 
-            // Expecting the corresponding right square bracket.
-            expectSymbol(tokenizedStringToParse, "rsqparen");
 
-            return true;
+    /**
+     * Method used to evaluate a tile or a parenthesized expression.
+     * @param actionFactory the factory creating the actions.
+     * @param position the position of the node inside the expression tree.
+     */
+    void evaluatePrimary(ActionFactory &actionFactory, uint32_t position)
+    {
+        const TileExpressionNode &node = expressionTree.at(position);
+
+        if (node.kind == lparen)
+        {
+            evaluateGroup(actionFactory, node.operands[0]);
+            return;
         }
 
-        // Assigning a dummy value to the not found parameter.
-        parameterValue = 0;
-        return false;
+        if (node.hasSyntaxParameter)
+            std::cout << "Found syntax parameter with value: " << node.syntaxParameter << '\n';
+        performAction(actionFactory, *node.token, node.syntaxParameter);
     }
 
 
     /**
-     * Method used to perform an action based on the current token being parsed.
-     * @param token the token that will determine the action to execute.
+     * Method used to evaluate an expression at a new nesting level, i.e., as if it were enclosed in parentheses.
+     * @param actionFactory the factory creating the actions.
+     * @param position the position of the node inside the expression tree.
      */
-    void performAction(const std::string &token, int syntaxParameter)
+    void evaluateGroup(ActionFactory &actionFactory, uint32_t position)
     {
-        // The content of this vector is the following:
-        // 1) The type of the tile.
-        // 2) A vector of pairs containing:
-        //    1) The token of the tile.
-        //    2) The symbol representing the tile used in the compositional string.
-        std::vector<std::pair<TileTypeEnum, std::vector<std::pair<std::string, std::string>>>> availableTiles = taTileInputLexer.getTileTokens();
-
-        ParserActionFactory *actionFactory = new ActionFactory(stringsGetter, availableTiles);
-        Action *action = actionFactory->createAction(parserList, token, syntaxParameter);
-        action->performAction();
+        performAction(actionFactory, taTileInputLexer.getLParenToken(), 0);
+        evaluate(actionFactory, position);
+        performAction(actionFactory, taTileInputLexer.getRParenToken(), 0);
     }
 
 
     /**
-     * Method used to parse the tokenized string and execute actions accordingly, based on the current symbol encountered.
+     * Method used to evaluate an expression.
+     * Tiles and operators of a nesting level are pushed on the stacks of the parserList in the order they appear in the
+     * string, and operators are applied when the nesting level is closed, starting from the last one, i.e., from the
+     * innermost node of the tree. In this way, bounds are computed exactly as the tiles are encountered.
+     * @param actionFactory the factory creating the actions.
+     * @param position the position of the node inside the expression tree.
      */
-    void parseAndPerformActions()
+    void evaluate(ActionFactory &actionFactory, uint32_t position)
     {
-        // The vector containing pairs { token, token symbol }.
-        std::vector<std::pair<std::string, std::string>> tokens { taTileInputLexer.getTokens() };
+        while (isOperator(expressionTree.at(position).kind))
+        {
+            const TileExpressionNode &node = expressionTree.at(position);
 
-        // This is the tokenized string to parse in order to detect tokens.
-        std::string tokenizedStringToParse { compositionalTileString };
+            evaluatePrimary(actionFactory, node.operands[0]);
+            performAction(actionFactory, *node.token, 0);
 
-        // Iterate through the entire string, until tokenizedStringToParse is completely parsed.
-        while (!tokenizedStringToParse.empty())
-        {
-            // Check substrings from the current position inside tokenizedStringToParse.
-            for (const auto &token: tokens)
+            if (node.kind == tree_op)
             {
-                skipWhitespaces(tokenizedStringToParse);
-
-                // This if-clause checks if, starting from the current position of tokenizedStringToParse, a token matches.
-                if (tokenizedStringToParse.find(token.first) == 0)
-                {
-                    // Updating tokenizedStringToParse with the remaining portion to parse.
-                    tokenizedStringToParse = tokenizedStringToParse.substr(token.first.length());
+                // A middle operand made of several tiles must be composed before the operator is applied.
+                if (isOperator(expressionTree.at(node.operands[1]).kind))
+                    evaluateGroup(actionFactory, node.operands[1]);
+                else
+                    evaluatePrimary(actionFactory, node.operands[1]);
+                position = node.operands[2];
+            } else
+                position = node.operands[1];
+        }
+        evaluatePrimary(actionFactory, position);
+    }
 
-                    int syntaxParameter {};
-                    bool syntaxParameterFound = lookForSyntaxParameter(tokenizedStringToParse, syntaxParameter);
 
-                    if (syntaxParameterFound)
-                        std::cout << "Found syntax parameter with value: " << syntaxParameter << '\n';
+    /**
+     * Method used to evaluate the expression tree, composing the tiles accordingly.
+     */
+    void evaluateExpressionTree()
+    {
+        // The content of this vector is the following:
+        // 1) The type of the tile.
+        // 2) A vector of pairs containing:
+        //    1) The token of the tile.
+        //    2) The symbol representing the tile used in the compositional string.
+        std::vector<std::pair<TileTypeEnum, std::vector<std::pair<std::string, std::string>>>> availableTiles = taTileInputLexer.getTileTokens();
+        ActionFactory actionFactory(stringsGetter, availableTiles);
 
-                    performAction(token.first, syntaxParameter);
-                    break;
-                }
-            }
-        }
+        evaluate(actionFactory, expressionTree.root);
 
-        // At the end of the parsing, we have to force the current node to be consumed, since it may
+        // At the end of the evaluation, we have to force the current node to be consumed, since it may
         // not be ended by a right parenthesis. This is just like inserting a dummy ')' symbol at the end of the parsed string.
-        ActionRParen action = ActionRParen(stringsGetter, parserList, "rparen");
+        ActionRParen action = ActionRParen(stringsGetter, parserList, taTileInputLexer.getRParenToken());
         action.performAction();
     }
 
@@ -212,21 +269,27 @@ public:
 
     TATileInputParser(StringsGetter &stringsGetter, bool showHelp) : stringsGetter(stringsGetter), taTileInputLexer(stringsGetter)
     {
-        parserList.insertFirst(ParserNode());
-        compositionalTileString = taTileInputLexer.getTokenizedCompositionalString(showHelp);
+        tokens = taTileInputLexer.getTokenizedCompositionalString(showHelp, compositionalTileString);
     };
 
 
     /**
      * Method used to merge together the given tiles and obtain a Tiled TA.
-     * @return a json representation of a Tiled TA obtained by combining the given tiles and operators.
+     * @return a graph representation of a Tiled TA obtained by combining the given tiles and operators.
      */
-    json getTiledTA()
+    TAGraph getTiledTA()
     {
         std::cout << "Compositional string: " << compositionalTileString << std::endl;
-        parseAndPerformActions();
+        parseTokens();
 
-        return parserList.getHead()->content.tileStack.top();
+        parserList = {};
+        parserList.insertFirst(ParserNode());
+        evaluateExpressionTree();
+
+        // The actions, operators, connectors and random creators used to compose the TA are not needed anymore.
+        CompositionArena::reset();
+
+        return std::move(parserList.getHead()->content.tileStack.top());
     }
 
 
@@ -234,12 +297,11 @@ public:
      * Method used to merge together the given tiles and obtain a Tiled TA, contained in the given 'str' parameter.
      * Useful when creating the parser using the constructor accepting only the 'stringsGetter' parameter.
      * @param str the string describing the structure of the TA.
-     * @return a json representation of a Tiled TA obtained by combining the given tiles and operators.
+     * @return a graph representation of a Tiled TA obtained by combining the given tiles and operators.
      */
-    json getTiledTA(std::string &str)
+    TAGraph getTiledTA(const std::string &str)
     {
-        parserList.insertFirst(ParserNode());
-        compositionalTileString = taTileInputLexer.getTokenizedCompositionalString(str);
+        tokens = taTileInputLexer.getTokenizedCompositionalString(str, compositionalTileString);
         return getTiledTA();
     }
 
@@ -279,6 +341,12 @@ public:
         return taTileInputLexer.getTriTileSymbols();
     }
 
+
+    std::vector<std::string> getUsedBinAndTriTiles(const std::string &str) const
+    {
+        return taTileInputLexer.getUsedBinAndTriTiles(str);
+    }
+
 };
 
 
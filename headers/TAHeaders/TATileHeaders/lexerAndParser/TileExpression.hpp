@@ -0,0 +1,71 @@
+#ifndef UTOTPARSER_TILEEXPRESSION_H
+#define UTOTPARSER_TILEEXPRESSION_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "TAHeaders/TATileHeaders/tileEnums/TileTokensEnum.h"
+
+
+// The index used to represent the absence of an operand.
+#define TILE_EXPRESSION_NONE UINT32_MAX
+
+
+/**
+ * Struct representing a token of the compositional string, as produced by the lexer.
+ */
+typedef struct tt {
+    TileTokensEnum kind;
+    // The name of the token (e.g., 'lparen' or the name of a tile), owned by the lexer; nullptr for integers and for the end of the input.
+    const std::string *token;
+    // The value of the token if it is an integer.
+    int value;
+    // The position of the token inside the compositional string, used when reporting syntax errors.
+    size_t position;
+} TileToken;
+
+
+/**
+ * Struct representing a node of the expression tree of a compositional string.
+ * A node is either a tile, a parenthesized expression ('lparen' kind) or an operator applied to its operands.
+ */
+typedef struct ten {
+    TileTokensEnum kind;
+    // The name of the tile or of the operator, owned by the lexer.
+    const std::string *token;
+    // True if the tile has been given a syntax parameter (e.g., t:BA[5]), which value is stored in 'syntaxParameter'.
+    bool hasSyntaxParameter;
+    int syntaxParameter;
+    // The positions of the operands inside the tree, in the order they appear in the string (TILE_EXPRESSION_NONE if absent).
+    // A parenthesized expression has its content as the only operand.
+    std::array<uint32_t, 3> operands;
+} TileExpressionNode;
+
+
+/**
+ * Struct representing the expression tree of a compositional string.
+ * Nodes are stored in a single vector and refer to their operands through their positions, hence the tree is built and
+ * released without allocating each node separately, and without recursion even for very long chains of operators.
+ */
+typedef struct tet {
+    std::vector<TileExpressionNode> nodes {};
+    uint32_t root { TILE_EXPRESSION_NONE };
+
+
+    uint32_t addNode(const TileExpressionNode &node)
+    {
+        nodes.push_back(node);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+
+    [[nodiscard]] const TileExpressionNode &at(uint32_t position) const
+    {
+        return nodes[position];
+    }
+} TileExpressionTree;
+
+
+#endif //UTOTPARSER_TILEEXPRESSION_H
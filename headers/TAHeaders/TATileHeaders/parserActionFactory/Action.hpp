@@ -33,11 +33,11 @@ public:
         while (!(parserList.getHead()->content.operatorStack.empty()))
         {
             // Get the current operator and remove it from the top of the stack.
-            std::string currentOperator = parserList.getHead()->content.operatorStack.top();
+            std::string currentOperator = std::move(parserList.getHead()->content.operatorStack.top());
             parserList.getHead()->content.operatorStack.pop();
 
-            ParserOperatorFactory *operatorFactory = new OperatorFactory;
-            Operator *parserOperator = operatorFactory->createOperator(parserList, currentOperator);
+            OperatorFactory operatorFactory;
+            Operator *parserOperator = operatorFactory.createOperator(parserList, currentOperator);
             parserOperator->executeOperator();
         }
     }
@@ -1,6 +1,7 @@
 #ifndef UTOTPARSER_ACTIONFACTORY_H
 #define UTOTPARSER_ACTIONFACTORY_H
 
+#include "TAHeaders/TATileHeaders/CompositionArena.hpp"
 #include "TAHeaders/TATileHeaders/parserActionFactory/ActionPushOperator.hpp"
 #include "TAHeaders/TATileHeaders/parserActionFactory/ActionPushTile.hpp"
 #include "TAHeaders/TATileHeaders/parserActionFactory/ParserActionFactory.hpp"
@@ -86,22 +87,25 @@ public:
             case only_one_out:
             case match_inout_size:
             case tree_op:
-                return new ActionPushOperator(stringsGetter, parserList, token);
+                return CompositionArena::create<ActionPushOperator>(stringsGetter, parserList, token);
 
             case lparen:
-                return new ActionLParen(stringsGetter, parserList, token);
+                return CompositionArena::create<ActionLParen>(stringsGetter, parserList, token);
 
             case rparen:
-                return new ActionRParen(stringsGetter, parserList, token);
+                return CompositionArena::create<ActionRParen>(stringsGetter, parserList, token);
 
             case t_barabasi_albert:
-                return new ActionPushRandomTile(stringsGetter, parserList, token, syntaxParameter);
+            case t_erdos_renyi:
+            case t_watts_strogatz:
+            case t_layered_dag:
+                return CompositionArena::create<ActionPushRandomTile>(stringsGetter, parserList, token, syntaxParameter);
 
             case maybe_tile:
             {
                 std::pair<TileTypeEnum, bool> isTile { checkIfTileForType(token) };
                 if (isTile.second)
-                    return new ActionPushTile(stringsGetter, parserList, token, isTile.first);
+                    return CompositionArena::create<ActionPushTile>(stringsGetter, parserList, token, isTile.first);
             }
 
             default:
@@ -29,10 +29,10 @@ private:
      * outputs is read, if a multi 'out' location tile operator has still to be performed, the history
      * needs to be duplicated in order to use it in the other branch.
      */
-    void handleBounds(const json &tile)
+    void handleBounds(const TAGraph &tile)
     {
         // Updating the bounds for the current TA based on the tile just collected.
-        TABoundsCalculator::addBounds(TAContentExtractor::getDeclaration(tile));
+        TABoundsCalculator::addBounds(tile.getDeclaration());
 
         // The following if condition performs those checks:
         // 1) Check that at least one multi 'out' location tile will be done after consuming the current node.
@@ -66,17 +66,17 @@ public:
     {
         std::cout << "Now generating random tile\n";
 
-        TileRandomCreatorFactory *randomCreatorFactory = new RandomCreatorFactory();
-        RandomCreator *randomCreator = randomCreatorFactory->createRandomCreator(token, syntaxParameter);
-        json randomTile = randomCreator->createRandomTile();
+        RandomCreatorFactory randomCreatorFactory;
+        RandomCreator *randomCreator = randomCreatorFactory.createRandomCreator(token, syntaxParameter);
+        TAGraph tile = randomCreator->createRandomTile();
 
 #ifdef USE_BOUNDS
-        handleBounds(randomTile);
+        handleBounds(tile);
 #endif
 
         // Each tile has to be renamed in order to avoid name clashes.
-        TATileRenamer::renameIDs(randomTile);
-        parserList.getHead()->content.tileStack.push(randomTile);
+        TATileRenamer::renameIDs(tile);
+        parserList.getHead()->content.tileStack.push(std::move(tile));
     }
 
 };
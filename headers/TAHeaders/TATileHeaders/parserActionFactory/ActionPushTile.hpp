@@ -10,7 +10,8 @@
 #include "TAHeaders/TATileHeaders/parserActionFactory/Action.hpp"
 #include "TAHeaders/TATileHeaders/tileEnums/TileTypeEnum.h"
 #include "TAHeaders/TABoundsCalculator.hpp"
-#include "TAHeaders/TABoundsCalculator.hpp"
+#include "TAHeaders/TATileHeaders/TileLibrary.hpp"
+#include "TAHeaders/TAGraph.hpp"
 
 using json = nlohmann::json;
 
@@ -92,11 +93,11 @@ public:
 
 
     /**
-     * Method used to get a json representation of the tile which name is specified inside the 'token'
-     * attribute, getting it from the right directory based on the tile's type.
-     * @return a json representation of the tile whose name is represented by 'token'.
+     * Method used to get the path to the .xml file of the tile which name is specified inside the 'token'
+     * attribute, taking it from the right directory based on the tile's type.
+     * @return the path to the .xml file of the tile whose name is represented by 'token'.
      */
-    json getTile()
+    std::string getTilePath()
     {
         std::string tileDirPath {};
 
@@ -121,7 +122,7 @@ public:
                 break;
         }
 
-        return getJsonFromFileName(tileDirPath, token);
+        return tileDirPath + "/" += token + ".xml";
     }
 
 
@@ -131,17 +132,19 @@ public:
      */
     void performAction() override
     {
-        // USE json tile = getTile() AND NOT json tile { getTile() } SINCE THE LATTER IN GCC WILL BE
-        // CONSIDERED AN ARRAY, WHILE IN CLANG IT WILL BE CONSIDERED SIMPLY A JSON AS IT SHOULD BE.
-        json tile = getTile();
+        std::string tilePath = getTilePath();
 
 #ifdef USE_BOUNDS
-        handleBounds(tile, token);
+        handleBounds(*TileLibrary::getTile(tilePath), token);
 #endif
 
+        // The tile is an instance of its prototype kept by the TileLibrary, hence its file is read and its graph is
+        // built only the first time the tile is used, and all its instances share the same records.
+        TAGraph tile = TileLibrary::getPrototype(tilePath).instantiate();
+
         // Each tile has to be renamed in order to avoid name clashes.
         TATileRenamer::renameIDs(tile);
-        parserList.getHead()->content.tileStack.push(tile);
+        parserList.getHead()->content.tileStack.push(std::move(tile));
     }
 
 };
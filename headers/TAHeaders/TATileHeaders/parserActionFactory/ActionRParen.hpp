@@ -90,9 +90,9 @@ public:
 
         if (parserList.getHead()->content.nestingLevel > 0)
         {
-            json tileToTransfer = parserList.getHead()->content.tileStack.top();
+            TAGraph tileToTransfer = std::move(parserList.getHead()->content.tileStack.top());
             parserList.deleteFirst();
-            parserList.getHead()->content.tileStack.push(tileToTransfer);
+            parserList.getHead()->content.tileStack.push(std::move(tileToTransfer));
         }
     }
 
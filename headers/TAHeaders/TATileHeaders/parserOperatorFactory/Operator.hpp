@@ -5,7 +5,7 @@
 
 #include "DoublyLinkedList.hpp"
 #include "TAHeaders/TATileHeaders/lexerAndParser/ParserNode.hpp"
-#include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TAGraph.hpp"
 
 using json = nlohmann::json;
 
@@ -15,6 +15,29 @@ class Operator {
 protected:
     DoublyLinkedList<ParserNode> &parserList;
 
+    /**
+     * Method used to take the tile on top of the stack of the current node, transferring its ownership to the operator.
+     * @return the tile on top of the stack, which is removed from the stack.
+     */
+    TAGraph popTile()
+    {
+        std::stack<TAGraph> &tileStack = parserList.getHead()->content.tileStack;
+        TAGraph tile = std::move(tileStack.top());
+        tileStack.pop();
+        return tile;
+    }
+
+
+    /**
+     * Method used to push the result of the operator on top of the stack of the current node, transferring its ownership to the stack.
+     * @param tile the tile to push.
+     */
+    void pushTile(TAGraph &&tile)
+    {
+        parserList.getHead()->content.tileStack.push(std::move(tile));
+    }
+
+
 public:
     explicit Operator(DoublyLinkedList<ParserNode> &parserList) : parserList(parserList)
     {};
@@ -23,21 +46,13 @@ public:
     /**
      * Method used to delete all the in or out locations' names in order to avoid such unnecessary names for further connections.
      * This method deletes only the locations' name items, not the whole locations.
-     * @param inFile the json file in which to delete the desired locations' names.
-     * @param locationNames the name of the locations which name has to be deleted.
+     * @param inFile the tile in which to delete the desired locations' names.
+     * @param locations the positions of the locations which name has to be deleted.
      * @param locationText the text that must match with the one of the location in order to delete such location's name.
      */
-    static void deleteLocName(json &inFile, const std::vector<std::string> &locationNames, const std::string &locationText)
+    static void deleteLocName(TAGraph &inFile, const std::vector<uint32_t> &locations, const std::string &locationText)
     {
-        json *locations = TAContentExtractor::getLocationsPtr(inFile);
-
-        // For each location to delete, the 'inFile' locations are scanned and, if the if-condition match, the location's name is deleted.
-        for (const std::string &name: locationNames)
-            for (auto &loc: *locations)
-                if (loc.contains(NAME)
-                    && static_cast<std::string>(loc.at(ID)) == name
-                    && static_cast<std::string>(loc.at(NAME).at(TEXT)) == locationText)
-                    loc.erase(NAME);
+        inFile.deletePortNames(locations, locationText);
     }
 
 
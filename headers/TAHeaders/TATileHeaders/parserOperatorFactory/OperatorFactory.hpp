@@ -1,6 +1,7 @@
 #ifndef UTOTPARSER_OPERATORFACTORY_H
 #define UTOTPARSER_OPERATORFACTORY_H
 
+#include "TAHeaders/TATileHeaders/CompositionArena.hpp"
 #include "TAHeaders/TATileHeaders/parserOperatorFactory/Operator.hpp"
 #include "TAHeaders/TATileHeaders/parserOperatorFactory/OperatorMatchInOutSize.hpp"
 #include "TAHeaders/TATileHeaders/parserOperatorFactory/OperatorOnlyOneOut.hpp"
@@ -27,13 +28,13 @@ public:
         switch (tk)
         {
             case match_inout_size:
-                return new OperatorMatchInOutSize(parserList);
+                return CompositionArena::create<OperatorMatchInOutSize>(parserList);
 
             case only_one_out:
-                return new OperatorOnlyOneOut(parserList);
+                return CompositionArena::create<OperatorOnlyOneOut>(parserList);
 
             case tree_op:
-                return new OperatorTreeOp(parserList);
+                return CompositionArena::create<OperatorTreeOp>(parserList);
 
             default:
                 std::cerr << BHRED << "Not available operator." << rstColor << std::endl;
@@ -8,6 +8,7 @@
 #include "TAHeaders/TATileHeaders/parserOperatorFactory/Operator.hpp"
 #include "TAHeaders/TATileHeaders/TATileConstructor.hpp"
 #include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TAGraph.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/TileConnectorFactory.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/ConnectorFactory.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/Connector.hpp"
@@ -29,33 +30,35 @@ public:
     void executeOperator() override
     {
         // We take the tiles in opposite order, since we used a stack internal representation.
-        json t2 = parserList.getHead()->content.tileStack.top();
-        parserList.getHead()->content.tileStack.pop();
+        TAGraph t2 = popTile();
+        TAGraph t1 = popTile();
 
-        json t1 = parserList.getHead()->content.tileStack.top();
-        parserList.getHead()->content.tileStack.pop();
+        // Gathering the names of the locations which in and out locations' names will be deleted.
+        // If we assume t1 will be on the right and t2 on the left, then for t1, 'out' locations' names have to be
+        // deleted, while for t2, 'in' locations' names have to be deleted.
+        // This is because the resulting tile must have as 'in' locations the ones of the tile on its left, while
+        // as 'out' locations the ones of the tile on itr right.
+        std::vector<uint32_t> t1OutLocs = t1.getPorts(OUT);
+        std::vector<uint32_t> t2InLocs = t2.getPorts(IN);
 
-        // The tile in which the merge result will be stored.
+        // The tile in which the merge result will be stored is t1 itself.
         // In this way, t1 will be on the left and t2 will be on the right of the resulting tile.
-        json destTile = t1;
+        TAGraph &destTile = t1;
 
-        // For each tile required by the operator, we merge the locations and transitions into the destination one.
-        TATileConstructor::mergeLocations(t2, destTile);
-        TATileConstructor::mergeTransitions(t2, destTile);
+        // We merge the locations and transitions of t2 into the destination tile. Only the records of the smaller
+        // tile are moved, hence the positions of either tile may be shifted in the result.
+        std::pair<uint32_t, uint32_t> offsets = TATileConstructor::mergeTile(std::move(t2), destTile);
+        TAGraph::shiftPositions(t1OutLocs, offsets.first);
+        TAGraph::shiftPositions(t2InLocs, offsets.second);
 
-        TileConnectorFactory *tileConnectorFactory = new ConnectorFactory;
-        Connector *connector = tileConnectorFactory->createConnector(t1, t2, destTile, only_one_out);
+        ConnectorFactory tileConnectorFactory;
+        Connector *connector = tileConnectorFactory.createConnector(t1OutLocs, t2InLocs, destTile, only_one_out);
         connector->connectTiles();
 
-        // Gathering the names of the locations which in and out locations' names will be deleted.
-        // If we assume t1 will be on the right and t2 on the left, then for t1, 'out' locations' names have to be
-        // deleted, while for t2, 'in' locations' names have to be deleted.
-        // This is because the resulting tile must have as 'in' locations the ones of the tile on its left, while
-        // as 'out' locations the ones of the tile on itr right.
-        deleteLocName(destTile, TAContentExtractor::getNamedLocations(t2, IN), IN);
-        deleteLocName(destTile, TAContentExtractor::getNamedLocations(t1, OUT), OUT);
+        deleteLocName(destTile, t2InLocs, IN);
+        deleteLocName(destTile, t1OutLocs, OUT);
 
-        parserList.getHead()->content.tileStack.push(destTile);
+        pushTile(std::move(destTile));
     }
 
 };
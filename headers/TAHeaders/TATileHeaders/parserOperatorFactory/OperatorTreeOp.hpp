@@ -8,6 +8,7 @@
 #include "TAHeaders/TATileHeaders/parserOperatorFactory/Operator.hpp"
 #include "TAHeaders/TATileHeaders/TATileConstructor.hpp"
 #include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TAGraph.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/TileConnectorFactory.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/ConnectorFactory.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/Connector.hpp"
@@ -29,39 +30,40 @@ public:
     void executeOperator() override
     {
         // We take the tiles in opposite order, since we used a stack internal representation.
-        json t3 = parserList.getHead()->content.tileStack.top();
-        parserList.getHead()->content.tileStack.pop();
+        TAGraph t3 = popTile();
+        TAGraph t2 = popTile();
+        TAGraph t1 = popTile();
 
-        json t2 = parserList.getHead()->content.tileStack.top();
-        parserList.getHead()->content.tileStack.pop();
-
-        json t1 = parserList.getHead()->content.tileStack.top();
-        parserList.getHead()->content.tileStack.pop();
+        // Gathering the names of the locations which in and out locations' names will be deleted.
+        // If we assume t1 will be on the right and t2 on the left, then for t1, 'out' locations' names have to be
+        // deleted, while for t2, 'in' locations' names have to be deleted.
+        // This is because the resulting tile must have as 'in' locations the ones of the tile on its left, while
+        // as 'out' locations the ones of the tile on itr right.
+        std::vector<uint32_t> t1OutLocs = t1.getPorts(OUT);
+        std::vector<uint32_t> t2InLocs = t2.getPorts(IN);
+        std::vector<uint32_t> t3InLocs = t3.getPorts(IN);
 
-        // The tile in which the merge result will be stored.
+        // The tile in which the merge result will be stored is t1 itself.
         // In this way, t1 will be on the left and t2 will be on the right of the resulting tile.
-        json destTile = t1;
+        TAGraph &destTile = t1;
 
         // For each tile required by the operator, we merge the locations and transitions into the destination one.
-        TATileConstructor::mergeLocations(t2, destTile);
-        TATileConstructor::mergeTransitions(t2, destTile);
-        TATileConstructor::mergeLocations(t3, destTile);
-        TATileConstructor::mergeTransitions(t3, destTile);
-
-        TileConnectorFactory *tileConnectorFactory = new ConnectorFactory;
-        Connector *connector = tileConnectorFactory->createConnector(t1, t2, t3, destTile, tree_op);
+        // Only the records of the smaller tile are moved, hence the positions of either tile may be shifted in the result.
+        std::pair<uint32_t, uint32_t> t2Offsets = TATileConstructor::mergeTile(std::move(t2), destTile);
+        std::pair<uint32_t, uint32_t> t3Offsets = TATileConstructor::mergeTile(std::move(t3), destTile);
+        TAGraph::shiftPositions(t1OutLocs, t2Offsets.first + t3Offsets.first);
+        TAGraph::shiftPositions(t2InLocs, t2Offsets.second + t3Offsets.first);
+        TAGraph::shiftPositions(t3InLocs, t3Offsets.second);
+
+        ConnectorFactory tileConnectorFactory;
+        Connector *connector = tileConnectorFactory.createConnector(t1OutLocs, t2InLocs, t3InLocs, destTile, tree_op);
         connector->connectTiles();
 
-        // Gathering the names of the locations which in and out locations' names will be deleted.
-        // If we assume t1 will be on the right and t2 on the left, then for t1, 'out' locations' names have to be
-        // deleted, while for t2, 'in' locations' names have to be deleted.
-        // This is because the resulting tile must have as 'in' locations the ones of the tile on its left, while
-        // as 'out' locations the ones of the tile on itr right.
-        deleteLocName(destTile, TAContentExtractor::getNamedLocations(t3, IN), IN);
-        deleteLocName(destTile, TAContentExtractor::getNamedLocations(t2, IN), IN);
-        deleteLocName(destTile, TAContentExtractor::getNamedLocations(t1, OUT), OUT);
+        deleteLocName(destTile, t3InLocs, IN);
+        deleteLocName(destTile, t2InLocs, IN);
+        deleteLocName(destTile, t1OutLocs, OUT);
 
-        parserList.getHead()->content.tileStack.push(destTile);
+        pushTile(std::move(destTile));
     }
 
 };
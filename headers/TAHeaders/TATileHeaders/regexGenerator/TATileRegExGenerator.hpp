@@ -3,6 +3,7 @@
 
 #include <random>
 #include "utilities/Utils.hpp"
+#include "utilities/RandomStream.hpp"
 
 #define PRINT_DERIVATIONS
 
@@ -55,7 +56,7 @@ protected:
     std::string pickRandomExpansion(const std::string &nonTerminal, std::mt19937 &gen)
     {
         // Vector containing the possible expansion rules for the given 'nonTerminal' string.
-        std::vector<std::string> expansions = expansionRules.find(nonTerminal)->second;
+        const std::vector<std::string> &expansions = expansionRules.find(nonTerminal)->second;
 
         // Distribution used to extract a random value from the 'expansions' vector.
         std::uniform_int_distribution<int> int_dist(0, static_cast<int>(expansions.size()) - 1);
@@ -83,7 +84,10 @@ public:
                                        "t2", // tile_3_inf.
                                        "t3", // tile_accepting.
                                        "t4", // tile_double_out.
-                                       "t:BA" }}
+                                       "t:BA",
+                                       "t:ER",
+                                       "t:WS",
+                                       "t:DAG" }}
         };
         nonStartingNonTerminals = { binOp, triOp, tile };
     }
@@ -115,8 +119,7 @@ public:
      */
     virtual std::string generateRegEx()
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        std::mt19937 &gen = RandomStream::getGenerator();
 
         std::cout << "Generating regular expression.\n";
 
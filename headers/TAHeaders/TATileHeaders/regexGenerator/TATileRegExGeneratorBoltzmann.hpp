@@ -0,0 +1,295 @@
+#ifndef UTOTPARSER_TATILEREGEXGENERATORBOLTZMANN_H
+#define UTOTPARSER_TATILEREGEXGENERATORBOLTZMANN_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "utilities/Utils.hpp"
+#include "TAHeaders/TATileHeaders/regexGenerator/TATileRegExGenerator.hpp"
+
+
+// Here we assume tiles have only one 'in' location regardless of the number of 'out' locations.
+
+// Context-free grammar describing the compositions drawn by the Boltzmann generator:
+// ---------------------------------------------------------------------------------
+// TA -> '(' TiledTA ')' '+1' AccTile
+// TiledTA -> LeafTile | LeafTile '+' TiledTA | TriTile '++' '(' TiledTA ')' '(' TiledTA ')'
+// LeafTile -> BinTile | RngTile
+// This is the strict grammar without the production TiledTA -> '(' TiledTA ')', which does not change the composed TA
+// and would make the number of compositions with a given number of tiles infinite.
+
+// Boltzmann sampling:
+// -------------------
+// The size of a composition is its number of tiles. With 'a' leaf tiles and 't' ternary tiles to choose from, the
+// generating function S(x) of the compositions satisfies S = a x + a x S + t x S^2. A Boltzmann generator with parameter x
+// draws a composition of size n with probability proportional to x^n, hence all the compositions of a given size are
+// equally likely, and it chooses each production with probability equal to its share of S(x):
+// - LeafTile:                        a x / S(x)
+// - LeafTile '+' TiledTA:            a x
+// - TriTile '++' (TiledTA) (TiledTA): t x S(x)
+// The parameter x is tuned so that the expected size is the requested one. When a tolerance is given, compositions
+// whose size falls outside of it are rejected, aborting the draw as soon as it gets too large: since the grammar is
+// tree-like (S(x) has a square-root singularity at rho), drawing at x = rho makes the expected cost linear in the size.
+
+class TATileRegExGeneratorBoltzmann : public TATileRegExGenerator {
+
+private:
+    // The non-terminal representing a tile composed only by one 'in' location and no 'out' locations.
+    const std::string accTile { "AccTile" };
+
+    // The non-terminal representing a random integer number.
+    const std::string integer { "Integer" };
+
+    // The requested number of tiles (the accepting tile added at the end excluded).
+    int targetSize {};
+
+    // The relative tolerance on the number of tiles, 0 if any size is accepted.
+    double tolerance {};
+
+    // Integer indicating the maximum number of states randomly-generated tiles will have.
+    int maxNumOfRandomStates {};
+
+    // The tiles that can end a composition or be followed by the binary operator (binary and random tiles).
+    std::vector<std::string> leafTileTokens {};
+
+    // The tiles that can be followed by the ternary operator.
+    std::vector<std::string> triTileTokens {};
+
+    // The parameter of the Boltzmann generator.
+    double x {};
+
+    // The probability of the production TiledTA -> LeafTile.
+    double leafProbability {};
+
+    // The probability of the production TiledTA -> LeafTile '+' TiledTA.
+    double binProbability {};
+
+
+    /**
+     * Method used to compute the generating function of the compositions.
+     * @param z the point at which to compute it (between 0 and the singularity).
+     * @return the value of S(z).
+     */
+    [[nodiscard]] double computeS(double z) const
+    {
+        auto a = static_cast<double>(leafTileTokens.size());
+        auto t = static_cast<double>(triTileTokens.size());
+
+        if (t == 0)
+            return a * z / (1 - a * z);
+
+        // The smallest root of t z S^2 + (a z - 1) S + a z = 0.
+        double b { 1 - a * z };
+        return (b - std::sqrt(std::max(0.0, b * b - 4 * t * a * z * z))) / (2 * t * z);
+    }
+
+
+    /**
+     * Method used to compute the expected number of tiles drawn by a Boltzmann generator, i.e., z S'(z) / S(z).
+     * @param z the parameter of the generator.
+     * @return the expected number of tiles.
+     */
+    [[nodiscard]] double computeExpectedSize(double z) const
+    {
+        auto a = static_cast<double>(leafTileTokens.size());
+        auto t = static_cast<double>(triTileTokens.size());
+
+        double s { computeS(z) };
+        // Derivative obtained by differentiating the equation of S implicitly.
+        double ds { (t * s * s + a * s + a) / (1 - 2 * t * z * s - a * z) };
+        return z * ds / s;
+    }
+
+
+    /**
+     * Method used to tune the parameter of the generator.
+     * With a tolerance and ternary tiles the generator is singular (x = rho), otherwise x is such that the expected
+     * number of tiles is 'targetSize'.
+     */
+    void tuneParameter()
+    {
+        auto a = static_cast<double>(leafTileTokens.size());
+        auto t = static_cast<double>(triTileTokens.size());
+
+        // The singularity of S, where the expected size diverges.
+        double rho { 1 / (a + 2 * std::sqrt(a * t)) };
+
+        if (tolerance > 0 && t > 0)
+            x = rho;
+        else
+        {
+            // The expected size grows with x, hence it can be inverted by bisection.
+            double l { 0 };
+            double r { rho };
+            for (int i = 0; i < 200; i++)
+            {
+                double m { (l + r) / 2 };
+                if (computeExpectedSize(m) < targetSize)
+                    l = m;
+                else
+                    r = m;
+            }
+            x = l;
+        }
+
+        leafProbability = a * x / computeS(x);
+        binProbability = a * x;
+    }
+
+
+    /**
+     * Method used to pick a random element from the given tiles, substituting the 'integer' non-terminal if present.
+     * @param tokens the tiles from which to pick.
+     * @param gen a random number generator.
+     * @return the name of a tile.
+     */
+    std::string pickTile(const std::vector<std::string> &tokens, std::mt19937 &gen)
+    {
+        std::uniform_int_distribution<size_t> token_dist(0, tokens.size() - 1);
+        const std::string &token = tokens[token_dist(gen)];
+
+        if (token.find(integer) == std::string::npos)
+            return token;
+
+        std::uniform_int_distribution<int> int_dist(0, maxNumOfRandomStates);
+        return subSinS(token, integer, std::to_string(int_dist(gen)));
+    }
+
+
+    /**
+     * Method used to draw a composition from the Boltzmann generator.
+     * The 'startSymbol' non-terminals still to be drawn are kept in a stack, together with the closing parentheses of
+     * the ternary operators, hence the regular expression is written from left to right without recursion.
+     * @param regEx the string in which to write the composition.
+     * @param maxSize the number of tiles after which the draw is aborted.
+     * @param gen a random number generator.
+     * @return the number of tiles of the composition, or -1 if the draw has been aborted.
+     */
+    int drawComposition(std::string &regEx, long maxSize, std::mt19937 &gen)
+    {
+        std::uniform_real_distribution<double> production_dist(0, 1);
+
+        // The symbols still to be written: either the 'startSymbol' non-terminal or a string to copy as it is.
+        std::vector<const std::string *> pending { &startSymbol };
+        static const std::string closeAndOpen { " ) (" };
+        static const std::string close { " )" };
+
+        long size { 0 };
+        while (!pending.empty())
+        {
+            const std::string *symbol = pending.back();
+            pending.pop_back();
+
+            if (symbol != &startSymbol)
+            {
+                regEx.append(*symbol);
+                continue;
+            }
+
+            if (++size > maxSize)
+                return -1;
+
+            double p { production_dist(gen) };
+            if (!regEx.empty())
+                regEx.push_back(' ');
+
+            if (p < leafProbability)
+                regEx.append(pickTile(leafTileTokens, gen));
+            else if (p < leafProbability + binProbability)
+            {
+                regEx.append(pickTile(leafTileTokens, gen)).append(" +");
+                pending.push_back(&startSymbol);
+            } else
+            {
+                regEx.append(pickTile(triTileTokens, gen)).append(" ++ (");
+                pending.push_back(&close);
+                pending.push_back(&startSymbol);
+                pending.push_back(&closeAndOpen);
+                pending.push_back(&startSymbol);
+            }
+        }
+        return static_cast<int>(size);
+    }
+
+
+public:
+    /**
+     * Default parametric constructor.
+     * @param targetSize the expected number of tiles of each generated TiledTA (at least one).
+     * @param tolerance the relative tolerance on the number of tiles (e.g., 0.1 for 10%), 0 to accept any number of tiles.
+     * @param maxNumOfRandomStates the maximum number of states randomly-generated tiles will have.
+     * @param rngTileTokens the symbols of the randomly-generated tiles.
+     * @param accTileTokens the symbols of the accepting tiles.
+     * @param binTileTokens the symbols of the binary tiles.
+     * @param triTileTokens the symbols of the ternary tiles.
+     */
+    explicit TATileRegExGeneratorBoltzmann(int targetSize,
+                                           double tolerance,
+                                           int maxNumOfRandomStates,
+                                           const std::vector<std::string> &rngTileTokens,
+                                           std::vector<std::string> accTileTokens,
+                                           const std::vector<std::string> &binTileTokens,
+                                           std::vector<std::string> triTileTokens) :
+            TATileRegExGenerator(targetSize), targetSize(std::max(1, targetSize)), tolerance(std::max(0.0, tolerance)),
+            maxNumOfRandomStates(maxNumOfRandomStates), triTileTokens(std::move(triTileTokens))
+    {
+        // As in the strict grammar, random tiles can also be given the number of their states.
+        leafTileTokens = binTileTokens;
+        for (const std::string &token: rngTileTokens)
+        {
+            leafTileTokens.push_back(token);
+            leafTileTokens.push_back(token + "[" + integer + "]");
+        }
+
+        if (leafTileTokens.empty())
+            throw NeededTilesNotPresentException("The Boltzmann generator needs at least one binary or random tile.");
+
+        expansionRules = {{ accTile, std::move(accTileTokens) }};
+
+        tuneParameter();
+    }
+
+
+    /**
+     * Method used to create a random string corresponding to the context-free grammar above, drawn by the Boltzmann generator.
+     * Without a tolerance, the number of tiles is 'targetSize' on average; with a tolerance, draws are repeated until the
+     * number of tiles is within it. In both cases, compositions with the same number of tiles are equally likely.
+     * At the end, a tile composed by only one 'in' accepting state is connected to the end of the generated tiled TA,
+     * in order to ensure that there will be at least one accepting state.
+     * @return a string corresponding to the context-free grammar above.
+     */
+    std::string generateRegEx() override
+    {
+        std::mt19937 &gen = RandomStream::getGenerator();
+
+        std::cout << "Generating regular expression.\n";
+
+        long minSize { 1 };
+        long maxSize { std::numeric_limits<long>::max() };
+        if (tolerance > 0)
+        {
+            minSize = std::max(1L, static_cast<long>(std::ceil(targetSize * (1 - tolerance))));
+            maxSize = static_cast<long>(std::floor(targetSize * (1 + tolerance)));
+        }
+
+        std::string regEx {};
+        int size {};
+        int attempts { 0 };
+        do
+        {
+            regEx.clear();
+            size = drawComposition(regEx, maxSize, gen);
+            attempts++;
+        } while (size < minSize);
+
+        std::cout << "Drawn " << size << " tiles in " << attempts << " attempts.\n";
+
+        // Using the '+1' operator since it ensures that the accepting tile will be
+        // connected to at least one location of the randomly-generated tiled TA.
+        return "( " + regEx + " ) +1 " + pickRandomExpansion(accTile, gen);
+    }
+
+};
+
+
+#endif //UTOTPARSER_TATILEREGEXGENERATORBOLTZMANN_H
@@ -1,11 +1,13 @@
 #ifndef UTOTPARSER_TATILEREGEXGENERATORSTRICT_H
 #define UTOTPARSER_TATILEREGEXGENERATORSTRICT_H
 
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
 #include "utilities/Utils.hpp"
 #include "TAHeaders/TATileHeaders/regexGenerator/TATileRegExGenerator.hpp"
 
-#define PRINT_DERIVATIONS
-
 
 // Here we assume tiles have only one 'in' location regardless of the number of 'out' locations.
 
@@ -21,6 +23,30 @@
 // RngTile -> t | t '[' Integer ']' (where t is a randomly-generated tile which can only apply to a binary operator).
 // Integer -> epsilon | (1..9)(0..9)*
 
+
+/**
+ * Struct representing a node of a derivation tree.
+ */
+typedef struct dtn {
+    // The grammar symbol of the node: a non-terminal until the node is expanded, a terminal (e.g., '+' or 't3') if it is a leaf.
+    std::string symbol;
+    // The children of the node are stored one after the other inside the tree, starting from position 'firstChild'.
+    uint32_t firstChild;
+    uint32_t childCount;
+} DerivationNode;
+
+
+/**
+ * Struct representing a production of the 'startSymbol' non-terminal, split into its symbols.
+ */
+typedef struct dpr {
+    std::vector<std::string> symbols;
+    // How much the production increases the size of the TiledTA, i.e., the number of its tiles plus the number of
+    // 'startSymbol' non-terminals still to be expanded.
+    int sizeIncrease;
+} DerivationProduction;
+
+
 class TATileRegExGeneratorStrict : public TATileRegExGenerator {
 
 private:
@@ -40,92 +66,155 @@ private:
     // The non-terminal representing a random integer number.
     const std::string integer { "Integer" };
 
+    // The number of tiles the TiledTA will be made of (the accepting tile added at the end excluded).
+    int targetSize {};
+
     // Integer indicating the maximum number of states randomly-generated tiles will have.
     int maxNumOfRandomStates {};
 
+    // The productions of the 'startSymbol' non-terminal, as given in the 'expansionRules' map, split into their symbols.
+    std::vector<DerivationProduction> startProductions {};
+
 
     /**
-     * Method used to perform productions corresponding to the 'startSymbol' non-terminal.
-     * @param regEx the regular expression that has to be manipulated.
-     * @param gen a random number generator.
+     * Method used to tell if a symbol is one of the non-terminals representing a tile.
+     * @param symbol the symbol to check.
+     * @return true if the symbol represents a tile, false otherwise.
      */
-    void performStartSymbolProductions(std::string &regEx, std::mt19937 &gen)
+    [[nodiscard]] bool isTile(const std::string &symbol) const
     {
-        for (int i = 0; i < maxIter; i++)
-        {
-            regEx = subSinS(regEx, startSymbol, pickRandomExpansion(startSymbol, gen));
+        return symbol == binTile || symbol == rngTile || symbol == triTile;
+    }
 
-#ifdef PRINT_DERIVATIONS
-            std::cout << regEx << '\n';
-#endif
-        }
+
+    /**
+     * Method used to expand a node of the derivation tree, appending its children to the tree.
+     * @param tree the derivation tree.
+     * @param node the position of the node to expand.
+     * @param symbols the symbols of the children of the node.
+     */
+    static void expandNode(std::vector<DerivationNode> &tree, uint32_t node, const std::vector<std::string> &symbols)
+    {
+        tree[node].firstChild = static_cast<uint32_t>(tree.size());
+        tree[node].childCount = static_cast<uint32_t>(symbols.size());
+        for (const std::string &symbol: symbols)
+            tree.push_back({ symbol, 0, 0 });
     }
 
 
     /**
-     * Method used to substitute every occurrence of the 'startSymbol' non-terminal with either the 'binTile' or 'rngTile' non-terminal.
-     * @param regEx the regular expression that has to be manipulated.
+     * Method used to perform productions corresponding to the 'startSymbol' non-terminal, until the TiledTA has reached
+     * 'targetSize' tiles once its remaining 'startSymbol' non-terminals become tiles.
+     * Non-terminals are expanded from the leftmost one, and a production making the TiledTA larger than 'targetSize' is never chosen.
+     * @param tree the derivation tree, containing only its root.
      * @param gen a random number generator.
      */
-    void substituteStartSymbolWithBinOrRng(std::string &regEx, std::mt19937 &gen)
+    void performStartSymbolProductions(std::vector<DerivationNode> &tree, std::mt19937 &gen)
     {
-        // Uniform distribution used to select which non-terminal to use: either 'binTile' or 'rngTile'.
-        std::uniform_int_distribution<int> bool_dist(0, 1);
+        // Distribution used to extract a production.
+        std::uniform_int_distribution<size_t> production_dist(0, startProductions.size() - 1);
+
+        // The 'startSymbol' nodes still to be expanded, with the leftmost one on top.
+        std::vector<uint32_t> openNodes { 0 };
 
-        while (regEx.find(startSymbol) != std::string::npos)
+        // The tiles of the TiledTA plus the 'startSymbol' nodes still to be expanded (each of them will become at least one tile).
+        int size { 1 };
+
+        // Every production contains the 'startSymbol' non-terminal, hence there is always a node to expand.
+        while (size < targetSize)
         {
-            bool isBinOrRng = bool_dist(gen);
+            uint32_t node = openNodes.back();
+            openNodes.pop_back();
+
+            const DerivationProduction *production = &startProductions[production_dist(gen)];
+            while (size + production->sizeIncrease > targetSize)
+                production = &startProductions[production_dist(gen)];
 
-            regEx = subSinS(regEx, startSymbol, isBinOrRng ? binTile : rngTile);
+            expandNode(tree, node, production->symbols);
+            size += production->sizeIncrease;
 
-#ifdef PRINT_DERIVATIONS
-            std::cout << regEx << '\n';
-#endif
+            for (uint32_t child = tree[node].firstChild + tree[node].childCount; child-- > tree[node].firstChild;)
+                if (tree[child].symbol == startSymbol)
+                    openNodes.push_back(child);
         }
     }
 
 
     /**
-     * Method used to perform productions for every non-terminal contained in the 'nonStartingNonTerminals' vector.
-     * @param regEx the regular expression that has to be manipulated.
+     * Method used to substitute every leaf holding the 'startSymbol' non-terminal with either the 'binTile' or 'rngTile' non-terminal.
+     * @param tree the derivation tree.
      * @param gen a random number generator.
      */
-    void substituteNonTerminals(std::string &regEx, std::mt19937 &gen)
+    void substituteStartSymbolWithBinOrRng(std::vector<DerivationNode> &tree, std::mt19937 &gen)
     {
-        // Sorting the 'nonStartingNonTerminals' strings in descending order of length in order to
-        // avoid collision due to shorter named contained in longer names during substitution.
-        std::sort(nonStartingNonTerminals.begin(), nonStartingNonTerminals.end(), sortVectorByElementLength);
+        // Uniform distribution used to select which non-terminal to use: either 'binTile' or 'rngTile'.
+        std::uniform_int_distribution<int> bool_dist(0, 1);
 
-        for (const std::string &nonTerminal: nonStartingNonTerminals)
-            while (regEx.find(nonTerminal) != std::string::npos)
+        for (DerivationNode &node: tree)
+            if (node.childCount == 0 && node.symbol == startSymbol)
             {
-                regEx = subSinS(regEx, nonTerminal, pickRandomExpansion(nonTerminal, gen));
-
-#ifdef PRINT_DERIVATIONS
-                std::cout << regEx << '\n';
-#endif
+                bool isBinOrRng = bool_dist(gen);
+                node.symbol = isBinOrRng ? binTile : rngTile;
             }
     }
 
 
     /**
-     * Method used to generate a random integer number for every 'integer' non-terminal instance contained in the regex.
-     * @param regEx the regular expression that has to be manipulated.
+     * Method used to perform productions for every leaf holding a non-terminal contained in the 'nonStartingNonTerminals' vector.
+     * Since each leaf holds exactly one symbol, names contained in longer names (e.g., 'Bin' and 'BinTile') never clash.
+     * @param tree the derivation tree.
      * @param gen a random number generator.
      */
-    void substituteInteger(std::string &regEx, std::mt19937 &gen)
+    void substituteNonTerminals(std::vector<DerivationNode> &tree, std::mt19937 &gen)
+    {
+        for (DerivationNode &node: tree)
+            if (node.childCount == 0 && std::find(nonStartingNonTerminals.begin(), nonStartingNonTerminals.end(), node.symbol) != nonStartingNonTerminals.end())
+                node.symbol = pickRandomExpansion(node.symbol, gen);
+    }
+
+
+    /**
+     * Method used to generate a random integer number for every 'integer' non-terminal instance contained in the leaves.
+     * @param tree the derivation tree.
+     * @param gen a random number generator.
+     */
+    void substituteInteger(std::vector<DerivationNode> &tree, std::mt19937 &gen)
     {
         // Uniform distribution used to draw a random number that will determine the value of the current integer.
         std::uniform_int_distribution<int> int_dist(0, maxNumOfRandomStates);
 
-        while (regEx.find(integer) != std::string::npos)
+        for (DerivationNode &node: tree)
+            if (node.childCount == 0 && node.symbol.find(integer) != std::string::npos)
+                node.symbol = subSinS(node.symbol, integer, std::to_string(int_dist(gen)));
+    }
+
+
+    /**
+     * Method used to get the string derived by a derivation tree, i.e., its leaves from left to right separated by whitespaces.
+     * @param tree the derivation tree.
+     * @return the string derived by the tree.
+     */
+    static std::string serializeTree(const std::vector<DerivationNode> &tree)
+    {
+        std::string regEx {};
+
+        // The nodes still to be visited, with the leftmost one on top.
+        std::vector<uint32_t> toVisit { 0 };
+        while (!toVisit.empty())
         {
-            regEx = subSinS(regEx, integer, std::to_string(int_dist(gen)));
+            const DerivationNode &node = tree[toVisit.back()];
+            toVisit.pop_back();
 
-#ifdef PRINT_DERIVATIONS
-            std::cout << regEx << '\n';
-#endif
+            if (node.childCount == 0)
+            {
+                if (!regEx.empty())
+                    regEx.push_back(' ');
+                regEx.append(node.symbol);
+            } else
+                for (uint32_t child = node.firstChild + node.childCount; child-- > node.firstChild;)
+                    toVisit.push_back(child);
         }
+        return regEx;
     }
 
 
@@ -144,17 +233,27 @@ private:
 
 
 public:
-    explicit TATileRegExGeneratorStrict(int maxIter,
+    /**
+     * Default parametric constructor.
+     * @param targetSize the number of tiles each generated TiledTA will be made of (at least one).
+     * @param maxNumOfRandomStates the maximum number of states randomly-generated tiles will have.
+     * @param rngTileTokens the symbols of the randomly-generated tiles.
+     * @param accTileTokens the symbols of the accepting tiles.
+     * @param binTileTokens the symbols of the binary tiles.
+     * @param triTileTokens the symbols of the ternary tiles.
+     */
+    explicit TATileRegExGeneratorStrict(int targetSize,
                                         int maxNumOfRandomStates,
                                         std::vector<std::string> rngTileTokens,
                                         std::vector<std::string> accTileTokens,
                                         std::vector<std::string> binTileTokens,
                                         std::vector<std::string> triTileTokens) :
-            TATileRegExGenerator(maxIter), maxNumOfRandomStates(maxNumOfRandomStates)
+            TATileRegExGenerator(targetSize), targetSize(std::max(1, targetSize)), maxNumOfRandomStates(maxNumOfRandomStates)
     {
         // Creating also parametrized versions of rng tokens.
-        for (const std::string &rngToken: rngTileTokens)
-            rngTileTokens.push_back(rngToken + "[" + integer + "]");
+        size_t numRngTileTokens = rngTileTokens.size();
+        for (size_t i = 0; i < numRngTileTokens; i++)
+            rngTileTokens.push_back(rngTileTokens[i] + "[" + integer + "]");
 
         expansionRules = {
                 { startSymbol, { binTile + " " + binOp + " " + startSymbol,
@@ -175,52 +274,66 @@ public:
                 { triTile,     triTileTokens }
         };
         nonStartingNonTerminals = { binOp, triOp, binTile, triTile, rngTile };
+
+        // Splitting the productions of the 'startSymbol' non-terminal into their symbols once, so that derivation trees
+        // can be built without looking into strings.
+        for (const std::string &rule: expansionRules.at(startSymbol))
+        {
+            DerivationProduction production { {}, -1 };
+
+            std::istringstream symbols(rule);
+            std::string symbol {};
+            while (symbols >> symbol)
+            {
+                if (isTile(symbol) || symbol == startSymbol)
+                    ++production.sizeIncrease;
+                production.symbols.push_back(symbol);
+            }
+            startProductions.push_back(production);
+        }
     }
 
 
     /**
      * Method used to create a random string corresponding to the context-free grammar specified inside the 'expansionRules' map.
-     * The idea is to first lay out the structure of the string by expanding the 'startSymbol' non-terminals.
-     * Then, after 'maxIter' iterations, all the 'startSymbol' non-terminals are transformed into 'binTile' non-terminals.
+     * The string is derived as a tree: the structure is first laid out by expanding the 'startSymbol' non-terminals until
+     * the TiledTA has 'targetSize' tiles, then the remaining 'startSymbol' leaves become 'binTile' or 'rngTile' non-terminals.
      * This step could have used also other types of tiles (e.g. 'triTile' tiles): the choice made on binary ones
      * is only a convention.
-     * Finally, for each non-terminal inside the 'nonStartingNonTerminals' vector, pick a random terminal
-     * for it from its respective expansion rules.
+     * Finally, each leaf holding a non-terminal inside the 'nonStartingNonTerminals' vector is given a random terminal
+     * from its respective expansion rules, and the string is read from the leaves of the tree.
      * At the end, a tile composed by only one 'in' accepting state is connected to the end of the generated tiled TA,
      * in order to ensure that there will be at least one accepting state. This is done since tiles may not necessarily
      * include an accepting state.
+     * Each step takes time linear in the size of the tree, and the tree is only used by the calling thread.
      * @return a string corresponding to the context-free grammar specified inside the 'expansionRules' map.
      */
     std::string generateRegEx() override
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        std::mt19937 &gen = RandomStream::getGenerator();
 
         std::cout << "Generating regular expression.\n";
 
-        std::string regEx { startSymbol };
-
-#ifdef PRINT_DERIVATIONS
-        std::cout << regEx << '\n';
-#endif
+        // Most productions have three symbols and add one tile, hence the tree has about four nodes per tile.
+        std::vector<DerivationNode> tree {};
+        tree.reserve(4 * static_cast<size_t>(targetSize) + 8);
+        tree.push_back({ startSymbol, 0, 0 });
 
-        // Laying out the structure of the regular expression, stopping after 'maxIter' iterations.
-        performStartSymbolProductions(regEx, gen);
+        // Laying out the structure of the regular expression, until 'targetSize' tiles are reached.
+        performStartSymbolProductions(tree, gen);
 
-        // Now each remaining 'startingSymbol' occurrence must be transformed into a 'binTile' or 'rngTile' non-terminal,
+        // Now each remaining 'startingSymbol' leaf must be transformed into a 'binTile' or 'rngTile' non-terminal,
         // in order to subsequently transform it into a proper tile name.
-        // This step could be simplified by directly transforming 'startingSymbol' into a 'binTile' or 'rngTile' non-terminal,
-        // but it has been done this way to be coherent with the final step involving all the non-starting non-terminals.
-        substituteStartSymbolWithBinOrRng(regEx, gen);
+        substituteStartSymbolWithBinOrRng(tree, gen);
 
-        // Finally, each non-terminal must be substituted with a proper terminal symbol, since at
-        // this level no recursive productions can happen, given that no more 'startingSymbol' occurrence
-        // is present, that is, no recursive productions are available.
-        // The 'nonStartingNonTerminals' vector must be sorted to avoid name clashes (e.g. between 'Bin' and 'BinTile')
-        substituteNonTerminals(regEx, gen);
+        // Finally, each non-terminal leaf must be substituted with a proper terminal symbol, since at
+        // this level no recursive productions can happen, given that no more 'startingSymbol' leaf is present.
+        substituteNonTerminals(tree, gen);
 
         // Now each occurrence of the 'Integer' non-terminal must be substituted by a randomly-generated integer.
-        substituteInteger(regEx, gen);
+        substituteInteger(tree, gen);
+
+        std::string regEx { serializeTree(tree) };
 
         // Adding the accepting tile at the end since tiles may not have one accepting location inside them.
         addAcceptingTile(regEx, gen);
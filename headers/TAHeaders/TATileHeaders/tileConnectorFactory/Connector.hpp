@@ -4,6 +4,7 @@
 #include "nlohmann/json.hpp"
 
 #include "utilities/JsonHelper.hpp"
+#include "TAHeaders/TAGraph.hpp"
 #include "TAHeaders/TATileHeaders/tileEnums/TileTokensEnum.h"
 
 using json = nlohmann::json;
@@ -12,21 +13,29 @@ using json = nlohmann::json;
 class Connector {
 
 protected:
-    // The tile from which the new transitions will start, with out nodes as source.
-    const json &tile1;
+    // The positions in destTile of the out locations of the tile from which the new transitions will start.
+    std::vector<uint32_t> tile1OutLocs;
 
-    // The tile from which the new transitions will join, with out nodes as target.
-    const json &tile2;
+    // The positions in destTile of the in locations of the tile in which the new transitions will end.
+    std::vector<uint32_t> tile2InLocs;
 
-    // The destination tile in which the new transition will be added.
-    json &destTile;
+    // The destination tile in which the new transition will be added, already containing the tiles to connect.
+    TAGraph &destTile;
 
     // An integer that will be used to keep new transitions unique.
     int newTransNonce;
 
 
 public:
-    Connector(const json &tile1, const json &tile2, json &destTile) : tile1(tile1), tile2(tile2), destTile(destTile)
+    /**
+     * Default parametric constructor.
+     * The tiles to connect must have already been merged into destTile, and are identified by their port locations.
+     * @param tile1OutLocs the positions of the out locations of the tile from which the new transitions will start.
+     * @param tile2InLocs the positions of the in locations of the tile in which the new transitions will end.
+     * @param destTile the destination tile in which the new transition will be added.
+     */
+    Connector(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, TAGraph &destTile) :
+            tile1OutLocs(std::move(tile1OutLocs)), tile2InLocs(std::move(tile2InLocs)), destTile(destTile)
     {
         newTransNonce = 0;
     };
@@ -43,32 +52,23 @@ public:
 
 
     /**
-     * Method used to create and insert a new transition in the given destTile json.
-     * @param sourceLocId the id of the transition source.
-     * @param destLocId the id of the transition target.
-     * @param destTile the destination tile in which the new transition will be added.
-     * @param transitionText the text appearing on the new transition.
-     * @param transitionKind the kind of the new transition.
+     * Method used to create and insert a new transition in destTile.
+     * The comments of the target location, if any, become the assignment of the new transition (with ',' replaced by ';').
+     * @param sourceLoc the position of the transition source.
+     * @param destLoc the position of the transition target.
      */
-    void insertNewTransition(const std::string &sourceLocId, const std::string &destLocId, const std::string &transitionText, const std::string &transitionKind)
+    void insertNewTransition(uint32_t sourceLoc, uint32_t destLoc)
     {
-        // A pointer to the json representation of the transitions section of the destination tile.
-        json *destTileTransitionsPtr = getJsonPtrAsArray(TAContentExtractor::getTransitionsPtr(destTile));
-
-        json newTrans = {
-                { ID,     "newTrans" + newTransNonceStr() },
-                { SOURCE, {{ REF, sourceLocId }}},
-                { TARGET, {{ REF, destLocId }}}
-        };
-
-        // If the transition must have some text, we further add it to the transition itself.
-        if (!transitionText.empty())
-            newTrans[LABEL] = {
-                    { TEXT, transitionText },
-                    { KIND, transitionKind }
-            };
-
-        destTileTransitionsPtr->push_back(newTrans);
+        uint32_t comments = destTile.getLocation(destLoc).comments;
+
+        std::string transitionText {};
+        if (comments != STRING_POOL_NONE)
+        {
+            transitionText = TAGraph::getString(comments);
+            std::replace(transitionText.begin(), transitionText.end(), ',', ';');
+        }
+
+        destTile.addEdge("newTrans" + newTransNonceStr(), sourceLoc, destLoc, transitionText, ASSIGNMENT);
         newTransNonce++;
     }
 
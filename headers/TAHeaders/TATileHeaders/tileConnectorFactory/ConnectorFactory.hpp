@@ -1,6 +1,7 @@
 #ifndef UTOTPARSER_CONNECTORFACTORY_H
 #define UTOTPARSER_CONNECTORFACTORY_H
 
+#include "TAHeaders/TATileHeaders/CompositionArena.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/TileConnectorFactory.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/ConnectorOnlyOneOut.hpp"
 #include "TAHeaders/TATileHeaders/tileConnectorFactory/ConnectorMatchInOutSize.hpp"
@@ -12,21 +13,21 @@ class ConnectorFactory : public TileConnectorFactory {
 public:
     /**
      * Method used to select the way in which two tiles will be connected.
-     * @param tile1 the first tile to be connected.
-     * @param tile2 the second tile to be connected.
-     * @param destTile the destination tile in which the new transition will be added.
+     * @param tile1OutLocs the positions in destTile of the out locations of the first tile to be connected.
+     * @param tile2InLocs the positions in destTile of the in locations of the second tile to be connected.
+     * @param destTile the destination tile, already containing the tiles to connect, in which the new transition will be added.
      * @param method the way in which the new transition(s) will be generated.
      * @return a proper tile connector based on the method parameter.
      */
-    Connector *createConnector(const json &tile1, const json &tile2, json &destTile, TileTokensEnum op) override
+    Connector *createConnector(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, TAGraph &destTile, TileTokensEnum op) override
     {
         switch (op)
         {
             case only_one_out:
-                return new ConnectorOnlyOneOut(tile1, tile2, destTile);
+                return CompositionArena::create<ConnectorOnlyOneOut>(std::move(tile1OutLocs), std::move(tile2InLocs), destTile);
 
             case match_inout_size:
-                return new ConnectorMatchInOutSize(tile1, tile2, destTile);
+                return CompositionArena::create<ConnectorMatchInOutSize>(std::move(tile1OutLocs), std::move(tile2InLocs), destTile);
 
             default:
                 std::cerr << BHRED << "Not available connection method." << rstColor << std::endl;
@@ -38,19 +39,19 @@ public:
 
     /**
      * Method used to select the way in which two tiles will be connected.
-     * @param tile1 the first tile to be connected.
-     * @param tile2 the second tile to be connected.
-     * @param tile3 the third tile to be connected.
-     * @param destTile the destination tile in which the new transition will be added.
+     * @param tile1OutLocs the positions in destTile of the out locations of the first tile to be connected.
+     * @param tile2InLocs the positions in destTile of the in locations of the second tile to be connected.
+     * @param tile3InLocs the positions in destTile of the in locations of the third tile to be connected.
+     * @param destTile the destination tile, already containing the tiles to connect, in which the new transition will be added.
      * @param method the way in which the new transition(s) will be generated.
      * @return a proper tile connector based on the method parameter.
      */
-    Connector *createConnector(const json &tile1, const json &tile2, const json &tile3, json &destTile, TileTokensEnum tk) override
+    Connector *createConnector(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, std::vector<uint32_t> tile3InLocs, TAGraph &destTile, TileTokensEnum tk) override
     {
         switch (tk)
         {
             case tree_op:
-                return new ConnectorTreeOp(tile1, tile2, tile3, destTile);
+                return CompositionArena::create<ConnectorTreeOp>(std::move(tile1OutLocs), std::move(tile2InLocs), std::move(tile3InLocs), destTile);
 
             default:
                 std::cerr << BHRED << "Not available connection method." << rstColor << std::endl;
@@ -13,7 +13,8 @@ using json = nlohmann::json;
 class ConnectorMatchInOutSize : public Connector {
 
 public:
-    ConnectorMatchInOutSize(const json &tile1, const json &tile2, json &destTile) : Connector(tile1, tile2, destTile)
+    ConnectorMatchInOutSize(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, TAGraph &destTile) :
+            Connector(std::move(tile1OutLocs), std::move(tile2InLocs), destTile)
     {};
 
 
@@ -28,18 +29,11 @@ public:
      */
     void connectTiles() override
     {
-        // First, let's take the ids necessary for creating a new transition.
-        std::vector<std::string> tile1OutLocs = TAContentExtractor::getNamedLocations(tile1, OUT);
-        std::vector<std::string> tile2InLocs = TAContentExtractor::getNamedLocations(tile2, IN);
-
         // If both the tile1OutLocs and tile2InLocs sizes coincide, for each location in tile1OutLocs a new transition
         // Towards a location in tile2InLocs is created, following the order in which they appear.
         if (tile1OutLocs.size() == tile2InLocs.size())
             for (int i = 0; i < tile1OutLocs.size(); i++)
-            {
-                std::string transitionText { TAContentExtractor::getLocationLabelText(tile2, tile2InLocs[i], COMMENTS) };
-                insertNewTransition(tile1OutLocs[i], tile2InLocs[i], transitionText, ASSIGNMENT);
-            }
+                insertNewTransition(tile1OutLocs[i], tile2InLocs[i]);
         else
             throw ConnectorException("Exception: tiles have different In and Out size for chosen 'match_inout_size' connection method");
     }
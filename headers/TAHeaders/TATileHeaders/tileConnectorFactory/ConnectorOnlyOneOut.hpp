@@ -13,7 +13,8 @@ using json = nlohmann::json;
 class ConnectorOnlyOneOut : public Connector {
 
 public:
-    ConnectorOnlyOneOut(const json &tile1, const json &tile2, json &destTile) : Connector(tile1, tile2, destTile)
+    ConnectorOnlyOneOut(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, TAGraph &destTile) :
+            Connector(std::move(tile1OutLocs), std::move(tile2InLocs), destTile)
     {}
 
 
@@ -26,17 +27,11 @@ public:
      */
     void connectTiles() override
     {
-        // First, let's take the ids necessary for creating a new transition.
-        std::vector<std::string> tile1OutLocs = TAContentExtractor::getNamedLocations(tile1, OUT);
-        std::vector<std::string> tile2InLocs = TAContentExtractor::getNamedLocations(tile2, IN);
-
         // If both the tile1OutLocs and tile2InLocs size it at least one, we connect the first out location of
         // tile1 to the first in location of tile2.
         if (!(tile1OutLocs.empty() || tile2InLocs.empty()))
-        {
-            std::string transitionText { TAContentExtractor::getLocationLabelText(tile2, tile2InLocs[0], COMMENTS) };
-            insertNewTransition(tile1OutLocs[0], tile2InLocs[0], transitionText, ASSIGNMENT);
-        } else
+            insertNewTransition(tile1OutLocs[0], tile2InLocs[0]);
+        else
             throw ConnectorException("Exception: either tile1 or tile2 does not have respectively out or in locations for chosen 'only_one_out' connection method");
     }
 
@@ -8,12 +8,12 @@ using json = nlohmann::json;
 class ConnectorTreeOp : public Connector {
 
 private:
-    // The tile from which the new transitions will join, with out nodes as target.
-    const json &tile3;
+    // The positions in destTile of the in locations of the third tile, in which the new transitions will end.
+    std::vector<uint32_t> tile3InLocs;
 
 public:
-    ConnectorTreeOp(const json &tile1, const json &tile2, const json &tile3, json &destTile) :
-            Connector(tile1, tile2, destTile), tile3(tile3)
+    ConnectorTreeOp(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, std::vector<uint32_t> tile3InLocs, TAGraph &destTile) :
+            Connector(std::move(tile1OutLocs), std::move(tile2InLocs), destTile), tile3InLocs(std::move(tile3InLocs))
     {};
 
 
@@ -30,21 +30,11 @@ public:
      */
     void connectTiles() override
     {
-        // First, let's take the ids necessary for creating a new transition.
-        std::vector<std::string> tile1OutLocs = TAContentExtractor::getNamedLocations(tile1, OUT);
-        std::vector<std::string> tile2InLocs = TAContentExtractor::getNamedLocations(tile2, IN);
-        std::vector<std::string> tile3InLocs = TAContentExtractor::getNamedLocations(tile3, IN);
-
         // If the tile1OutLocs size is equal to 2 and both tile2InLocs and tile3InLocs sizes are equal to 1, we can build a tree.
         if (tile1OutLocs.size() == 2 && tile2InLocs.size() == 1 && tile3InLocs.size() == 1)
         {
-            std::string transitionText {};
-
-            transitionText = TAContentExtractor::getLocationLabelText(tile2, tile2InLocs[0], COMMENTS);
-            insertNewTransition(tile1OutLocs[0], tile2InLocs[0], transitionText, ASSIGNMENT);
-
-            transitionText = TAContentExtractor::getLocationLabelText(tile3, tile3InLocs[0], COMMENTS);
-            insertNewTransition(tile1OutLocs[1], tile3InLocs[0], transitionText, ASSIGNMENT);
+            insertNewTransition(tile1OutLocs[0], tile2InLocs[0]);
+            insertNewTransition(tile1OutLocs[1], tile3InLocs[0]);
         } else
             throw ConnectorException("Exception: cannot build tree for chosen 'tree_op' connection method");
     }
@@ -10,25 +10,25 @@ class TileConnectorFactory {
 public:
     /**
      * Method used to select the way in which two tiles will be connected.
-     * @param tile1 the first tile to be connected.
-     * @param tile2 the second tile to be connected.
-     * @param destTile the destination tile in which the new transition will be added.
+     * @param tile1OutLocs the positions in destTile of the out locations of the first tile to be connected.
+     * @param tile2InLocs the positions in destTile of the in locations of the second tile to be connected.
+     * @param destTile the destination tile, already containing the tiles to connect, in which the new transition will be added.
      * @param method the way in which the new transition(s) will be generated.
      * @return a proper tile connector based on the method parameter.
      */
-    virtual Connector *createConnector(const json &tile1, const json &tile2, json &destTile, TileTokensEnum tk) = 0;
+    virtual Connector *createConnector(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, TAGraph &destTile, TileTokensEnum tk) = 0;
 
 
     /**
      * Method used to select the way in which two tiles will be connected.
-     * @param tile1 the first tile to be connected.
-     * @param tile2 the second tile to be connected.
-     * @param tile3 the third tile to be connected.
-     * @param destTile the destination tile in which the new transition will be added.
+     * @param tile1OutLocs the positions in destTile of the out locations of the first tile to be connected.
+     * @param tile2InLocs the positions in destTile of the in locations of the second tile to be connected.
+     * @param tile3InLocs the positions in destTile of the in locations of the third tile to be connected.
+     * @param destTile the destination tile, already containing the tiles to connect, in which the new transition will be added.
      * @param method the way in which the new transition(s) will be generated.
      * @return a proper tile connector based on the method parameter.
      */
-    virtual Connector *createConnector(const json &tile1, const json &tile2, const json &tile3, json &destTile, TileTokensEnum tk) = 0;
+    virtual Connector *createConnector(std::vector<uint32_t> tile1OutLocs, std::vector<uint32_t> tile2InLocs, std::vector<uint32_t> tile3InLocs, TAGraph &destTile, TileTokensEnum tk) = 0;
 
 };
 
@@ -19,7 +19,13 @@ enum TileTokensEnum {
     lsqparen,
     rsqparen,
     t_barabasi_albert,
-    maybe_tile
+    t_erdos_renyi,
+    t_watts_strogatz,
+    t_layered_dag,
+    maybe_tile,
+    // The following tokens are only produced by the lexer, they never reach the factories.
+    integer_literal,
+    end_of_input
 };
 
 
@@ -44,6 +50,15 @@ TileTokensEnum fromStrTileTokenEnum(std::string_view str)
     } else if (str == "t_barabasi_albert")
     {
         return t_barabasi_albert;
+    } else if (str == "t_erdos_renyi")
+    {
+        return t_erdos_renyi;
+    } else if (str == "t_watts_strogatz")
+    {
+        return t_watts_strogatz;
+    } else if (str == "t_layered_dag")
+    {
+        return t_layered_dag;
     } else if (str == "lsqparen")
     {
         return lsqparen;
@@ -58,4 +73,15 @@ TileTokensEnum fromStrTileTokenEnum(std::string_view str)
 }
 
 
+/**
+ * Function used to tell if a token represents a randomly-generated tile.
+ * @param tk the token to check.
+ * @return true if the token represents a randomly-generated tile, false otherwise.
+ */
+bool isRandomTileToken(TileTokensEnum tk)
+{
+    return tk == t_barabasi_albert || tk == t_erdos_renyi || tk == t_watts_strogatz || tk == t_layered_dag;
+}
+
+
 #endif //UTOTPARSER_TILETOKENSENUM_H
@@ -6,10 +6,22 @@
 #include "nlohmann/json.hpp"
 
 #include "utilities/Utils.hpp"
+#include "TAHeaders/TAContentExtractor.hpp"
+#include "TAHeaders/TAGraph.hpp"
 
 using json = nlohmann::json;
 
 
+/**
+ * Struct representing a directed link of a random network, from the node 'src' to the node 'dst'.
+ * Nodes are referenced by their integer index, starting from 0.
+ */
+typedef struct rnl {
+    int src;
+    int dst;
+} RandomNetworkLink;
+
+
 class RandomCreator {
 
 private:
@@ -56,13 +68,32 @@ private:
     // An integer that will be used to keep new transitions unique.
     int newTransNonce {};
 
+    // The kinds of the labels put on the new transitions, interned once.
+    uint32_t guardKind { TAGraph::internString(GUARD) };
+
+    uint32_t assignmentKind { TAGraph::internString(ASSIGNMENT) };
+
+
+    /**
+     * Method used to add a label to the last transition of a random tile.
+     * @param records the records of the random tile.
+     * @param kind the interned kind of the label.
+     * @param text the text of the label.
+     */
+    static void addLabel(GraphRecords &records, uint32_t kind, const std::string &text)
+    {
+        uint32_t textIndex = TAGraph::internString(text);
+        records.labels.push_back({ kind, textIndex, TAGraph::parseLabel(kind, textIndex) });
+        records.edges.back().labelCount++;
+    }
+
 
     /**
      * Method used to handle the case where only assignments should be added in the new transitions.
-     * @param newTrans the transition in which to add the assignments.
+     * @param records the records of the random tile, whose last transition is the one in which to add the assignments.
      * @param gen a random number generator.
      */
-    void handleSwitchCase0(json &newTrans, std::mt19937 &gen)
+    void handleSwitchCase0(GraphRecords &records, std::mt19937 &gen)
     {
         // Uniform distribution used to select the shape of the assignment.
         std::uniform_int_distribution<int> int_dist_seed(0, 2);
@@ -94,12 +125,7 @@ private:
 
         // If some clock has been assigned, the label must be assigned to the transition.
         if (assignmentSeed <= 1)
-        {
-            newTrans[LABEL] = {
-                    { TEXT, assignmentString },
-                    { KIND, ASSIGNMENT }
-            };
-        }
+            addLabel(records, assignmentKind, assignmentString);
     }
 
 
@@ -193,10 +219,10 @@ private:
     /**
      * Method used to handle the case where a guard only has one clock involved and there may be the possibility
      * of having an assignment for the other clock, hence preserving the nrt property.
-     * @param newTrans the transition in which to add the guard and possibly the assignment.
-     * @param gena random number generator.
+     * @param records the records of the random tile, whose last transition is the one in which to add the guard and possibly the assignment.
+     * @param gen a random number generator.
      */
-    void handleSwitchCase1(json &newTrans, std::mt19937 &gen)
+    void handleSwitchCase1(GraphRecords &records, std::mt19937 &gen)
     {
         // Uniform distribution used to select the shape of the guard.
         std::uniform_int_distribution<int> int_dist(0, static_cast<int>(clockGuards.size()) - 1);
@@ -214,30 +240,21 @@ private:
         // Deciding if to put a guard for the other clock, hence keeping the nrt condition.
         int alsoPutAssignment = int_dist_bool(gen);
 
+        addLabel(records, guardKind, guardString);
         if (alsoPutAssignment)
         {
             assignmentString = subSinS(clockAssignment, "ck", ckChoices[1 - clock]);
-
-            newTrans[LABEL] = {
-                    {{ TEXT, guardString },      { KIND, GUARD }},
-                    {{ TEXT, assignmentString }, { KIND, ASSIGNMENT }}
-            };
-        } else
-        {
-            newTrans[LABEL] = {
-                    { TEXT, guardString },
-                    { KIND, GUARD }
-            };
+            addLabel(records, assignmentKind, assignmentString);
         }
     }
 
 
     /**
      * Method used to handle the case where only a guard involving both clocks should be added in the new transitions.
-     * @param newTrans the transition in which to add the guard.
+     * @param records the records of the random tile, whose last transition is the one in which to add the guard.
      * @param gen a random number generator.
      */
-    void handleSwitchCase2(json &newTrans, std::mt19937 &gen)
+    void handleSwitchCase2(GraphRecords &records, std::mt19937 &gen)
     {
         // Uniform distribution used to select the shape of the guard.
         std::uniform_int_distribution<int> int_dist(0, static_cast<int>(clockGuards.size()) - 1);
@@ -253,10 +270,7 @@ private:
                 + sanitizeGuard(clockGuards[int_dist(gen)], ckChoices[1 - clock], gen)
         };
 
-        newTrans[LABEL] = {
-                { TEXT, guardString },
-                { KIND, GUARD }
-        };
+        addLabel(records, guardKind, guardString);
     }
 
 
@@ -273,15 +287,14 @@ protected:
 
 
     /**
-     * Method used to return a json representation of the initial location.
+     * Method used to get the record of the initial location.
      * Note that it will also be marked as a 'in' location for the tile.
-     * @return a json representation of the initial 'in' location of the tile.
+     * @return the record of the initial 'in' location of the tile.
      */
-    static json getBlankInitialLocation()
+    static GraphLocation getBlankInitialLocation()
     {
-        return {{ ID,    getBlankInitialLocationName() },
-                { LABEL, {{ TEXT, "x = 0; y = 0" }, { KIND, COMMENTS }}},
-                { NAME,  {{ TEXT, "in" }}}};
+        return { TAGraph::internString(getBlankInitialLocationName()), TAGraph::internString(IN), STRING_POOL_NONE, nullptr,
+                 TAGraph::internString("x = 0; y = 0"), false, nullptr };
     }
 
 
@@ -297,19 +310,19 @@ protected:
 
 
     /**
-     * Method used to return a json representation of the 'out' location.
+     * Method used to get the record of the 'out' location.
      * Note that it will also be marked as a 'out' location for the tile.
-     * @return a json representation of the initial 'out' location of the tile.
+     * @return the record of the 'out' location of the tile.
      */
-    static json getBlankOutLocation()
+    static GraphLocation getBlankOutLocation()
     {
-        return {{ ID,   getBlankOutLocationName() },
-                { NAME, {{ TEXT, "out" }}}};
+        return { TAGraph::internString(getBlankOutLocationName()), TAGraph::internString(OUT), STRING_POOL_NONE, nullptr,
+                 STRING_POOL_NONE, false, nullptr };
     }
 
 
     /**
-     * Method used to get a blueprint of an empty tile.
+     * Method used to get a blueprint of an empty tile, which provides the declarations of the random tile.
      * In order to get rid of null values, the corresponding fields should be cleared first (with the .clear() method).
      * Bounds are set to [0, inf) since they're not known for a randomly-generated tile.
      * @return a json representing an empty tile.
@@ -319,7 +332,7 @@ protected:
         json blankTA;
         blankTA[NTA][DECLARATION] = "bound:0:inf";
         blankTA[NTA][TEMPLATE][DECLARATION] = "clock x, y;";
-        blankTA[NTA][TEMPLATE][INIT][REF] = {};
+        blankTA[NTA][TEMPLATE][INIT][REF] = getBlankInitialLocationName();
         blankTA[NTA][TEMPLATE][LOCATION] = {};
         blankTA[NTA][TEMPLATE][TRANSITION] = {};
 
@@ -328,36 +341,32 @@ protected:
 
 
     /**
-     * Method used to get a transition without any label (guard or assignment) on it.
-     * @param srcLoc the source location of the transition.
-     * @param dstLoc the destination location of the transition.
-     * @return a json representation of a transition from 'srcLoc' to 'dstLoc.
+     * Method used to add to a random tile a transition without any label (guard or assignment) on it.
+     * @param records the records of the random tile.
+     * @param srcLoc the position of the source location of the transition.
+     * @param dstLoc the position of the destination location of the transition.
      */
-    json getBlankTransition(const std::string &srcLoc, const std::string &dstLoc)
+    void addBlankTransition(GraphRecords &records, uint32_t srcLoc, uint32_t dstLoc)
     {
-        json newTrans = {
-                { ID,     "newTrans" + std::to_string(newTransNonce) },
-                { SOURCE, {{ REF, srcLoc }}},
-                { TARGET, {{ REF, dstLoc }}}
-        };
+        uint32_t id = TAGraph::internString("newTrans" + std::to_string(newTransNonce));
+        records.edges.push_back({ id, srcLoc, dstLoc, static_cast<uint32_t>(records.labels.size()), 0, nullptr });
 
         ++newTransNonce;
-        return newTrans;
     }
 
 
     /**
-     * Method used to get a transition labeled with guards and assignments (if any).
+     * Method used to add to a random tile a transition labeled with guards and assignments (if any).
      * The respective guard or assignment is randomly generated.
      * In addition, the construction preserves the nrt property of TAs.
-     * @param srcLoc the source location of the transition.
-     * @param dstLoc the destination location of the transition.
+     * @param records the records of the random tile.
+     * @param srcLoc the position of the source location of the transition.
+     * @param dstLoc the position of the destination location of the transition.
      * @param gen a random number generator.
-     * @return a json representation of a transition from 'srcLoc' to 'dstLoc with guards and assignments (if any).
      */
-    json getLabeledTransition(const std::string &srcLoc, const std::string &dstLoc, std::mt19937 &gen)
+    void addLabeledTransition(GraphRecords &records, uint32_t srcLoc, uint32_t dstLoc, std::mt19937 &gen)
     {
-        json newTrans = getBlankTransition(srcLoc, dstLoc);
+        addBlankTransition(records, srcLoc, dstLoc);
 
         // Uniform distribution used to select the shape of the transition.
         std::uniform_int_distribution<int> int_dist(0, 2);
@@ -367,24 +376,75 @@ protected:
         switch (labelSeed)
         {
             case 0: // No clocks in the guard.
-                handleSwitchCase0(newTrans, gen);
+                handleSwitchCase0(records, gen);
                 break;
 
             case 1: // Only one clock in the guard.
-                handleSwitchCase1(newTrans, gen);
+                handleSwitchCase1(records, gen);
                 break;
 
             default: // Both clocks in the guard.
-                handleSwitchCase2(newTrans, gen);
+                handleSwitchCase2(records, gen);
                 break;
         }
+    }
+
+
+    /**
+     * Method used to get a valid string representation for identifiers to use in locations.
+     * @param idNumber the number to associate to the identifier.
+     * @return a string representation of the identifier.
+     */
+    static std::string getValidId(int idNumber)
+    {
+        return "Id" + std::to_string(idNumber);
+    }
+
+
+    /**
+     * Method used to create a random tile from a random network, where each node becomes a location and each link a
+     * transition labeled by addLabeledTransition. In addition, a transition goes from the initial location to one random
+     * node, and another one from one random node to the 'out' location.
+     * The records of the tile are written straight into arrays allocated once, without building its json representation.
+     * @param numNodes the number of nodes of the network.
+     * @param links the links of the network, which become transitions in the same order.
+     * @param gen a random number generator.
+     * @return a graph representation of the random tile.
+     */
+    TAGraph getTileFromNetwork(int numNodes, const std::vector<RandomNetworkLink> &links, std::mt19937 &gen)
+    {
+        GraphRecords records {};
+
+        // The initial and the 'out' locations come first, hence node i is the location at position i + 2.
+        const uint32_t firstNode { 2 };
+        records.locations.reserve(static_cast<size_t>(numNodes) + firstNode);
+        records.locations.push_back(getBlankInitialLocation());
+        records.locations.push_back(getBlankOutLocation());
+        for (int i = 0; i < numNodes; i++)
+            records.locations.push_back({ TAGraph::internString(getValidId(i)), STRING_POOL_NONE, STRING_POOL_NONE, nullptr,
+                                          STRING_POOL_NONE, false, nullptr });
+
+        // Each transition has at most two labels.
+        records.edges.reserve(links.size() + 2);
+        records.labels.reserve(2 * links.size());
+        for (const RandomNetworkLink &link: links)
+            addLabeledTransition(records, static_cast<uint32_t>(link.src) + firstNode, static_cast<uint32_t>(link.dst) + firstNode, gen);
+
+        // Distribution used to extract a random node.
+        std::uniform_int_distribution<int> int_dist(0, numNodes - 1);
+
+        // Extracting a random node so that a transition from the initial node to such random node can be created.
+        addBlankTransition(records, 0, static_cast<uint32_t>(int_dist(gen)) + firstNode);
+
+        // Extracting a random node so that a transition from such random node to the out node can be created.
+        addBlankTransition(records, static_cast<uint32_t>(int_dist(gen)) + firstNode, 1);
 
-        return newTrans;
+        return TAGraph::fromRecords(std::make_shared<const json>(getBlankTA()), std::move(records), 0);
     }
 
 
 public:
-    virtual json createRandomTile() = 0;
+    virtual TAGraph createRandomTile() = 0;
 
 };
 
@@ -2,14 +2,18 @@
 #define UTOTPARSER_RANDOMCREATORBARABASIALBERT_H
 
 #include <random>
+#include <algorithm>
 #include <cassert>
 
 #include "defines/UPPAALxmlAttributes.h"
+#include "utilities/RandomStream.hpp"
 #include "TAHeaders/TAContentExtractor.hpp"
 #include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreator.hpp"
 
 #define PRINT_RESULTING_TA
 
+// Define PRINT_DEGREE_DISTRIBUTION to print the degree distribution of each network (e.g., to check that it follows a power law).
+
 
 class RandomCreatorBarabasiAlbert : public RandomCreator {
 
@@ -32,6 +36,11 @@ private:
     // Each position in the vector represents a node by its integer index.
     std::vector<int> degrees {};
 
+    // A vector containing each node as many times as its degree, i.e., the endpoints of all the links of the network.
+    // Drawing a uniform position of this vector picks a node with probability degree/globalDegree, which is exactly the
+    // preferential attachment, without having to reject any candidate.
+    std::vector<int> endpoints {};
+
     // The global degree defined as the sum of all the single degrees.
     int globalDegree {};
 
@@ -39,17 +48,6 @@ private:
     int maxDegree {};
 
 
-    /**
-     * Method used to get a valid string representation for identifiers to use in locations.
-     * @param idNumber the number to associate to the identifier.
-     * @return a string representation of the identifier.
-     */
-    static std::string getValidId(int idNumber)
-    {
-        return "Id" + std::to_string(idNumber);
-    }
-
-
     /**
      * Method used to print the generated BA network.
      */
@@ -114,6 +112,9 @@ private:
             // Updating the current node's adjacency list.
             adjacencyList.push_back(tmpVec);
 
+            // The node is an endpoint of each of its links.
+            endpoints.insert(endpoints.end(), tmpVec.size(), i);
+
             // Updating current node's degree, global degree and max degree.
             int nodeDegree = static_cast<int>(tmpVec.size());
             degrees.push_back(nodeDegree);
@@ -126,6 +127,8 @@ private:
 
     /**
      * Method used to insert a new node and connect it to the existing nodes by using the preferential attachment technique.
+     * Candidates are drawn from the 'endpoints' vector as it was before inserting the node, hence each one is chosen with
+     * probability proportional to its degree, and only a candidate which has already been chosen has to be drawn again.
      * @param gen a random number generator.
      */
     void insertNode(std::mt19937 &gen)
@@ -135,91 +138,70 @@ private:
         // by taking the size of the adjacency list as the new node index will suffice.
         int newNode = static_cast<int>(adjacencyList.size());
 
-        // Distribution used to extract the probability with which a node will be connected to other nodes.
-        std::uniform_real_distribution<double> double_dist(0.0, 1.0);
-
-        // Distribution used to extract a node which will be connected to other nodes.
-        std::uniform_int_distribution<int> int_dist(0, newNode - 1);
-
-        // The number of chosen nodes in the current iteration of the BA's algorithm.
-        int totalChosenNodes {};
+        // Distribution used to extract an endpoint, i.e., a node with probability proportional to its degree.
+        std::uniform_int_distribution<size_t> endpoint_dist(0, endpoints.size() - 1);
 
         // A vector containing the index of already chosen nodes, so that a node cannot be chosen more than once.
         std::vector<int> alreadyChosenNodes {};
+        alreadyChosenNodes.reserve(m);
 
         // The loop will cycle until there have been inserted exactly 'm' new links.
-        while (totalChosenNodes < m)
+        while (static_cast<int>(alreadyChosenNodes.size()) < m)
         {
-            // A double random number (a probability) that will be used to determine if a new link has to be created or not.
-            double pLink = double_dist(gen);
+            int randomChosenNode = endpoints[endpoint_dist(gen)];
 
-            // A randomly-chosen integer index representing a candidate node to link with the new node.
-            int randomChosenNode = int_dist(gen);
-
-            // A double random number (a probability) representing the probability of creating a new link by preferential attachment.
-            double pNode = static_cast<double>(degrees[randomChosenNode]) / static_cast<double>(globalDegree);
-
-            // If the probabilities allow the connection and the chosen node has not been already chose, a new connection will be created.
-            if (pLink <= pNode && std::find(alreadyChosenNodes.begin(), alreadyChosenNodes.end(), randomChosenNode) == alreadyChosenNodes.end())
-            {
-                // Uncomment the following line if you also want a connection from the random chosen node to the new node.
-                // adjacencyList[randomChosenNode].push_back(newNode);
+            // Looking among at most 'm' nodes, hence in constant time.
+            if (std::find(alreadyChosenNodes.begin(), alreadyChosenNodes.end(), randomChosenNode) == alreadyChosenNodes.end())
+                alreadyChosenNodes.push_back(randomChosenNode);
+        }
 
-                // Still have to update since in the preferential attachment we assume to use the total degree (in + out).
-                degrees[randomChosenNode] += 1;
+        for (int chosenNode: alreadyChosenNodes)
+        {
+            // Uncomment the following line if you also want a connection from the random chosen node to the new node.
+            // adjacencyList[chosenNode].push_back(newNode);
 
-                alreadyChosenNodes.push_back(randomChosenNode);
-                ++totalChosenNodes;
-                ++globalDegree;
+            // Still have to update since in the preferential attachment we assume to use the total degree (in + out).
+            degrees[chosenNode] += 1;
+            endpoints.push_back(chosenNode);
 
-                if (maxDegree < degrees[randomChosenNode])
-                    maxDegree = degrees[randomChosenNode];
-            }
+            if (maxDegree < degrees[chosenNode])
+                maxDegree = degrees[chosenNode];
         }
 
+        // The new node is an endpoint of each of its 'm' links.
+        endpoints.insert(endpoints.end(), m, newNode);
+        globalDegree += 2 * m;
+
         // At the end, we have to push a new list of nodes for the newly created node.
-        adjacencyList.push_back(alreadyChosenNodes);
+        adjacencyList.push_back(std::move(alreadyChosenNodes));
 
         // Also, we have to push back the degree of the new node.
         degrees.push_back(m);
     }
 
 
+#ifdef PRINT_DEGREE_DISTRIBUTION
     /**
      * Method used to compute the degree distribution of the resulting BA network.
      * Use it to test if a power-law distribution arise (few nodes should have high degree, while many nodes should have low degree).
      */
     void computeDegreeDistribution()
     {
-        // The outer pair contains:
-        // - 1st: an integer representing a particular degree found in the network.
-        // - 2nd: a pair containing:
-        //        - 1st: the total number of nodes having such a degree.
-        //        - 2nd: the percentage of nodes having such degree with respect to the entire network.
-        // This is a vector containing the computed network's degree distribution.
-        std::vector<std::pair<int, std::pair<int, double>>> degreeDistribution {};
-
-        // For each integer from 1 to the maximum degree, we look in the network to find some node having such degree.
-        for (int i = 1; i <= maxDegree; i++)
-        {
-            // The total number of nodes having a degree equal to the current value of 'i'.
-            int degreeTotNodes {};
-
-            for (auto &degree: degrees)
-                if (i == degree)
-                    ++degreeTotNodes;
-
-            if (degreeTotNodes > 0)
-                degreeDistribution.emplace_back(i, std::make_pair(degreeTotNodes, static_cast<double>(degreeTotNodes) / static_cast<double>(numNodes)));
-        }
+        // The total number of nodes having each degree, computed with a single pass over the nodes.
+        std::vector<int> degreeTotNodes(maxDegree + 1, 0);
+        for (int degree: degrees)
+            ++degreeTotNodes[degree];
 
         // Printing the degree distribution.
         std::cout << "Now printing degrees distribution.\n";
 
-        for (auto &d: degreeDistribution)
-            std::cout << "Degree " << d.first << "  :  Total nodes = " << d.second.first << "  :  Percentage: " << d.second.second << '\n';
+        for (int i = 1; i <= maxDegree; i++)
+            if (degreeTotNodes[i] > 0)
+                std::cout << "Degree " << i << "  :  Total nodes = " << degreeTotNodes[i]
+                          << "  :  Percentage: " << static_cast<double>(degreeTotNodes[i]) / static_cast<double>(numNodes) << '\n';
         std::cout << '\n';
     }
+#endif
 
 
     /**
@@ -235,10 +217,14 @@ private:
         // The number of newly added links must be at most equal to the number of nodes in the initial network
         assert (m <= m0);
 
+        adjacencyList.reserve(numNodes);
+        degrees.reserve(numNodes);
+        endpoints.reserve(static_cast<size_t>(m0) * (m0 - 1) + static_cast<size_t>(2 * m) * (numNodes - m0));
+
         createInitialNetwork();
 
         // The number of nodes in the initial list must be less than the total number of nodes.
-        assert(adjacencyList.size() < numNodes);
+        assert(adjacencyList.size() < static_cast<size_t>(numNodes));
 
         int totalNodes = static_cast<int>(adjacencyList.size());
 
@@ -249,78 +235,12 @@ private:
         }
 
         // At the end, the adjacency list must contain all nodes requested.
-        assert (adjacencyList.size() == numNodes);
+        assert (adjacencyList.size() == static_cast<size_t>(numNodes));
 
         std::cout << '\n';
+#ifdef PRINT_DEGREE_DISTRIBUTION
         computeDegreeDistribution();
-    }
-
-
-    /**
-     * Method used to insert locations names in the tile.
-     * @param randomTile a json representation of the tile in which to add locations names.
-     */
-    void insertLocationsInRandomTileFromNetwork(json &randomTile)
-    {
-        // Setting the initial location.
-        randomTile.at(NTA).at(TEMPLATE).at(INIT).at(REF) = getBlankInitialLocationName();
-
-        // Inserting the initial location.
-        json *locationsPtr = getJsonPtrAsArray(TAContentExtractor::getLocationsPtr(randomTile));
-        // Since no locations are still present, clearing makes the 'null' value disappear.
-        locationsPtr->clear();
-
-        locationsPtr->push_back(getBlankInitialLocation());
-        locationsPtr->push_back(getBlankOutLocation());
-
-        for (int i = 0; i < adjacencyList.size(); i++)
-            locationsPtr->push_back({{ ID, getValidId(i) }});
-    }
-
-
-    /**
-     * Method used to insert additional transitions:
-     * - From the initial location to one random location in the tile.
-     * - From one random location in the tile to the output location.
-     * @param transitionPtr a pointer tp the transition section of the tile.
-     * @param gen a random number generator.
-     */
-    void connectInAndOut(json *transitionPtr, std::mt19937 &gen)
-    {
-        // Distribution used to extract a random node.
-        std::uniform_int_distribution<int> int_dist(0, static_cast<int>(adjacencyList.size()) - 1);
-
-        // Extracting a random node so that a transition from the initial node to such random node can be created.
-        int randomNode = int_dist(gen);
-        transitionPtr->push_back(getBlankTransition(getBlankInitialLocationName(), getValidId(randomNode)));
-
-        // Extracting a random node so that a transition from such random node to the out node can be created.
-        randomNode = int_dist(gen);
-        transitionPtr->push_back(getBlankTransition(getValidId(randomNode), getBlankOutLocationName()));
-    }
-
-
-    /**
-     * Method used to insert the transitions in the random tile.
-     * @param randomTile a json representation of the tile in which to add the transitions.
-     * @param gen a random number generator.
-     */
-    void insertTransitionsInRandomTileFromNetwork(json &randomTile, std::mt19937 &gen)
-    {
-        json *transitionsPtr = getJsonPtrAsArray(TAContentExtractor::getTransitionsPtr(randomTile));
-        // Since no transitions are still present, clearing makes the 'null' value disappear.
-        transitionsPtr->clear();
-
-        for (int i = 0; i < adjacencyList.size(); i++)
-        {
-            for (auto &neighbor: adjacencyList[i])
-            {
-                std::string srcLoc = getValidId(i);
-                std::string dstLoc = getValidId(neighbor);
-                transitionsPtr->push_back(getLabeledTransition(srcLoc, dstLoc, gen));
-            }
-        }
-        connectInAndOut(transitionsPtr, gen);
+#endif
     }
 
 
@@ -336,24 +256,28 @@ public:
 
     /**
      * Method used to create a random tile using the Barabasi-Albert algorithm.
-     * @return a json representation of a random tile created using the Barabasi-Albert algorithm.
+     * The network takes O(m) time per node (a few tens of ms for 200000 nodes), while most of the time is spent interning
+     * the names of the locations and of the (about 2 * numNodes) transitions of the tile.
+     * @return a graph representation of a random tile created using the Barabasi-Albert algorithm.
      */
-    json createRandomTile() override
+    TAGraph createRandomTile() override
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        std::mt19937 &gen = RandomStream::getGenerator();
 
         createBANetwork(gen);
 
-        json randomTile = getBlankTA();
-
-        insertLocationsInRandomTileFromNetwork(randomTile);
+        // Each node has a link towards each node of its adjacency list.
+        std::vector<RandomNetworkLink> links {};
+        links.reserve(static_cast<size_t>(globalDegree / 2));
+        for (size_t i = 0; i < adjacencyList.size(); i++)
+            for (int neighbor: adjacencyList[i])
+                links.push_back({ static_cast<int>(i), neighbor });
 
-        insertTransitionsInRandomTileFromNetwork(randomTile, gen);
+        TAGraph randomTile = getTileFromNetwork(static_cast<int>(adjacencyList.size()), links, gen);
 
 #ifndef PRINT_RESULTING_TA
         std::cout << "\nResultingTiledTA:\n";
-        std::cout << std::setw(4) << randomTile << std::endl;
+        std::cout << std::setw(4) << randomTile.toJson() << std::endl;
 #endif
 
         return randomTile;
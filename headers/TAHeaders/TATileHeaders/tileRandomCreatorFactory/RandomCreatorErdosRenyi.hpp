@@ -0,0 +1,86 @@
+#ifndef UTOTPARSER_RANDOMCREATORERDOSRENYI_H
+#define UTOTPARSER_RANDOMCREATORERDOSRENYI_H
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+#include "utilities/RandomStream.hpp"
+#include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreator.hpp"
+
+
+class RandomCreatorErdosRenyi : public RandomCreator {
+
+private:
+    // The total number of nodes the resulting random network will have.
+    int numNodes {};
+
+    // The expected number of links leaving each node, from which the probability of each link is derived.
+    // Keeping it constant makes the number of links linear in the number of nodes.
+    double meanOutDegree { 2.0 };
+
+    // The links of the network.
+    std::vector<RandomNetworkLink> links {};
+
+
+    /**
+     * Method used to create a directed G(n, p) network, where each of the n * (n - 1) possible links (self-loops excluded)
+     * is present with probability p.
+     * Instead of drawing once per possible link, the number of links to skip before the next present one is drawn from
+     * a geometric distribution, hence the network is created in O(n + m) time, with m the number of links.
+     * @param gen a random number generator.
+     */
+    void createERNetwork(std::mt19937 &gen)
+    {
+        std::cout << "\nCreating random Erdos-Renyi tile.\n";
+
+        double p = std::min(1.0, meanOutDegree / static_cast<double>(numNodes - 1));
+
+        uint64_t possibleLinks = static_cast<uint64_t>(numNodes) * static_cast<uint64_t>(numNodes - 1);
+        links.reserve(static_cast<size_t>(static_cast<double>(possibleLinks) * p * 1.1) + 1);
+
+        // Possible links are numbered row by row: link k goes from node k / (n - 1) to the (k % (n - 1))-th of the other nodes.
+        std::geometric_distribution<uint64_t> skip_dist(p);
+        for (uint64_t k = skip_dist(gen); k < possibleLinks; k += 1 + skip_dist(gen))
+        {
+            int src = static_cast<int>(k / (numNodes - 1));
+            int dst = static_cast<int>(k % (numNodes - 1));
+
+            // Skipping the node itself, since self-loops are excluded.
+            if (dst >= src)
+                ++dst;
+
+            links.push_back({ src, dst });
+        }
+
+        std::cout << "Created " << links.size() << " links between " << numNodes << " nodes.\n";
+    }
+
+
+public:
+    explicit RandomCreatorErdosRenyi(int syntaxParameter)
+    {
+        if (syntaxParameter > 4)
+            numNodes = syntaxParameter;
+        else
+            numNodes = 4;
+    }
+
+
+    /**
+     * Method used to create a random tile using the Erdos-Renyi G(n, p) model.
+     * @return a graph representation of a random tile created using the Erdos-Renyi G(n, p) model.
+     */
+    TAGraph createRandomTile() override
+    {
+        std::mt19937 &gen = RandomStream::getGenerator();
+
+        createERNetwork(gen);
+
+        return getTileFromNetwork(numNodes, links, gen);
+    }
+
+};
+
+
+#endif //UTOTPARSER_RANDOMCREATORERDOSRENYI_H
@@ -1,10 +1,14 @@
 #ifndef UTOTPARSER_RANDOMCREATORFACTORY_H
 #define UTOTPARSER_RANDOMCREATORFACTORY_H
 
+#include "TAHeaders/TATileHeaders/CompositionArena.hpp"
 #include "TAHeaders/TATileHeaders/tileEnums/TileTokensEnum.h"
 #include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/TileRandomCreatorFactory.hpp"
 #include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreator.hpp"
 #include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreatorBarabasiAlbert.hpp"
+#include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreatorErdosRenyi.hpp"
+#include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreatorWattsStrogatz.hpp"
+#include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreatorLayeredDAG.hpp"
 
 
 class RandomCreatorFactory : public TileRandomCreatorFactory {
@@ -17,7 +21,16 @@ public:
         switch (tk)
         {
             case t_barabasi_albert:
-                return new RandomCreatorBarabasiAlbert(syntaxParameter);
+                return CompositionArena::create<RandomCreatorBarabasiAlbert>(syntaxParameter);
+
+            case t_erdos_renyi:
+                return CompositionArena::create<RandomCreatorErdosRenyi>(syntaxParameter);
+
+            case t_watts_strogatz:
+                return CompositionArena::create<RandomCreatorWattsStrogatz>(syntaxParameter);
+
+            case t_layered_dag:
+                return CompositionArena::create<RandomCreatorLayeredDAG>(syntaxParameter);
 
             default:
                 std::cerr << BHRED << "Not available token." << rstColor << std::endl;
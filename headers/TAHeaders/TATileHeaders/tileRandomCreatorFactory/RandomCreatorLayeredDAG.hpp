@@ -0,0 +1,105 @@
+#ifndef UTOTPARSER_RANDOMCREATORLAYEREDDAG_H
+#define UTOTPARSER_RANDOMCREATORLAYEREDDAG_H
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "utilities/RandomStream.hpp"
+#include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreator.hpp"
+
+
+class RandomCreatorLayeredDAG : public RandomCreator {
+
+private:
+    // The total number of nodes the resulting random network will have.
+    int numNodes {};
+
+    // The number of nodes of each layer, computed from the total number of nodes (the last layer may have fewer nodes).
+    int layerWidth {};
+
+    // The number of links leaving each node towards the following layer.
+    int forwardLinks { 2 };
+
+    // The probability with which a node also has a back link towards a node of a previous layer, closing a cycle.
+    double backLinkProbability { 0.05 };
+
+    // The links of the network.
+    std::vector<RandomNetworkLink> links {};
+
+
+    /**
+     * Method used to create a layered DAG with some back links: nodes are split into layers of 'layerWidth' nodes, each node
+     * is linked to 'forwardLinks' distinct random nodes of the following layer and, with probability 'backLinkProbability',
+     * to a random node of a previous layer.
+     * Without back links every strongly connected component is a single node, while back links close cycles across the layers they span.
+     * @param gen a random number generator.
+     */
+    void createDAGNetwork(std::mt19937 &gen)
+    {
+        std::cout << "\nCreating random layered DAG tile.\n";
+
+        links.reserve(static_cast<size_t>(numNodes) * (forwardLinks + 1));
+
+        std::bernoulli_distribution back_dist(backLinkProbability);
+
+        for (int layerStart = 0; layerStart < numNodes; layerStart += layerWidth)
+        {
+            int nextStart = layerStart + layerWidth;
+            int nextWidth = std::max(0, std::min(layerWidth, numNodes - nextStart));
+
+            // The nodes of the following layer (none for the last one), partially shuffled for each node in order to pick distinct ones.
+            std::vector<int> nextLayer {};
+            for (int node = nextStart; node < nextStart + nextWidth; node++)
+                nextLayer.push_back(node);
+            int nodeLinks = std::min(forwardLinks, nextWidth);
+
+            for (int node = layerStart; node < std::min(nextStart, numNodes); node++)
+            {
+                for (int l = 0; l < nodeLinks; l++)
+                {
+                    std::uniform_int_distribution<int> pick_dist(l, nextWidth - 1);
+                    std::swap(nextLayer[l], nextLayer[pick_dist(gen)]);
+                    links.push_back({ node, nextLayer[l] });
+                }
+
+                if (layerStart > 0 && back_dist(gen))
+                {
+                    std::uniform_int_distribution<int> back_node_dist(0, layerStart - 1);
+                    links.push_back({ node, back_node_dist(gen) });
+                }
+            }
+        }
+    }
+
+
+public:
+    explicit RandomCreatorLayeredDAG(int syntaxParameter)
+    {
+        if (syntaxParameter > 4)
+            numNodes = syntaxParameter;
+        else
+            numNodes = 4;
+
+        // Layers as wide as the DAG is deep.
+        layerWidth = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(numNodes))));
+    }
+
+
+    /**
+     * Method used to create a random tile shaped as a layered DAG with back links.
+     * @return a graph representation of a random tile shaped as a layered DAG with back links.
+     */
+    TAGraph createRandomTile() override
+    {
+        std::mt19937 &gen = RandomStream::getGenerator();
+
+        createDAGNetwork(gen);
+
+        return getTileFromNetwork(numNodes, links, gen);
+    }
+
+};
+
+
+#endif //UTOTPARSER_RANDOMCREATORLAYEREDDAG_H
@@ -0,0 +1,97 @@
+#ifndef UTOTPARSER_RANDOMCREATORWATTSSTROGATZ_H
+#define UTOTPARSER_RANDOMCREATORWATTSSTROGATZ_H
+
+#include <algorithm>
+#include <random>
+
+#include "utilities/RandomStream.hpp"
+#include "TAHeaders/TATileHeaders/tileRandomCreatorFactory/RandomCreator.hpp"
+
+
+class RandomCreatorWattsStrogatz : public RandomCreator {
+
+private:
+    // The total number of nodes the resulting random network will have.
+    int numNodes {};
+
+    // The number of links leaving each node in the initial ring lattice, towards the nodes following it on the ring.
+    int k { 2 };
+
+    // The probability with which each link of the ring lattice is rewired towards a random node.
+    double beta { 0.1 };
+
+    // The links of the network.
+    std::vector<RandomNetworkLink> links {};
+
+
+    /**
+     * Method used to create a directed small-world network: nodes are placed on a ring, each one linked to the 'k' nodes
+     * following it, and then each link is rewired with probability 'beta' towards a random node, avoiding self-loops and
+     * links already leaving the same node.
+     * @param gen a random number generator.
+     */
+    void createWSNetwork(std::mt19937 &gen)
+    {
+        std::cout << "\nCreating random Watts-Strogatz tile.\n";
+
+        // The ring lattice needs at least one node more than the links leaving each node.
+        int nodeLinks = std::min(k, numNodes - 1);
+        links.reserve(static_cast<size_t>(numNodes) * nodeLinks);
+
+        std::bernoulli_distribution rewire_dist(beta);
+        std::uniform_int_distribution<int> node_dist(0, numNodes - 1);
+
+        for (int i = 0; i < numNodes; i++)
+        {
+            // The links leaving the current node are the last 'nodeLinks' ones.
+            size_t first = links.size();
+
+            for (int j = 1; j <= nodeLinks; j++)
+                links.push_back({ i, (i + j) % numNodes });
+
+            for (size_t l = first; l < links.size(); l++)
+            {
+                if (!rewire_dist(gen))
+                    continue;
+
+                // Looking among at most 'k' links, hence in constant time.
+                auto isLinked = [&](int node) {
+                    return std::any_of(links.begin() + static_cast<long>(first), links.end(), [node](const RandomNetworkLink &link) { return link.dst == node; });
+                };
+
+                int dst = node_dist(gen);
+                while (dst == i || isLinked(dst))
+                    dst = node_dist(gen);
+                links[l].dst = dst;
+            }
+        }
+    }
+
+
+public:
+    explicit RandomCreatorWattsStrogatz(int syntaxParameter)
+    {
+        if (syntaxParameter > 4)
+            numNodes = syntaxParameter;
+        else
+            numNodes = 4;
+    }
+
+
+    /**
+     * Method used to create a random tile using the Watts-Strogatz small-world model.
+     * @return a graph representation of a random tile created using the Watts-Strogatz small-world model.
+     */
+    TAGraph createRandomTile() override
+    {
+        std::mt19937 &gen = RandomStream::getGenerator();
+
+        createWSNetwork(gen);
+
+        return getTileFromNetwork(numNodes, links, gen);
+    }
+
+};
+
+
+#endif //UTOTPARSER_RANDOMCREATORWATTSSTROGATZ_H
@@ -0,0 +1,221 @@
+#ifndef UTOTPARSER_TAXMLCONVERTER_HPP
+#define UTOTPARSER_TAXMLCONVERTER_HPP
+
+#include <algorithm>
+#include <string_view>
+
+#include "TAHeaders/TAGraph.hpp"
+#include "defines/UPPAALxmlAttributes.h"
+#include "defines/ANSI-color-codes.h"
+#include "utilities/OutputBuffer.hpp"
+
+
+// Conversion of a TA to UPPAAL's xml format.
+// ------------------------------------------
+// The xml file is streamed straight from the graph, as it happens with the .tck and .dot files, hence composed TAs with
+// millions of locations are converted without ever building their json representation. The file only contains what
+// TAGraph::fromJson reads back: the converter gives the same TA it would give starting from the json of the graph.
+// Since xml2json turns elements with neither attributes nor children into plain strings, the names of the locations
+// and of the template are given (meaningless) coordinates, as UPPAAL does, so that they are always read as objects.
+
+class TAXmlConverter {
+
+private:
+    const std::string outFilePath;
+
+    // The color given to final locations, the same used by the tiles.
+    static const std::string finalLocationColor;
+
+
+    /**
+     * Method used to write a text escaping the characters that cannot appear in xml text and attributes.
+     * @param text the text to write.
+     * @param out the buffer in which to write the file.
+     */
+    static void writeEscaped(std::string_view text, OutputBuffer &out)
+    {
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            std::string_view entity {};
+            switch (text[i])
+            {
+                case '&':
+                    entity = "&amp;";
+                    break;
+                case '<':
+                    entity = "&lt;";
+                    break;
+                case '>':
+                    entity = "&gt;";
+                    break;
+                case '"':
+                    entity = "&quot;";
+                    break;
+                default:
+                    continue;
+            }
+            out << text.substr(start, i - start) << entity;
+            start = i + 1;
+        }
+        out << text.substr(start);
+    }
+
+
+    /**
+     * Method used to write a label of a location or of a transition.
+     * @param kind the kind of the label (e.g., guard or invariant).
+     * @param text the text of the label.
+     * @param indentation the indentation of the label.
+     * @param out the buffer in which to write the file.
+     */
+    static void writeLabel(const std::string &kind, const std::string &text, std::string_view indentation, OutputBuffer &out)
+    {
+        out << indentation << "<label kind=\"";
+        writeEscaped(kind, out);
+        out << "\">";
+        writeEscaped(text, out);
+        out << "</label>\n";
+    }
+
+
+    /**
+     * Method used to write the locations of the TA and its initial location.
+     * The names of the ports which have been used to connect tiles are not written, as in TAGraph::toJson.
+     * @param ta the graph representation of the TA.
+     * @param out the buffer in which to write the file.
+     */
+    static void writeLocations(const TAGraph &ta, OutputBuffer &out)
+    {
+        const std::vector<uint32_t> inPorts = ta.getSortedPorts(IN);
+        const std::vector<uint32_t> outPorts = ta.getSortedPorts(OUT);
+
+        ta.forEachLocation([&](uint32_t i, const GraphLocation &location) {
+            out << "\t\t<location id=\"";
+            ta.writeLocationName(out, i);
+            out << "\" x=\"0\" y=\"0\"";
+            if (location.isFinal)
+                out << " color=\"" << finalLocationColor << '"';
+            out << ">\n";
+
+            if (location.name != STRING_POOL_NONE)
+            {
+                const std::string &name = TAGraph::getString(location.name);
+                const std::vector<uint32_t> *ports = (name == IN) ? &inPorts : (name == OUT) ? &outPorts : nullptr;
+                if (!ports || std::binary_search(ports->begin(), ports->end(), i))
+                {
+                    out << "\t\t\t<name x=\"0\" y=\"0\">";
+                    writeEscaped(name, out);
+                    out << "</name>\n";
+                }
+            }
+
+            if (location.invariant != STRING_POOL_NONE)
+                writeLabel(INVARIANT, TAGraph::getString(location.invariant), "\t\t\t", out);
+            if (location.comments != STRING_POOL_NONE)
+                writeLabel(COMMENTS, TAGraph::getString(location.comments), "\t\t\t", out);
+
+            out << "\t\t</location>\n";
+            out.flushIfFull();
+        });
+
+        if (ta.getInitialLocation() != STRING_POOL_NONE)
+        {
+            out << "\t\t<init ref=\"";
+            ta.writeLocationName(out, ta.getInitialLocation());
+            out << "\"/>\n";
+        }
+    }
+
+
+    /**
+     * Method used to write the transitions of the TA.
+     * @param ta the graph representation of the TA.
+     * @param out the buffer in which to write the file.
+     */
+    static void writeTransitions(const TAGraph &ta, OutputBuffer &out)
+    {
+        ta.forEachEdge([&](uint32_t position, const GraphEdge &transition) {
+            out << "\t\t<transition id=\"" << ta.getEdgeName(position) << "\">\n";
+
+            out << "\t\t\t<source ref=\"";
+            ta.writeLocationName(out, transition.source);
+            out << "\"/>\n";
+
+            out << "\t\t\t<target ref=\"";
+            ta.writeLocationName(out, transition.target);
+            out << "\"/>\n";
+
+            for (uint32_t i = 0; i < transition.labelCount; i++)
+            {
+                const GraphLabel &label = ta.getLabel(transition, i);
+                writeLabel(TAGraph::getString(label.kind), TAGraph::getString(label.text), "\t\t\t", out);
+            }
+
+            out << "\t\t</transition>\n";
+            out.flushIfFull();
+        });
+    }
+
+
+public:
+    explicit TAXmlConverter(std::string outFilePath) : outFilePath(std::move(outFilePath))
+    {}
+
+
+    /**
+     * Method used to translate a TA to UPPAAL's xml format.
+     * @param systemName the name of the system to translate, used as the name of its template.
+     * @param ta the graph representation of the TA.
+     * @return true if the file has been written, false otherwise.
+     */
+    bool translateTAtoXml(const std::string &systemName, const TAGraph &ta)
+    {
+        // A rough estimate of the size of the xml file, so that the buffer is (almost) never reallocated.
+        // Since the buffer is written out whenever it is full, its size is bounded even for huge TAs.
+        OutputBuffer out(std::min<size_t>(OUTPUT_BUFFER_DEFAULT_CAPACITY + 128 * ta.getLocationCount() + 192 * ta.getEdgeCount(),
+                                          OUTPUT_BUFFER_FLUSH_THRESHOLD + OUTPUT_BUFFER_DEFAULT_CAPACITY));
+        bool isStreaming = out.startStreaming(outFilePath);
+
+        std::cout << "Writing declarations." << std::endl;
+        out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+        out << "<!DOCTYPE nta PUBLIC '-//Uppaal Team//DTD Flat System 1.6//EN' 'http://www.it.uu.se/research/group/darts/uppaal/flat-1_6.dtd'>\n";
+        out << "<nta>\n";
+        out << "\t<declaration>";
+        writeEscaped(ta.getDeclaration(), out);
+        out << "</declaration>\n";
+        out << "\t<template>\n";
+        out << "\t\t<name x=\"0\" y=\"0\">";
+        writeEscaped(systemName, out);
+        out << "</name>\n";
+        out << "\t\t<declaration>";
+        writeEscaped(ta.getClocksDeclaration(), out);
+        out << "</declaration>\n";
+
+        std::cout << "Writing locations." << std::endl;
+        writeLocations(ta, out);
+
+        std::cout << "Writing transitions." << std::endl;
+        writeTransitions(ta, out);
+
+        out << "\t</template>\n";
+        out << "\t<system>Process = ";
+        writeEscaped(systemName, out);
+        out << "();\nsystem Process;\n</system>\n";
+        out << "</nta>\n";
+
+        if (isStreaming && out.finishStreaming())
+            return true;
+
+        std::cerr << BHRED << "Failed to write file: " << outFilePath << rstColor << std::endl;
+        return false;
+    }
+
+};
+
+
+// Defining static attributes.
+const std::string TAXmlConverter::finalLocationColor { "#ffa500" };
+
+
+#endif //UTOTPARSER_TAXMLCONVERTER_HPP
@@ -12,8 +12,12 @@
 
 #include "XMLtoJSONInclude/xml2json.hpp"
 #include "utilities/JsonHelper.hpp"
+#include "utilities/OutputBuffer.hpp"
 #include "defines/UPPAALxmlAttributes.h"
+#include "defines/ANSI-color-codes.h"
 #include "TAContentExtractor.hpp"
+#include "TALabelParser.hpp"
+#include "TAGraph.hpp"
 #include "utilities/Utils.hpp"
 
 using json = nlohmann::json;
@@ -41,9 +45,9 @@ private:
      * Method used to write the clocks declarations in tChecker syntax.
      * Up to now, we consider only single clocks (not arrays of clocks).
      * @param declaration the string coming from the UPPAAL .xml file containing the list of clocks.
-     * @param out the stream where we write our output file.
+     * @param out the buffer where we write our output file.
      */
-    void writeClocksDeclarations(const std::string &declaration, std::ofstream &out)
+    void writeClocksDeclarations(const std::string &declaration, OutputBuffer &out)
     {
         if (declaration.find(CLOCK) != std::string::npos)
         {
@@ -51,14 +55,13 @@ private:
 
             for (auto &clock: clocks)
             {
-                out << "clock:1:" << clock << std::endl;
+                out << "clock:1:" << clock << '\n';
                 // The fictitious clock's name is obtained by concatenation of the other clocks in order to avoid name clashes.
                 fictitiousClock.append(clock);
             }
-            out << "clock:1:" << fictitiousClock << std::endl;
+            out << "clock:1:" << fictitiousClock << '\n';
 
-            out << "\n";
-            out.flush();
+            out << '\n';
         }
     }
 
@@ -66,141 +69,138 @@ private:
     /**
     * Method used to write the locations declarations in tChecker syntax.
     * @param processName the name of the process (up to now we only assume one process).
-    * @param initialLocation the name of the TA's initial location.
-    * @param locations the TA's locations saved in json format.
-    * @param out the stream where we write our output file.
+    * @param ta the graph representation of the TA.
+    * @param out the buffer where we write our output file.
     */
-    void writeLocationsDeclarations(const std::string &processName, const std::string &initialLocation, json locations, std::ofstream &out)
+    void writeLocationsDeclarations(const std::string &processName, const TAGraph &ta, OutputBuffer &out)
     {
         // We get the number of states.
-        Q = static_cast<int>(locations.size());
+        Q = static_cast<int>(ta.getLocationCount());
 
-        for (auto &location: locations)
-        {
+        ta.forEachLocation([&](uint32_t i, const GraphLocation &location) {
             bool isInitial = false, hasInvariant = false;
-            std::string outString = "location:" + processName + ":" + static_cast<std::string>(location.at(ID)) + "{";
+            out << "location:" << processName << ':';
+            ta.writeLocationName(out, i);
+            out << '{';
 
-            if (static_cast<std::string>(location.at(ID)) == initialLocation)
+            if (i == ta.getInitialLocation())
             {
-                outString.append("initial:");
+                out << "initial:";
                 isInitial = true;
             }
 
             // Here we check if the location has some invariants.
-            if (location.contains(LABEL) && location.at(LABEL).contains(KIND))
+            if (location.invariant != STRING_POOL_NONE)
             {
-                std::string labelKind = static_cast<std::string>(location.at(LABEL).at(KIND));
-                if (labelKind == INVARIANT)
-                {
-                    (isInitial) ? outString.append(" : ") : outString;
-                    std::string labelText = static_cast<std::string>(location.at(LABEL).at(TEXT));
+                if (isInitial)
+                    out << " : ";
+                const auto &labelText = TAGraph::getString(location.invariant);
 
-                    // We have to check if C will eventually be updated due to the invariant's constant.
-                    int newMax = getMaxIntFromStr(labelText);
-                    C = (C < newMax) ? newMax : C;
+                // We have to check if C will eventually be updated due to the invariant's constant.
+                int newMax = location.invariantExpression->maxConstant;
+                C = (C < newMax) ? newMax : C;
 
-                    outString.append(labelKind + ": ");
-                    outString.append(labelText);
-                    hasInvariant = true;
-                }
+                out << INVARIANT << ": " << labelText;
+                hasInvariant = true;
             }
 
             // We use the convention where a color in a state means that the state is final.
             // For this reason, only final states must have a color when designed in UPPAAL.
-            if (location.contains(COLOR))
+            if (location.isFinal)
             {
-                (isInitial || hasInvariant) ? outString.append(" : ") : outString;
-                outString.append("labels: final");
+                if (isInitial || hasInvariant)
+                    out << " : ";
+                out << "labels: final";
             }
 
-            outString.append("}\n");
-            out << outString;
-        }
-        out.flush();
+            out << "}\n";
+            out.flushIfFull();
+        });
     }
 
 
     /**
      * Method used to write the transitions declarations in tChecker syntax.
      * @param processName the name of the process (up to now we only assume one process).
-     * @param transitions the TA's transitions saved in json format.
-     * @param out the stream where we write our output file.
+     * @param ta the graph representation of the TA.
+     * @param out the buffer where we write our output file.
      */
-    void writeTransitionsDeclarations(const std::string &processName, json transitions, std::ofstream &out)
+    void writeTransitionsDeclarations(const std::string &processName, const TAGraph &ta, OutputBuffer &out)
     {
-        for (auto &transition: transitions)
-        {
+        ta.forEachEdge([&](uint32_t, const GraphEdge &transition) {
             bool putColon = false;
-            std::string outString =
-                    "edge:" + processName + ":" + static_cast<std::string>(transition.at(SOURCE).at(REF)) +
-                    ":" + static_cast<std::string>(transition.at(TARGET).at(REF)) + ":" + "a" + "{";
+            out << "edge:" << processName << ':';
+            ta.writeLocationName(out, transition.source);
+            out << ':';
+            ta.writeLocationName(out, transition.target);
+            out << ":a{";
 
-            if (transition.contains(LABEL))
+            if (transition.labelCount > 0)
             {
-                json labels = getJsonAsArray(transition.at(LABEL));
-                std::string labelKind = static_cast<std::string>(labels.front().at(KIND));
+                const auto &labelKind = TAGraph::getString(ta.getLabel(transition, 0).kind);
 
                 // The following checks are used to insert the fictitious clock based on the content of the transition.
-                if (labels.size() == 1 && labelKind == GUARD)
+                if (transition.labelCount == 1 && labelKind == GUARD)
                 {
                     // We have only guards and no assignments in a transition.
-                    writeTransitionsDeclarations_helper(outString, labels, putColon);
-                    outString.append(" : do: " + fictitiousClock + " = 0");
-                } else if (labels.size() == 1 && labelKind == ASSIGNMENT)
+                    writeTransitionsDeclarations_helper(out, ta, transition, putColon);
+                    out << " : do: " << fictitiousClock << " = 0";
+                } else if (transition.labelCount == 1 && labelKind == ASSIGNMENT)
                 {
                     // We have only assignments and no guards in a transition.
-                    outString.append("provided: " + fictitiousClock + " > 0");
+                    out << "provided: " << fictitiousClock << " > 0";
                     putColon = true;
-                    writeTransitionsDeclarations_helper(outString, labels, putColon);
-                } else if (labels.size() == 2)
+                    writeTransitionsDeclarations_helper(out, ta, transition, putColon);
+                } else if (transition.labelCount == 2)
                 {
                     // We have both guards and assignments in a transition.
-                    writeTransitionsDeclarations_helper(outString, labels, putColon);
+                    writeTransitionsDeclarations_helper(out, ta, transition, putColon);
                 }
             } else
             {
                 // If no guards or assignments are present, we still have to preserve the strictly monotonic time.
-                outString.append("provided: " + fictitiousClock + " > 0 : do: " + fictitiousClock + " = 0");
+                out << "provided: " << fictitiousClock << " > 0 : do: " << fictitiousClock << " = 0";
             }
 
-            outString.append("}\n");
-            out << outString;
-        }
-        out.flush();
+            out << "}\n";
+            out.flushIfFull();
+        });
     }
 
 
     /**
      * Helper method used inside writeTransitionsDeclarations().
-     * @param outString the string that will be written in the output file.
-     * @param labels a vector containing all the labels of a transition (if any).
+     * @param out the buffer where we write our output file.
+     * @param ta the graph representation of the TA.
+     * @param transition the transition whose labels have to be written.
      * @param putColon a boolean used to determine if in the tChecker translation we have to put a colon.
      */
-    void writeTransitionsDeclarations_helper(std::string &outString, std::vector<json> labels, bool &putColon)
+    void writeTransitionsDeclarations_helper(OutputBuffer &out, const TAGraph &ta, const GraphEdge &transition, bool &putColon)
     {
-        for (auto &label: labels)
+        for (uint32_t i = 0; i < transition.labelCount; i++)
         {
-            std::string labelText = static_cast<std::string>(label.at(TEXT));
-            std::string labelKind = static_cast<std::string>(label.at(KIND));
+            const GraphLabel &label = ta.getLabel(transition, i);
+            const auto &labelText = TAGraph::getString(label.text);
+            const auto &labelKind = TAGraph::getString(label.kind);
 
             if (labelKind == GUARD)
             {
                 // We have to check if C will eventually be updated due to the transition's guard.
-                int newMax = getMaxIntFromStr(labelText);
+                int newMax = label.expression->maxConstant;
                 C = (C < newMax) ? newMax : C;
-                (putColon) ? outString.append(" : ") : outString;
-                outString.append("provided: ");
+                if (putColon)
+                    out << " : ";
                 // We add the condition 'fictitiousClock > 0' to ensure the transition takes some time to fire.
-                outString.append(labelText + " && " + fictitiousClock + " > 0");
+                out << "provided: " << labelText << " && " << fictitiousClock << " > 0";
                 putColon = true;
             }
             if (labelKind == ASSIGNMENT)
             {
-                (putColon) ? outString.append(" : ") : outString;
-                outString.append("do: ");
-                std::replace(labelText.begin(), labelText.end(), ',', ';');
+                if (putColon)
+                    out << " : ";
+                out << "do: " << label.expression->tCheckerText;
                 // We add the condition 'fictitiousClock = 0' to ensure the next transition will take some time to fire.
-                outString.append(labelText + "; " + fictitiousClock + " = 0");
+                out << "; " << fictitiousClock << " = 0";
                 putColon = true;
             }
         }
@@ -214,89 +214,106 @@ public:
 
     /**
     * This method performs the translation from UPPAAL syntax to tChecker syntax.
+    * The translation is streamed to the output file while it is built, in chunks of OUTPUT_BUFFER_FLUSH_THRESHOLD bytes.
     * @param systemName the name of the system to translate.
-    * @param inFile the json file containing the UPPAAL representation to convert.
+    * @param ta the graph representation of the TA to convert.
+    * @return true if the file has been written, false otherwise.
     */
-    void translateTA(const std::string &systemName, const json &inFile)
+    bool translateTA(const std::string &systemName, const TAGraph &ta)
     {
-        std::ofstream out;
-        out.open(outFilePath, std::ofstream::out | std::ofstream::trunc);
+        // A rough estimate of the size of the translation, so that the buffer is (almost) never reallocated.
+        // Since the buffer is written out whenever it is full, its size is bounded even for huge TAs.
+        OutputBuffer out(std::min<size_t>(OUTPUT_BUFFER_DEFAULT_CAPACITY + 64 * ta.getLocationCount() + 160 * ta.getEdgeCount(),
+                                          OUTPUT_BUFFER_FLUSH_THRESHOLD + OUTPUT_BUFFER_DEFAULT_CAPACITY));
+        bool isStreaming = out.startStreaming(outFilePath);
 
         // In our case study we don't care about having multiple processes, so we can simply put the name we want.
         std::string processName = "P";
 
         std::cout << "Starting system declaration\n";
-        out << "system:" + systemName + "\n\n";
+        out << "system:" << systemName << "\n\n";
 
         std::cout << "Starting clocks declaration\n";
-        writeClocksDeclarations(TAContentExtractor::getClocksDeclaration(inFile), out);
+        writeClocksDeclarations(ta.getClocksDeclaration(), out);
 
         // Up to now we only use one event named a (also check in writeTransitionsDeclarations).
         std::cout << "Starting event declaration\n";
         out << "event:a\n\n";
 
         std::cout << "Starting process declaration\n";
-        out << "process:" + processName + "\n";
+        out << "process:" << processName << '\n';
 
         // Locations declaration.
         std::cout << "Starting locations declaration\n";
-        std::string initialLocation = TAContentExtractor::getInitialLocationName(inFile);
-        json locations = TAContentExtractor::getLocations(inFile);
-        writeLocationsDeclarations(processName, initialLocation, getJsonAsArray(locations), out);
+        writeLocationsDeclarations(processName, ta, out);
 
         // Transitions declarations.
         std::cout << "Starting transitions declaration\n";
-        json transitions = TAContentExtractor::getTransitions(inFile);
-        writeTransitionsDeclarations(processName, getJsonAsArray(transitions), out);
+        writeTransitionsDeclarations(processName, ta, out);
 
         // Writing additional information that will be used in the checking procedure.
         // Please note that, although tChecker accepts comments starting with #, the :: syntax has been chosen by ourselves.
-        out << "\n# Q :: " << Q << std::endl;
-        out << "\n# C :: " << C << std::endl;
+        out << "\n# Q :: " << Q << '\n';
+        out << "\n# C :: " << C << '\n';
         // Computing alpha as seen in Theorem 5.
-        out << "\n# Alpha :: " << std::round(std::pow(4 * (1 + C * std::max(Q, 4 * C)), -1) * ALPHA_MAG) << std::endl;
+        out << "\n# Alpha :: " << std::round(std::pow(4 * (1 + C * std::max(Q, 4 * C)), -1) * ALPHA_MAG) << '\n';
+
+        if (isStreaming && out.finishStreaming())
+            return true;
+
+        std::cerr << BHRED << "Failed to write file: " << outFilePath << rstColor << std::endl;
+        return false;
+    }
 
-        out.close();
+
+    /**
+    * This method performs the translation from UPPAAL syntax to tChecker syntax.
+    * @param systemName the name of the system to translate.
+    * @param inFile the json file containing the UPPAAL representation to convert.
+    * @return true if the file has been written, false otherwise.
+    */
+    bool translateTA(const std::string &systemName, const json &inFile)
+    {
+        return translateTA(systemName, TAGraph::fromJson(inFile));
     }
 
 
     /**
      * Method used to tell if a given TA in json format is nrt or not.
+     * A TA is not nrt if it has a transition where a clock is both tested in the guard and reset in the assignment.
      * @param inFile the json representation of the TA to check.
      * @return true if the given TA is nrt, false otherwise.
      */
-    static bool isNRT(json inFile)
+    static bool isNRT(const json &inFile)
     {
-        bool isNRT = true;
-        json transitions = getJsonAsArray(TAContentExtractor::getTransitions(inFile));
-        std::vector<std::string> clocks = TAContentExtractor::getClocks(static_cast<std::string>(inFile.at(NTA).at(TEMPLATE).at(DECLARATION)));
+        const json *transitions = inFile.at(NTA).at(TEMPLATE).contains(TRANSITION) ? &TAContentExtractor::getTransitions(inFile) : nullptr;
+        if (!transitions)
+            return true;
 
-        // For each transition we check if the nrt condition holds.
-        for (auto &transition: transitions)
-        {
-            if (transition.contains(LABEL))
-            {
-                json labels = getJsonAsArray(transition.at(LABEL));
+        std::vector<std::string> clocks = TAContentExtractor::getClocks(TAContentExtractor::getClocksDeclaration(inFile));
 
-                // We check if the transition has exactly two labels and if they correspond to an assignment and a reset.
-                if (labels.size() == 2)
-                {
-                    if ((static_cast<std::string>(labels[0].at(KIND)) == GUARD &&
-                         static_cast<std::string>(labels[1].at(KIND)) == ASSIGNMENT) ||
-                        (static_cast<std::string>(labels[1].at(KIND)) == GUARD &&
-                         static_cast<std::string>(labels[0].at(KIND)) == ASSIGNMENT))
-                    {
-                        // If it is the case, for each clock we check if it is used both in an assignment and in a reset.
-                        for (auto &clock: clocks)
-                        {
-                            if ((static_cast<std::string>(labels[0].at(TEXT)).find(clock) != std::string::npos) &&
-                                (static_cast<std::string>(labels[1].at(TEXT)).find(clock) != std::string::npos))
-                                return false;
-                        }
-                    }
-                }
-            }
-        }
+        bool isNRT = true;
+        // For each transition we check if the nrt condition holds.
+        forEachJsonElement(*transitions, [&](const json &transition) {
+            // We check if the transition has exactly two labels and if they correspond to a guard and an assignment.
+            if (!isNRT || !transition.contains(LABEL) || getJsonArraySize(transition.at(LABEL)) != 2)
+                return;
+
+            const json &first = getJsonArrayElement(transition.at(LABEL), 0);
+            const json &second = getJsonArrayElement(transition.at(LABEL), 1);
+            const json *guard = (first.at(KIND) == GUARD) ? &first : &second;
+            const json *assignment = (first.at(KIND) == ASSIGNMENT) ? &first : &second;
+            if (guard->at(KIND) != GUARD || assignment->at(KIND) != ASSIGNMENT)
+                return;
+
+            LabelExpression guardExpr = TALabelParser::parse(GUARD, guard->at(TEXT).get_ref<const std::string &>());
+            LabelExpression assignmentExpr = TALabelParser::parse(ASSIGNMENT, assignment->at(TEXT).get_ref<const std::string &>());
+
+            // If it is the case, for each clock we check if it is both tested and reset.
+            for (const auto &clock: clocks)
+                if (guardExpr.references(clock) && assignmentExpr.isReset(clock))
+                    isNRT = false;
+        });
         return isNRT;
     }
 
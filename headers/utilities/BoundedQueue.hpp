@@ -0,0 +1,98 @@
+#ifndef UTOTPARSER_BOUNDEDQUEUE_H
+#define UTOTPARSER_BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+
+// Queue connecting two stages of a pipeline.
+// ------------------------------------------
+// The queue holds at most 'capacity' elements: a producer pushing into a full queue waits until the consumer pops an
+// element, hence a fast stage cannot run ahead of a slow one by more than 'capacity' elements (back-pressure).
+// Once the producer closes the queue, the consumer gets the remaining elements and then an empty optional.
+
+template<typename T>
+class BoundedQueue {
+
+private:
+    // The maximum number of elements the queue can hold.
+    size_t capacity {};
+
+    std::deque<T> elements {};
+
+    // True once no more elements will be pushed.
+    bool isClosed { false };
+
+    std::mutex mutex {};
+
+    // Notified when an element is popped, or when the queue is closed.
+    std::condition_variable notFull {};
+
+    // Notified when an element is pushed, or when the queue is closed.
+    std::condition_variable notEmpty {};
+
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1)
+    {}
+
+
+    /**
+     * Method used to push an element at the back of the queue, waiting while the queue is full.
+     * @param element the element to push.
+     * @return true if the element has been pushed, false if the queue has been closed in the meantime.
+     */
+    bool push(T element)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]() { return isClosed || elements.size() < capacity; });
+
+        if (isClosed)
+            return false;
+
+        elements.push_back(std::move(element));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+
+    /**
+     * Method used to pop the element at the front of the queue, waiting while the queue is empty and still open.
+     * @return the element at the front of the queue, or an empty optional if the queue is empty and closed.
+     */
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return isClosed || !elements.empty(); });
+
+        if (elements.empty())
+            return std::nullopt;
+
+        T element { std::move(elements.front()) };
+        elements.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return element;
+    }
+
+
+    /**
+     * Method used to close the queue: the elements already in the queue can still be popped, but no more can be pushed.
+     */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isClosed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+};
+
+
+#endif //UTOTPARSER_BOUNDEDQUEUE_H
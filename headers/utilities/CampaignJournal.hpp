@@ -0,0 +1,131 @@
+#ifndef UTOTPARSER_CAMPAIGNJOURNAL_H
+#define UTOTPARSER_CAMPAIGNJOURNAL_H
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include "nlohmann/json.hpp"
+
+#include "Exceptions.h"
+
+using json = nlohmann::json;
+
+
+// The name of the file, inside the testing results directory, in which the configuration of the campaign is journaled.
+const std::string CAMPAIGN_JOURNAL_FILE_NAME { "Campaign.json" };
+
+
+/**
+ * Struct used to keep track of the options that determine the tests generated by a campaign of the tester.
+ */
+typedef struct cfg {
+    // The command selecting the regular expressions generator (-tns, -tst or -tbz).
+    std::string generator {};
+    // The argument of the command selecting the generator.
+    int generatorParameter {};
+    // The relative tolerance on the number of tiles (-tol), only used with -tbz.
+    double tolerance {};
+    // The maximum number of states of the random tiles.
+    int maxNumOfRandomStates {};
+    // The number of tests of the campaign.
+    int numTests {};
+    bool isSeeded {};
+    uint64_t seed {};
+    bool isLazy {};
+} CampaignConfig;
+
+
+// Journal of a campaign of the tester.
+// ------------------------------------
+// The configuration of the campaign is written when the campaign starts, while the completion of each test is recorded
+// by the results store, which gets the record of a test as soon as the test is complete. Together they allow a campaign
+// which has been interrupted to be resumed: the tests already in the store are skipped and the other ones are generated
+// again from the same configuration (with a seed, a resumed test is the same one the interrupted campaign would have generated).
+
+class CampaignJournal {
+
+private:
+    // The path of the journal.
+    std::string journalPath {};
+
+
+public:
+    /**
+     * Default parametric constructor.
+     * @param testingResultsDirPath the path of the directory containing the journal.
+     */
+    explicit CampaignJournal(const std::string &testingResultsDirPath) : journalPath(testingResultsDirPath + "/" + CAMPAIGN_JOURNAL_FILE_NAME)
+    {}
+
+
+    /**
+     * Method used to tell if a campaign has been journaled.
+     * @return true if the journal exists, false otherwise.
+     */
+    bool exists()
+    {
+        return std::filesystem::exists(journalPath);
+    }
+
+
+    /**
+     * Method used to write the configuration of a campaign.
+     * The journal is written to a temporary file which is then renamed, hence a crash never leaves a partial journal.
+     * @param config the configuration of the campaign.
+     */
+    void write(const CampaignConfig &config)
+    {
+        json journal = {{ "generator",            config.generator },
+                        { "generatorParameter",   config.generatorParameter },
+                        { "tolerance",            config.tolerance },
+                        { "maxNumOfRandomStates", config.maxNumOfRandomStates },
+                        { "numTests",             config.numTests },
+                        { "isSeeded",             config.isSeeded },
+                        { "seed",                 config.seed },
+                        { "isLazy",               config.isLazy }};
+
+        std::string tmpPath { journalPath + ".tmp" };
+        {
+            std::ofstream out(tmpPath, std::ofstream::out | std::ofstream::trunc);
+            out << std::setw(4) << journal << std::endl;
+        }
+        std::filesystem::rename(tmpPath, journalPath);
+    }
+
+
+    /**
+     * Method used to read the configuration of the journaled campaign.
+     * @return the configuration of the campaign.
+     * @throws InvalidCampaignJournalException if the journal cannot be read.
+     */
+    CampaignConfig read()
+    {
+        std::ifstream in(journalPath);
+        json journal = json::parse(in, nullptr, false);
+
+        try
+        {
+            if (journal.is_discarded())
+                throw InvalidCampaignJournalException("The journal of the campaign is not valid json: " + journalPath);
+
+            CampaignConfig config {};
+            config.generator = journal.at("generator").get<std::string>();
+            config.generatorParameter = journal.at("generatorParameter").get<int>();
+            config.tolerance = journal.at("tolerance").get<double>();
+            config.maxNumOfRandomStates = journal.at("maxNumOfRandomStates").get<int>();
+            config.numTests = journal.at("numTests").get<int>();
+            config.isSeeded = journal.at("isSeeded").get<bool>();
+            config.seed = journal.at("seed").get<uint64_t>();
+            config.isLazy = journal.at("isLazy").get<bool>();
+            return config;
+        } catch (json::exception &e)
+        {
+            throw InvalidCampaignJournalException("The journal of the campaign is incomplete: " + journalPath + " (" + e.what() + ")");
+        }
+    }
+
+};
+
+
+#endif //UTOTPARSER_CAMPAIGNJOURNAL_H
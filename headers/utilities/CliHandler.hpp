@@ -1,6 +1,9 @@
 #ifndef UTOTPARSER_CLIHANDLER_H
 #define UTOTPARSER_CLIHANDLER_H
 
+#include <cctype>
+#include <cstdint>
+
 #include "utilities/Utils.hpp"
 #include "defines/ANSI-color-codes.h"
 #include "Exceptions.h"
@@ -42,13 +45,23 @@ const std::string ttt { "-ttt" };
 const std::string inp { "-inp" };
 
 // Specifies to generate strict regular expressions in the tester.
-// This will require the maximum number of iterations as subsequent argument.
+// This will require the number of tiles of each regular expression (the final accepting tile excluded) as subsequent argument.
 const std::string tst { "-tst" };
 
 // Specifies to generate regular expressions in the tester.
 // This will require the maximum number of iterations as subsequent argument.
 const std::string tns { "-tns" };
 
+// Specifies to generate strict regular expressions in the tester by Boltzmann sampling: compositions with the same number
+// of tiles are equally likely, and their number of tiles is the given one on average (see also -tol).
+// This will require the expected number of tiles of each regular expression (the final accepting tile excluded) as subsequent argument.
+const std::string tbz { "-tbz" };
+
+// The relative tolerance on the number of tiles of the regular expressions generated with -tbz (e.g., 0.1 for 10%):
+// regular expressions whose number of tiles is not within it are discarded and drawn again.
+// This will require the tolerance as subsequent argument.
+const std::string tol { "-tol" };
+
 // The maximum number of states a randomly-generated tile will have when launching the tester.
 // This will require the maximum number of states as subsequent argument.
 const std::string sup { "-sup" };
@@ -72,6 +85,56 @@ const std::string atp { "-atp" };
 // Used to print all the bounds found when executing tests.
 const std::string bds { "-bds" };
 
+// Forces the converter and the grapher to regenerate all their outputs, even if the manifest reports them as up-to-date.
+const std::string frc { "-frc" };
+
+// Tells the constructor and the tester to compose tiles lazily, i.e., without ever copying the records of the composed tiles.
+// The resulting TA is kept as the set of its tile instances plus the transitions added by connectors, and it is
+// streamed from there to the output files: useful for generating TAs with millions of locations.
+const std::string lzy { "-lzy" };
+
+// Tells the constructor to compile a batch of compositional strings, one per line, writing the .tck and .dot files of each TA.
+// This will require the path to the file containing the strings as subsequent argument ('-' to read them from the standard input).
+const std::string bat { "-bat" };
+
+// The number of threads used to compile a batch of compositional strings, or to generate the tests of the tester
+// (by default, one per available core).
+// This will require the number of threads as subsequent argument.
+const std::string thr { "-thr" };
+
+// Makes the tests generated by the tester reproducible: test i draws its random numbers from a stream derived from the seed
+// and from i only, hence the same seed gives the same tests, whatever the number of threads used to generate them.
+// This will require the seed (a non-negative integer) as subsequent argument.
+const std::string sed { "-sed" };
+
+// Tells the tester to generate, compose, translate and check the tests as a pipeline, with one thread per stage, so that
+// test i is checked while the following ones are being generated; the results are collected as soon as each test is checked.
+// This will require the maximum number of tests waiting between two consecutive stages as subsequent argument.
+const std::string ppl { "-ppl" };
+
+// Tells the tester to resume the last campaign instead of starting a new one: its configuration (generator, number of
+// tests, seed...) is read from the journal written when it started, and only the tests which have not been completed are run.
+const std::string rsm { "-rsm" };
+
+// Tells the tester to generate (and check) only the test with the given index among the ones of the campaign, e.g., to
+// generate again a failing test alone: together with the seed of the campaign, it gives the same test as the whole campaign.
+// This will require the index of the test (from 1 to the number of tests) as subsequent argument.
+const std::string idx { "-idx" };
+
+// The number of locations of the largest TAs generated by the benchmarker: the ladder of sizes stops at it.
+// This will require the number of locations as subsequent argument.
+const std::string mxl { "-mxl" };
+
+// Specify the directory containing the tiles, with the 'accTiles', 'binTiles' and 'triTiles' subdirectories (by default
+// 'inputTiles').
+// This will require a path as subsequent argument.
+const std::string tls { "-tls" };
+
+// Specify the directory in which all the outputs are written, with the same layout of 'outputs' (the default one), e.g.,
+// to keep the outputs of a test out of the source tree. The 'dst' command still redirects the .tck files alone.
+// This will require a path as subsequent argument.
+const std::string ots { "-ots" };
+
 // ------------------------------------------------------------------------------------------
 
 
@@ -85,7 +148,11 @@ private:
                                                    inp, tst, tns,
                                                    sup, hcr, nbt,
                                                    cls, atc, atp,
-                                                   bds };
+                                                   bds, frc, lzy,
+                                                   bat, thr, sed,
+                                                   ppl, rsm, tbz,
+                                                   tol, mxl, idx,
+                                                   tls, ots };
 
     // A pointer to main's argc.
     int *argc_p;
@@ -179,10 +246,41 @@ public:
      */
     std::string getCmdArgument(const std::string &cmd)
     {
-        if (isCmd(cmd))
-            return (*argv_p)[getPos(cmd) + 1];
-        else
+        if (!isCmd(cmd))
             throw CommandNotProvidedException(std::string("Exception: command " + cmd + " not provided.").c_str());
+        if (getPos(cmd) + 1 >= *argc_p)
+            throw CommandNotProvidedException(std::string("Exception: argument of command " + cmd + " not provided.").c_str());
+        return (*argv_p)[getPos(cmd) + 1];
+    }
+
+
+    /**
+     * Method used to get the argument relative to the specified cmd option, which must be a non-negative integer
+     * (e.g., a number of threads or a seed).
+     * @param cmd the command option for which to get the relative argument.
+     * @param max the greatest value the argument may have.
+     * @return the argument of the cmd option.
+     * @throw CommandNotProvidedException if the command was not provided when launching the program.
+     * @throw InvalidCommandArgumentException if the argument is not an integer between 0 and max.
+     */
+    uint64_t getNumericCmdArgument(const std::string &cmd, uint64_t max = UINT64_MAX)
+    {
+        std::string argument = getCmdArgument(cmd);
+
+        // Unlike std::stoull, neither signs, nor spaces, nor trailing characters are accepted, and overflows are detected.
+        uint64_t value = 0;
+        bool isValid = !argument.empty();
+        for (size_t i = 0; isValid && i < argument.size(); i++)
+        {
+            auto digit = static_cast<uint64_t>(argument[i] - '0');
+            isValid = std::isdigit(static_cast<unsigned char>(argument[i])) && value <= (UINT64_MAX - digit) / 10;
+            value = value * 10 + digit;
+        }
+
+        if (!isValid || value > max)
+            throw InvalidCommandArgumentException("Exception: the argument of command " + cmd + " must be an integer between 0 and "
+                                                  + std::to_string(max) + ", while " + argument + " was given.");
+        return value;
     }
 
 };
@@ -7,21 +7,43 @@ using json = nlohmann::json;
 
 
 /**
- * Function used to ensure the given json parameter is returned as an Array.
- * This is useful for: locations, transitions, labels.
- * @param inFile the json parameter we want to return as an array.
- * @return the array version of the given json parameter.
+ * Function used to get the number of elements of a json parameter, considering it as an array.
+ * This is useful for: locations, transitions, labels, which are single objects when there is only one of them.
+ * @param inFile the json parameter for which to count the elements.
+ * @return the size of the parameter if it is an array, 1 otherwise.
  */
-static json getJsonAsArray(json inFile)
+inline size_t getJsonArraySize(const json &inFile)
+{
+    return inFile.is_array() ? inFile.size() : 1;
+}
+
+
+/**
+ * Function used to get an element of a json parameter, considering it as an array, without copying it.
+ * @param inFile the json parameter from which to get the element.
+ * @param index the position of the element.
+ * @return a reference to the element at position 'index' if the parameter is an array, to the parameter itself otherwise.
+ */
+inline const json &getJsonArrayElement(const json &inFile, size_t index)
+{
+    return inFile.is_array() ? inFile[index] : inFile;
+}
+
+
+/**
+ * Function used to visit all the elements of a json parameter, considering it as an array, without copying it.
+ * @tparam F the type of the function to call on each element.
+ * @param inFile the json parameter whose elements have to be visited.
+ * @param f the function to call on each element.
+ */
+template<typename F>
+inline void forEachJsonElement(const json &inFile, F &&f)
 {
     if (inFile.is_array())
-        return inFile;
+        for (const auto &element: inFile)
+            f(element);
     else
-    {
-        json inFileToArray = json::array();
-        inFileToArray.push_back(inFile);
-        return inFileToArray;
-    }
+        f(inFile);
 }
 
 
@@ -30,11 +52,16 @@ static json getJsonAsArray(json inFile)
  * @param jsonPtr a json for which to get a pointer pointing to a json array.
  * @return a pointer pointing to a json array.
  */
-static json *getJsonPtrAsArray(json *jsonPtr)
+inline json *getJsonPtrAsArray(json *jsonPtr)
 {
     // If the tile pointer's content is not an array, we have to make it an array.
+    // The content is moved inside the new array, so that no copy of it is made.
     if (!jsonPtr->is_array())
-        *jsonPtr = getJsonAsArray(*jsonPtr);
+    {
+        json element = std::move(*jsonPtr);
+        *jsonPtr = json::array();
+        jsonPtr->push_back(std::move(element));
+    }
 
     return jsonPtr;
 }
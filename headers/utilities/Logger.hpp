@@ -2,6 +2,7 @@
 #define UTOTPARSER_LOGGER_H
 
 #include <chrono>
+#include <ctime>
 #include <utility>
 
 #include "utilities/StringsGetter.hpp"
@@ -30,8 +31,9 @@ private:
         auto now = std::chrono::system_clock::now();
         // Convert the time point to a time_t (C-style time).
         std::time_t current_time = std::chrono::system_clock::to_time_t(now);
-        // Convert time_t to a string representation.
-        std::string time_str = std::ctime(&current_time);
+        // Convert time_t to a string representation (ctime_r does not share its buffer, hence loggers can be used by many threads).
+        char buffer[26];
+        std::string time_str = ctime_r(&current_time, buffer);
         return time_str;
     }
 
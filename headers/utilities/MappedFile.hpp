@@ -0,0 +1,82 @@
+#ifndef UTOTPARSER_MAPPEDFILE_H
+#define UTOTPARSER_MAPPEDFILE_H
+
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+class MappedFile {
+
+private:
+    // A pointer to the first byte of the mapped file, nullptr if the file could not be mapped.
+    const char *data { nullptr };
+
+    // The size in bytes of the mapped file.
+    size_t size {};
+
+
+public:
+    /**
+     * Default parametric constructor, mapping the whole file in read-only mode.
+     * If the file does not exist, is empty or cannot be mapped, the resulting object will not be open.
+     * @param path the path to the file to map.
+     */
+    explicit MappedFile(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+
+        struct stat fileStat {};
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            void *mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                data = static_cast<const char *>(mapping);
+                size = static_cast<size_t>(fileStat.st_size);
+            }
+        }
+
+        // The mapping stays valid even after closing the file descriptor.
+        close(fd);
+    }
+
+
+    ~MappedFile()
+    {
+        if (data)
+            munmap(const_cast<char *>(data), size);
+    }
+
+
+    MappedFile(const MappedFile &) = delete;
+
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+
+    [[nodiscard]] bool isOpen() const
+    {
+        return data != nullptr;
+    }
+
+
+    [[nodiscard]] const char *getData() const
+    {
+        return data;
+    }
+
+
+    [[nodiscard]] size_t getSize() const
+    {
+        return size;
+    }
+
+};
+
+
+#endif //UTOTPARSER_MAPPEDFILE_H
@@ -0,0 +1,198 @@
+#ifndef UTOTPARSER_OUTPUTBUFFER_H
+#define UTOTPARSER_OUTPUTBUFFER_H
+
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+// The default amount of bytes preallocated by an OutputBuffer.
+#define OUTPUT_BUFFER_DEFAULT_CAPACITY (1 << 16)
+
+// The amount of bytes above which a streaming OutputBuffer writes its content to its file.
+#define OUTPUT_BUFFER_FLUSH_THRESHOLD (1 << 20)
+
+
+class OutputBuffer {
+
+private:
+    // The content to write, which is accumulated in memory and written all at once.
+    std::string buffer {};
+
+    // The file to which the content is streamed, -1 if the content is only accumulated in memory.
+    int fd { -1 };
+
+    // True if writing part of the content to the streamed file has failed.
+    bool failed {};
+
+
+    /**
+     * Method used to write some bytes into a file, repeating the write call only if it is partial.
+     * @return true if all the bytes have been written, false otherwise.
+     */
+    static bool writeAll(int fd, const char *data, size_t size)
+    {
+        size_t written = 0;
+        while (written < size)
+        {
+            ssize_t result = write(fd, data + written, size - written);
+            if (result < 0 && errno == EINTR)
+                continue;
+            if (result < 0)
+                return false;
+            written += static_cast<size_t>(result);
+        }
+        return true;
+    }
+
+
+public:
+    /**
+     * Default parametric constructor.
+     * @param capacity the number of bytes to preallocate, avoiding reallocations while the content is appended.
+     */
+    explicit OutputBuffer(size_t capacity = OUTPUT_BUFFER_DEFAULT_CAPACITY)
+    {
+        buffer.reserve(capacity);
+    }
+
+
+    OutputBuffer(const OutputBuffer &) = delete;
+
+
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+
+    ~OutputBuffer()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+
+    /**
+     * Method used to ensure that at least a given amount of bytes can be appended without reallocating.
+     * @param additionalBytes the number of bytes that will be appended.
+     */
+    void reserve(size_t additionalBytes)
+    {
+        buffer.reserve(buffer.size() + additionalBytes);
+    }
+
+
+    OutputBuffer &operator<<(std::string_view str)
+    {
+        buffer.append(str);
+        return *this;
+    }
+
+
+    OutputBuffer &operator<<(char c)
+    {
+        buffer.push_back(c);
+        return *this;
+    }
+
+
+    OutputBuffer &operator<<(long long value)
+    {
+        char digits[24];
+        auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+        buffer.append(digits, result.ptr);
+        return *this;
+    }
+
+
+    OutputBuffer &operator<<(int value)
+    {
+        return *this << static_cast<long long>(value);
+    }
+
+
+    /**
+     * Floating point values are formatted as an std::ostream with default flags would do (i.e., as "%g").
+     */
+    OutputBuffer &operator<<(double value)
+    {
+        char digits[32];
+        int length = std::snprintf(digits, sizeof(digits), "%g", value);
+        buffer.append(digits, static_cast<size_t>(length));
+        return *this;
+    }
+
+
+    [[nodiscard]] const std::string &str() const
+    {
+        return buffer;
+    }
+
+
+    /**
+     * Method used to write the whole content of the buffer into a file, replacing its previous content.
+     * The content is handed to the operating system with a single write call (repeated only if the write is partial).
+     * @param filePath the path to the file to write.
+     * @return true if the whole content has been written, false otherwise.
+     */
+    bool writeToFile(const std::string &filePath) const
+    {
+        int file = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0)
+            return false;
+
+        bool written = writeAll(file, buffer.data(), buffer.size());
+        return (close(file) == 0) && written;
+    }
+
+
+    /**
+     * Method used to stream the content of the buffer to a file, replacing its previous content.
+     * From now on, the content is written out in chunks whenever flushIfFull finds the buffer full, so that large
+     * outputs are never kept in memory as a whole. If the file cannot be opened, the content is only accumulated.
+     * @param filePath the path to the file to write.
+     * @return true if the file has been opened, false otherwise.
+     */
+    bool startStreaming(const std::string &filePath)
+    {
+        fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        return fd >= 0;
+    }
+
+
+    /**
+     * Method used to write the content of a streaming buffer to its file once it grows above OUTPUT_BUFFER_FLUSH_THRESHOLD.
+     * It is meant to be called after each record, hence it only compares the size of the buffer most of the times.
+     */
+    void flushIfFull()
+    {
+        if (fd < 0 || buffer.size() < OUTPUT_BUFFER_FLUSH_THRESHOLD)
+            return;
+
+        failed = !writeAll(fd, buffer.data(), buffer.size()) || failed;
+        buffer.clear();
+    }
+
+
+    /**
+     * Method used to write the remaining content of a streaming buffer and to close its file.
+     * @return true if the whole content has been written, false otherwise.
+     */
+    bool finishStreaming()
+    {
+        if (fd < 0)
+            return false;
+
+        bool written = writeAll(fd, buffer.data(), buffer.size()) && !failed;
+        buffer.clear();
+        written = (close(fd) == 0) && written;
+        fd = -1;
+        return written;
+    }
+
+};
+
+
+#endif //UTOTPARSER_OUTPUTBUFFER_H
@@ -0,0 +1,201 @@
+#ifndef UTOTPARSER_OUTPUTMANIFEST_H
+#define UTOTPARSER_OUTPUTMANIFEST_H
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <unistd.h>
+#include "nlohmann/json.hpp"
+
+#include "utilities/Utils.hpp"
+#include "utilities/MappedFile.hpp"
+
+using json = nlohmann::json;
+
+
+// Version of the emitted artifacts: bump it whenever the content of the .tck, .dot or .pdf files produced for
+// the same input changes, so that outputs generated by previous versions are considered stale and regenerated.
+// 1.1: C (hence Alpha) also counts the constants written without surrounding spaces and the negative ones.
+#define TOOL_VERSION "1.1"
+
+// The name of the manifest file written inside each output directory.
+const std::string MANIFEST_FILE_NAME { ".manifest.json" };
+
+
+class OutputManifest {
+
+private:
+    // Path to the directory containing the outputs tracked by the manifest.
+    std::string outputDirPath {};
+
+    // Path to the manifest file.
+    std::string manifestPath {};
+
+    // A string describing the options used to produce the outputs: changing them makes every output stale.
+    std::string options {};
+
+    // True if every output has to be regenerated, regardless of the manifest content.
+    bool force {};
+
+    // The entries read from the manifest at the beginning of the run.
+    json previousEntries = json::object();
+
+    // The entries of the outputs that are valid at the end of the run.
+    json currentEntries = json::object();
+
+
+    /**
+     * Method used to convert a hash to the hexadecimal string stored in the manifest.
+     * @param hash the hash to convert.
+     * @return a string containing the hexadecimal representation of the hash.
+     */
+    static std::string hashToString(uint64_t hash)
+    {
+        std::stringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return ss.str();
+    }
+
+
+public:
+    /**
+     * Default parametric constructor, reading the manifest contained in the output directory (if any).
+     * A missing or unreadable manifest is treated as an empty one, meaning that every output will be regenerated.
+     * @param outputDirPath the path to the directory containing the outputs.
+     * @param options a string describing the options affecting the content of the outputs.
+     * @param force true if every output has to be considered stale.
+     */
+    OutputManifest(std::string outputDirPath, std::string options, bool force = false) :
+            outputDirPath(std::move(outputDirPath)), options(std::move(options)), force(force)
+    {
+        manifestPath = this->outputDirPath + "/" += MANIFEST_FILE_NAME;
+
+        std::ifstream file(manifestPath);
+        if (!file.is_open())
+            return;
+
+        json manifest = json::parse(file, nullptr, false);
+        if (!manifest.is_discarded() && manifest.is_object() && manifest.contains("entries") && manifest.at("entries").is_object())
+            previousEntries = manifest.at("entries");
+    }
+
+
+    /**
+     * Method used to compute the hash of the content of a file.
+     * @param path the path to the file.
+     * @return the FNV-1a hash of the content of the file.
+     */
+    static uint64_t getFileHash(const std::string &path)
+    {
+        MappedFile file(path);
+        return file.isOpen() ? computeFNV1aHash(file.getData(), file.getSize()) : computeFNV1aHash("", 0);
+    }
+
+
+    /**
+     * Method used to check if the outputs of a given input are still valid.
+     * This is the case when the input content, the tool version and the options did not change since the outputs
+     * were produced, and none of the outputs has been deleted in the meantime.
+     * @param inputName the name of the input.
+     * @param inputHash the hash of the current content of the input.
+     * @return true if the outputs do not need to be regenerated, false otherwise.
+     */
+    [[nodiscard]] bool isUpToDate(const std::string &inputName, uint64_t inputHash) const
+    {
+        if (force || !previousEntries.contains(inputName))
+            return false;
+
+        const json &entry = previousEntries.at(inputName);
+        if (entry.value("hash", "") != hashToString(inputHash)
+            || entry.value("version", "") != TOOL_VERSION
+            || entry.value("options", "") != options
+            || !entry.contains("outputs") || !entry.at("outputs").is_array())
+            return false;
+
+        for (const auto &output: entry.at("outputs"))
+            if (!output.is_string() || !std::filesystem::exists(outputDirPath + "/" += output.get<std::string>()))
+                return false;
+        return true;
+    }
+
+
+    /**
+     * Method used to get the result stored for a given input when its outputs were produced.
+     * @param inputName the name of the input.
+     * @return the stored result, false if no result is present.
+     */
+    [[nodiscard]] bool getStoredResult(const std::string &inputName) const
+    {
+        return previousEntries.contains(inputName) && previousEntries.at(inputName).value("result", false);
+    }
+
+
+    /**
+     * Method used to keep, for the current run, the entry of an input whose outputs are up-to-date.
+     * @param inputName the name of the input.
+     */
+    void keep(const std::string &inputName)
+    {
+        currentEntries[inputName] = previousEntries.at(inputName);
+    }
+
+
+    /**
+     * Method used to record the outputs just produced for a given input.
+     * @param inputName the name of the input.
+     * @param inputHash the hash of the content of the input.
+     * @param outputs the names of the files produced in the output directory.
+     * @param result the result of the generation, which will be given back when the outputs are up-to-date.
+     */
+    void record(const std::string &inputName, uint64_t inputHash, const std::vector<std::string> &outputs, bool result = true)
+    {
+        currentEntries[inputName] = {
+                { "hash",    hashToString(inputHash) },
+                { "version", TOOL_VERSION },
+                { "options", options },
+                { "outputs", outputs },
+                { "result",  result }
+        };
+    }
+
+
+    /**
+     * Method used to delete all the files in the output directory that are not an output of the current run.
+     * These are the outputs of inputs which have been removed, or files produced by other tools.
+     */
+    void prune() const
+    {
+        std::set<std::string> validOutputs { MANIFEST_FILE_NAME };
+        for (const auto &entry: currentEntries)
+            for (const auto &output: entry.at("outputs"))
+                validOutputs.insert(output.get<std::string>());
+
+        for (const auto &entry: std::filesystem::directory_iterator(outputDirPath))
+            if (validOutputs.find(entry.path().filename().string()) == validOutputs.end())
+                std::filesystem::remove_all(entry.path());
+    }
+
+
+    /**
+     * Method used to write the manifest in the output directory, replacing the previous one.
+     * The manifest is first written with a temporary name and then renamed, so that an interrupted run never leaves a corrupted manifest.
+     */
+    void save() const
+    {
+        json manifest = {
+                { "version", TOOL_VERSION },
+                { "entries", currentEntries }
+        };
+
+        std::string tmpPath = manifestPath + ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream out(tmpPath, std::ofstream::out | std::ofstream::trunc);
+            out << std::setw(4) << manifest << '\n';
+        }
+        std::filesystem::rename(tmpPath, manifestPath);
+    }
+
+};
+
+
+#endif //UTOTPARSER_OUTPUTMANIFEST_H
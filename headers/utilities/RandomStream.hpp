@@ -0,0 +1,105 @@
+#ifndef UTOTPARSER_RANDOMSTREAM_H
+#define UTOTPARSER_RANDOMSTREAM_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+
+// The increment of the SplitMix64 generator (the fractional part of the golden ratio).
+#define RANDOM_STREAM_GAMMA 0x9E3779B97F4A7C15ULL
+
+
+// Stream of random numbers used when generating regular expressions and random tiles.
+// ------------------------------------------------------------------------------------
+// Each thread draws from its own generator. Unless it is seeded, the generator is seeded once from std::random_device,
+// hence two runs are different. When it is seeded with (seed, index), the stream only depends on that pair: the same
+// test is generated whenever the same seed and index are given, regardless of the thread generating it and of the
+// tests generated before it.
+
+class RandomStream {
+
+private:
+    static thread_local std::mt19937 generator;
+
+    static thread_local bool isSeeded;
+
+
+    /**
+     * Method used to get the next value of a SplitMix64 generator.
+     * @param state the state of the generator, which is advanced.
+     * @return the next value of the generator.
+     */
+    static uint64_t splitMix64(uint64_t &state)
+    {
+        uint64_t z = (state += RANDOM_STREAM_GAMMA);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+
+public:
+    /**
+     * Method used to seed the generator of the current thread with the stream derived from a seed and an index.
+     * Different indexes give unrelated streams, even if the indexes are consecutive.
+     * @param seed the seed of the whole run.
+     * @param index the index of the stream (e.g., the number of the test).
+     */
+    static void seed(uint64_t seed, uint64_t index)
+    {
+        // The index is mixed separately, so that (seed, index) and (seed + 1, index - 1) do not give the same state.
+        uint64_t indexState = index;
+        uint64_t state = seed ^ splitMix64(indexState);
+
+        std::array<uint32_t, 8> words {};
+        for (size_t i = 0; i < words.size(); i += 2)
+        {
+            uint64_t value = splitMix64(state);
+            words[i] = static_cast<uint32_t>(value);
+            words[i + 1] = static_cast<uint32_t>(value >> 32);
+        }
+
+        std::seed_seq seedSequence(words.begin(), words.end());
+        generator.seed(seedSequence);
+        isSeeded = true;
+    }
+
+
+    /**
+     * Method used to make the generator of the current thread continue the stream of another generator, e.g., when a
+     * test started by a thread is carried on by another one.
+     * @param state the generator whose stream has to be continued.
+     */
+    static void restore(const std::mt19937 &state)
+    {
+        generator = state;
+        isSeeded = true;
+    }
+
+
+    /**
+     * Method used to get the generator of the current thread.
+     * @return the generator, seeded from std::random_device if it has not been seeded yet.
+     */
+    static std::mt19937 &getGenerator()
+    {
+        if (!isSeeded)
+        {
+            std::random_device rd;
+            generator.seed(rd());
+            isSeeded = true;
+        }
+        return generator;
+    }
+
+};
+
+
+// Defining static attributes.
+thread_local std::mt19937 RandomStream::generator {};
+
+thread_local bool RandomStream::isSeeded { false };
+
+
+#endif //UTOTPARSER_RANDOMSTREAM_H
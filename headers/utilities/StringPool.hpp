@@ -0,0 +1,128 @@
+#ifndef UTOTPARSER_STRINGPOOL_H
+#define UTOTPARSER_STRINGPOOL_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+// The index used to represent the absence of a string.
+#define STRING_POOL_NONE UINT32_MAX
+
+// The first chunk of a pool holds 2^STRING_POOL_FIRST_CHUNK_BITS strings, and each following chunk doubles the previous one.
+#define STRING_POOL_FIRST_CHUNK_BITS 10
+
+
+// Pool of interned strings, which may be shared by many threads.
+// --------------------------------------------------------------
+// Strings are interned under a lock, while they are read without locking at all: they are stored in chunks which are
+// allocated once and never moved, hence a string can be read while other threads are adding new strings to the pool.
+// An index can be read by a thread only after it has been handed to it, either by intern or through any other
+// synchronization (e.g., the lock of a shared cache, or the creation of the thread), which makes the string visible.
+
+class StringPool {
+
+private:
+    // The chunks holding the interned strings: chunk k holds 2^(STRING_POOL_FIRST_CHUNK_BITS + k) strings.
+    std::array<std::unique_ptr<std::string[]>, 32 - STRING_POOL_FIRST_CHUNK_BITS> chunks {};
+
+    // The number of interned strings.
+    uint32_t count {};
+
+    // The index of each interned string.
+    std::unordered_map<std::string_view, uint32_t> indexes {};
+
+    mutable std::mutex mutex {};
+
+
+    /**
+     * Method used to get the chunk holding a string and the position of the string inside the chunk.
+     * @param index the index of the string inside the pool.
+     * @return the index of the chunk and the position inside the chunk.
+     */
+    static std::pair<uint32_t, uint32_t> locate(uint32_t index)
+    {
+        // Chunk k starts at index 2^BITS * (2^k - 1), hence k is the position of the highest bit of (index / 2^BITS + 1).
+        uint32_t chunk = 31 - static_cast<uint32_t>(__builtin_clz((index >> STRING_POOL_FIRST_CHUNK_BITS) + 1));
+        uint32_t first = ((1u << chunk) - 1) << STRING_POOL_FIRST_CHUNK_BITS;
+        return { chunk, index - first };
+    }
+
+
+public:
+    StringPool() = default;
+
+
+    StringPool(const StringPool &) = delete;
+
+
+    StringPool &operator=(const StringPool &) = delete;
+
+
+    /**
+     * Method used to get the index corresponding to a string, adding the string to the pool if it is not present yet.
+     * Equal strings always get the same index, hence two interned strings can be compared through their indexes.
+     * @param str the string to intern.
+     * @return the index of the string inside the pool.
+     */
+    uint32_t intern(std::string_view str)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto found = indexes.find(str);
+        if (found != indexes.end())
+            return found->second;
+
+        uint32_t index = count;
+        auto [chunk, position] = locate(index);
+        if (!chunks[chunk])
+            chunks[chunk] = std::make_unique<std::string[]>(size_t { 1 } << (STRING_POOL_FIRST_CHUNK_BITS + chunk));
+
+        std::string &stored = chunks[chunk][position];
+        stored = str;
+        indexes.emplace(stored, index);
+        count++;
+        return index;
+    }
+
+
+    /**
+     * Method used to get the index of a string without adding it to the pool.
+     * @param str the string to look for.
+     * @return the index of the string, STRING_POOL_NONE if it has never been interned.
+     */
+    [[nodiscard]] uint32_t find(std::string_view str) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto found = indexes.find(str);
+        return (found != indexes.end()) ? found->second : STRING_POOL_NONE;
+    }
+
+
+    /**
+     * Method used to get an interned string.
+     * @param index the index of the string inside the pool.
+     * @return a reference to the string, which stays valid as long as the pool exists.
+     */
+    [[nodiscard]] const std::string &get(uint32_t index) const
+    {
+        auto [chunk, position] = locate(index);
+        return chunks[chunk][position];
+    }
+
+
+    [[nodiscard]] size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+};
+
+
+#endif //UTOTPARSER_STRINGPOOL_H
@@ -1,6 +1,7 @@
 #ifndef UTOTPARSER_STRINGSGETTER_H
 #define UTOTPARSER_STRINGSGETTER_H
 
+#include <filesystem>
 #include <utility>
 
 #include "utilities/CliHandler.hpp"
@@ -24,9 +25,6 @@ private:
     // Path to the directory containing shell scripts used for checks.
     std::string scriptsDirPath {};
 
-    // Path to the directory containing shell scripts used for various purposes but checking.
-    std::string otherScriptsPath {};
-
     // Path to the directory containing TA descriptions where parameters have been substituted with appropriate values.
     std::string outputDirForCheckingPath {};
 
@@ -60,25 +58,40 @@ private:
     // Path to the directory containing the resource usage results obtained from tests.
     std::string testingResourceUsageDirPath {};
 
+    // Path to the directory where the benchmark corpus will be written.
+    std::string benchmarkCorpusDirPath {};
+
 
 public:
     explicit StringsGetter(CliHandler &cliHandler) : currentDirPath(XSTRING(SOURCE_ROOT))
     {
+        std::string outputsDirPath = cliHandler.isCmd(ots) ? cliHandler.getCmdArgument(ots) : (currentDirPath + "/outputs");
+
         inputDirPath = cliHandler.isCmd(src) ? cliHandler.getCmdArgument(src) : (currentDirPath + "/inputFiles");
-        outputDirPath = cliHandler.isCmd(dst) ? cliHandler.getCmdArgument(dst) : (currentDirPath + "/outputs/outputFiles");
+        outputDirPath = cliHandler.isCmd(dst) ? cliHandler.getCmdArgument(dst) : (outputsDirPath + "/outputFiles");
         scriptsDirPath = currentDirPath + "/scriptsForChecks";
-        outputDirForCheckingPath = currentDirPath + "/outputs/outputFilesForChecking";
+        outputDirForCheckingPath = outputsDirPath + "/outputFilesForChecking";
         tCheckerBinPath = cliHandler.isCmd(lns) ? cliHandler.getCmdArgument(lns) : XSTRING(TCHECKER_BIN);
-        outputPDFsDirPath = currentDirPath + "/outputs/outputPDFs";
-        outputDOTsDirPath = currentDirPath + "/outputs/outputDOTs";
-        outputDirForCheckingPathLogs = currentDirPath + "/outputs/logs/outputFilesForCheckingLogs";
-        inputTilesDirPath = currentDirPath + "/inputTiles";
+        outputPDFsDirPath = outputsDirPath + "/outputPDFs";
+        outputDOTsDirPath = outputsDirPath + "/outputDOTs";
+        outputDirForCheckingPathLogs = outputsDirPath + "/logs/outputFilesForCheckingLogs";
+        inputTilesDirPath = cliHandler.isCmd(tls) ? cliHandler.getCmdArgument(tls) : (currentDirPath + "/inputTiles");
         accTilesDirPath = inputTilesDirPath + "/accTiles";
         binTilesDirPath = inputTilesDirPath + "/binTiles";
         triTilesDirPath = inputTilesDirPath + "/triTiles";
-        testingResultsDirPath = currentDirPath + "/outputs/logs/testingResults";
-        otherScriptsPath = currentDirPath + "/scripts";
-        testingResourceUsageDirPath = currentDirPath + "/outputs/logs/testingResourceUsage";
+        testingResultsDirPath = outputsDirPath + "/logs/testingResults";
+        testingResourceUsageDirPath = outputsDirPath + "/logs/testingResourceUsage";
+        benchmarkCorpusDirPath = outputsDirPath + "/benchmarkCorpus";
+
+        // The default directories are created by cmake, while the ones inside a given outputs directory are created here.
+        if (cliHandler.isCmd(ots))
+        {
+            for (const std::string *dirPath: { &outputDirForCheckingPath, &outputPDFsDirPath, &outputDOTsDirPath,
+                                               &outputDirForCheckingPathLogs, &testingResultsDirPath, &testingResourceUsageDirPath })
+                std::filesystem::create_directories(*dirPath);
+            if (!cliHandler.isCmd(dst))
+                std::filesystem::create_directories(outputDirPath);
+        }
     }
 
 
@@ -160,15 +173,15 @@ public:
     }
 
 
-    [[nodiscard]] const std::string &getOtherScriptsPath() const
+    [[nodiscard]] const std::string &getTestingResourceUsageDirPath() const
     {
-        return otherScriptsPath;
+        return testingResourceUsageDirPath;
     }
 
 
-    [[nodiscard]] const std::string &getTestingResourceUsageDirPath() const
+    [[nodiscard]] const std::string &getBenchmarkCorpusDirPath() const
     {
-        return testingResourceUsageDirPath;
+        return benchmarkCorpusDirPath;
     }
 
 };
@@ -10,6 +10,19 @@
 using json = nlohmann::json;
 
 
+/**
+ * Function used to return a json representation starting from the content of an .xml file.
+ * The content is taken by value, since xml2json parses it in place.
+ * @param xmlContent the content of the .xml file.
+ * @return a json representation of the given content.
+ */
+json getJsonFromXmlContent(std::string xmlContent)
+{
+    // We obtain the json representation of a TA from the xml generated by UPPAAL.
+    return json::parse(xml2json(xmlContent.c_str()));
+}
+
+
 /**
  * Function used to return a json representation starting from a file. Notice that the file must be an .xml file.
  * @param file the file from which to get a json representation.
@@ -23,52 +36,39 @@ json getJsonFromFileStream(std::ifstream &file, bool isXml = true)
         buffer << file.rdbuf();
         file.close();
 
-        std::string tmp = buffer.str();
-        const char *xml_str = tmp.c_str();
-
-        // We obtain the json representation of a TA from the xml generated by UPPAAL.
-        return json::parse(xml2json(xml_str));
+        return getJsonFromXmlContent(buffer.str());
     } else
         throw NotXMLFormatException("Provided file should be of .xml type!");
 }
 
 
 /**
- * Function used to collect inside a vector all the integer occurrences inside a string.
- * @param str the string into which we're looking for integers occurrences.
- * @return a vector containing all integer numbers present in the string parameter.
+ * Function used to compute the 64-bit FNV-1a hash of a sequence of bytes.
+ * It is not a cryptographic hash, but it is fast and good enough to detect changes in the content of a file.
+ * @param data a pointer to the first byte to hash.
+ * @param size the number of bytes to hash.
+ * @param hash the value from which to start hashing, useful to hash data split in more than one chunk.
+ * @return the FNV-1a hash of the given bytes.
  */
-static std::vector<int> extractIntegersFromString(const std::string &str)
+uint64_t computeFNV1aHash(const char *data, size_t size, uint64_t hash = 14695981039346656037ULL)
 {
-    std::vector<int> result;
-    std::stringstream ss(str);
-    std::string temp;
-
-    while (ss >> temp)
+    for (size_t i = 0; i < size; i++)
     {
-        try
-        {
-            int found = std::stoi(temp);
-            result.push_back(found);
-        }
-        catch (const std::invalid_argument &)
-        {}
-        catch (const std::out_of_range &)
-        {}
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
     }
-    return result;
+    return hash;
 }
 
 
 /**
- * Function that returns the maximum integer value that appears inside a string.
- * @param str the string into which we're looking for integers occurrences.
- * @return the maximum integer value appearing in the string parameter.
+ * Function used to compute the 64-bit FNV-1a hash of a string.
+ * @param str the string to hash.
+ * @return the FNV-1a hash of the given string.
  */
-static int getMaxIntFromStr(const std::string &str)
+uint64_t computeFNV1aHash(const std::string &str)
 {
-    std::vector<int> tmp = extractIntegersFromString(str);
-    return (!tmp.empty()) ? *max_element(tmp.begin(), tmp.end()) : 0;
+    return computeFNV1aHash(str.data(), str.size());
 }
 
 
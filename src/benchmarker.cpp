@@ -0,0 +1,49 @@
+#include <iostream>
+#include <string>
+#include "nlohmann/json.hpp"
+
+#include "utilities/StringsGetter.hpp"
+#include "utilities/CliHandler.hpp"
+#include "TAHeaders/TAGraph.hpp"
+#include "TAHeaders/TATileHeaders/TABenchmarkCorpus.hpp"
+#include "Exceptions.h"
+
+using json = nlohmann::json;
+
+
+// The benchmarker writes a fixed corpus of nrt TAs of increasing size (from 10 to 1000000 locations), parametric and
+// non-parametric, whose languages are known to be empty or not by construction, together with a manifest of their properties.
+// The corpus is written in the directory given with the 'dst' command (by default 'outputs/benchmarkCorpus'):
+// - 'xml' contains the TAs in UPPAAL's format, to be given to the converter with the 'src' command.
+// - 'tck' contains the TAs in tChecker's format, to be given to the checker with the 'dst' command.
+// - 'Manifest.json' lists, for each TA, its files, its size, its expected verdict and the string it has been composed from.
+// The same seed (given with the 'sed' command, 0 by default) always gives the same corpus.
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        CliHandler cliHandler(&argc, &argv);
+        StringsGetter stringsGetter(cliHandler);
+        TAGraph::setLazyComposition(cliHandler.isCmd(lzy));
+
+        std::string corpusDirPath = cliHandler.isCmd(dst) ? cliHandler.getCmdArgument(dst) : stringsGetter.getBenchmarkCorpusDirPath();
+        uint64_t seed = cliHandler.isCmd(sed) ? cliHandler.getNumericCmdArgument(sed) : 0;
+        auto maxLocations = static_cast<uint32_t>(cliHandler.isCmd(mxl) ? cliHandler.getNumericCmdArgument(mxl, UINT32_MAX) : UINT32_MAX);
+
+        TABenchmarkCorpus taBenchmarkCorpus(stringsGetter, corpusDirPath, seed, maxLocations);
+        size_t failed = taBenchmarkCorpus.generateCorpus();
+
+        std::cout << ((failed == 0) ? BHGRN : BHRED) << "Corpus written in: " << corpusDirPath << rstColor << std::endl;
+        return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    } catch (CommandNotProvidedException &e)
+    {
+        std::cerr << BHRED << e.what() << rstColor << std::endl;
+        return EXIT_FAILURE;
+    } catch (InvalidCommandArgumentException &e)
+    {
+        std::cerr << BHRED << e.what() << rstColor << std::endl;
+        return EXIT_FAILURE;
+    }
+}
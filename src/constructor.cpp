@@ -1,14 +1,18 @@
+#include <climits>
 #include <iostream>
 #include <fstream>
+#include <thread>
 #include "nlohmann/json.hpp"
 
 #include "utilities/StringsGetter.hpp"
 #include "TAHeaders/TATileHeaders/TATileConstructor.hpp"
+#include "TAHeaders/TATileHeaders/TABatchCompiler.hpp"
 #include "TAHeaders/TATileHeaders/lexerAndParser/TATileInputParser.hpp"
 #include "utilities/Utils.hpp"
 #include "utilities/CliHandler.hpp"
 #include "TAHeaders/TADotConverter.hpp"
 #include "TAHeaders/TAutotTranslator.hpp"
+#include "TAHeaders/TAGraph.hpp"
 #include "Exceptions.h"
 
 using json = nlohmann::json;
@@ -20,10 +24,10 @@ using json = nlohmann::json;
  * Function used to print the TiledTA.
  * @param tiledTA the TiledTA to print.
  */
-void printTiledTA(const json &tiledTA)
+void printTiledTA(const TAGraph &tiledTA)
 {
     std::cout << "\n\nResultingTiledTA:\n\n";
-    std::cout << std::setw(4) << tiledTA << std::endl;
+    std::cout << std::setw(4) << tiledTA.toJson() << std::endl;
 }
 
 
@@ -31,9 +35,9 @@ void printTiledTA(const json &tiledTA)
  * Function used to convert a TA to a .dot file.
  * @param outputDOTDirPath the path to the directory where the .dot file will be written.
  * @param tiledTAName the name of the Tiled TA.
- * @param tiledTA a json representation of the Tiled TA to convert into .dot format.
+ * @param tiledTA a graph representation of the Tiled TA to convert into .dot format.
  */
-void convertTiledTAtoDOT(const std::string &outputDOTDirPath, const std::string &tiledTAName, const json &tiledTA)
+void convertTiledTAtoDOT(const std::string &outputDOTDirPath, const std::string &tiledTAName, const TAGraph &tiledTA)
 {
     TADotConverter taDotConverter(outputDOTDirPath + "/" += (tiledTAName + ".dot"));
     taDotConverter.translateTAtoDot(tiledTAName, tiledTA);
@@ -44,9 +48,9 @@ void convertTiledTAtoDOT(const std::string &outputDOTDirPath, const std::string
  * Function used to convert a TA to a .tck file.
  * @param outputDirPath the path to the directory where the .tck file will be written.
  * @param tiledTAName the name of the Tiled TA.
- * @param tiledTA a json representation of the Tiled TA to convert into .tck format.
+ * @param tiledTA a graph representation of the Tiled TA to convert into .tck format.
  */
-void convertTiledTAtoTCK(const std::string &outputDirPath, const std::string &tiledTAName, const json &tiledTA)
+void convertTiledTAtoTCK(const std::string &outputDirPath, const std::string &tiledTAName, const TAGraph &tiledTA)
 {
     Translator translator(outputDirPath + "/" += (tiledTAName + ".tck"));
     translator.translateTA(tiledTAName, tiledTA);
@@ -54,6 +58,37 @@ void convertTiledTAtoTCK(const std::string &outputDirPath, const std::string &ti
 }
 
 
+/**
+ * Function used to compile a batch of compositional strings, one per line, writing the .tck and .dot files of each TA.
+ * The strings are taken from the file given with the 'bat' command, or from the standard input if the file is '-'.
+ * @param cliHandler the handler of the command line arguments.
+ * @param stringsGetter the getter of the paths to the input and output directories.
+ * @return EXIT_SUCCESS if all the strings have been compiled, EXIT_FAILURE otherwise.
+ */
+int compileBatch(CliHandler &cliHandler, StringsGetter &stringsGetter)
+{
+    std::string batchPath = cliHandler.getCmdArgument(bat);
+    unsigned int threads = cliHandler.isCmd(thr) ? cliHandler.getNumericCmdArgument(thr, UINT_MAX) : std::thread::hardware_concurrency();
+
+    TABatchCompiler taBatchCompiler(stringsGetter);
+    if (batchPath == "-")
+        taBatchCompiler.readBatch(std::cin, "BatchTA_");
+    else
+    {
+        std::ifstream batchFile(batchPath);
+        if (!batchFile)
+        {
+            std::cerr << BHRED << "Unable to open file: " << batchPath << rstColor << std::endl;
+            return EXIT_FAILURE;
+        }
+        taBatchCompiler.readBatch(batchFile, "BatchTA_");
+    }
+
+    taBatchCompiler.compileBatch(threads);
+    return (taBatchCompiler.printReport() == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
 #ifndef TILE_TYPE_DEFINED
 /**
  * Function used to insert in the 'tiles' vector the name of the tile and its json representation.
@@ -95,8 +130,13 @@ int main(int argc, char *argv[])
     {
         CliHandler cliHandler(&argc, &argv);
         StringsGetter stringsGetter(cliHandler);
+        TAGraph::setLazyComposition(cliHandler.isCmd(lzy));
+
+        // If the command 'bat' is set, a whole batch of compositional strings is compiled instead of a single TA.
+        if (cliHandler.isCmd(bat))
+            return compileBatch(cliHandler, stringsGetter);
 
-        json tiledTA {};
+        TAGraph tiledTA {};
 
         // If the command 'inp' is set, we generate the Tiled TA using the parser, otherwise we use the default construction.
         if (cliHandler.isCmd(inp))
@@ -118,7 +158,7 @@ int main(int argc, char *argv[])
 
             // TODO: maybe here you should specify a string with which to decide how to default connect tiles.
             TATileConstructor taTileConstructor(tiles);
-            tiledTA = taTileConstructor.createTAFromTiles();
+            tiledTA = TAGraph::fromJson(std::make_shared<const json>(taTileConstructor.createTAFromTiles()));
         }
 #endif
 
@@ -134,6 +174,10 @@ int main(int argc, char *argv[])
             convertTiledTAtoTCK(stringsGetter.getOutputDirPath(), tiledTAName, tiledTA);
 
     } catch (CommandNotProvidedException &e)
+    {
+        std::cerr << BHRED << e.what() << rstColor << std::endl;
+        return EXIT_FAILURE;
+    } catch (InvalidCommandArgumentException &e)
     {
         std::cerr << BHRED << e.what() << rstColor << std::endl;
         return EXIT_FAILURE;
@@ -142,6 +186,10 @@ int main(int argc, char *argv[])
         std::cerr << BHRED << e.what() << rstColor << std::endl;
         return EXIT_FAILURE;
     } catch (NeededTilesNotPresentException &e)
+    {
+        std::cerr << BHRED << e.what() << rstColor << std::endl;
+        return EXIT_FAILURE;
+    } catch (TileSyntaxException &e)
     {
         std::cerr << BHRED << e.what() << rstColor << std::endl;
         return EXIT_FAILURE;
@@ -4,10 +4,12 @@
 
 #include "defines/ANSI-color-codes.h"
 #include "TAHeaders/TAutotTranslator.hpp"
+#include "TAHeaders/TASnapshot.hpp"
 #include "utilities/StringsGetter.hpp"
 #include "utilities/PrintUtilities.hpp"
 #include "utilities/Utils.hpp"
 #include "utilities/CliHandler.hpp"
+#include "utilities/OutputManifest.hpp"
 #include "Structs.h"
 
 using json = nlohmann::json;
@@ -41,10 +43,14 @@ int main(int argc, char *argv[])
         // An integer that will grow at each conversion leading to unique TA names.
         int idTA = 0;
 
-        deleteDirectoryContents(stringsGetter.getOutputDirPath());
+        // Only the TAs which changed since the last run (or whose outputs are missing) are converted again.
+        OutputManifest manifest(stringsGetter.getOutputDirPath(), cliHandler.isCmd(nrt) ? nrt : "", cliHandler.isCmd(frc));
 
         try
         {
+            // The snapshots of the TAs that are no longer in the input directory are removed.
+            TASnapshot::removeOrphanSnapshots(stringsGetter.getInputDirPath());
+
             for (const auto &entry: getEntriesInAlphabeticalOrder(stringsGetter.getInputDirPath()))
             {
                 if (std::filesystem::is_regular_file(entry))
@@ -58,38 +64,53 @@ int main(int argc, char *argv[])
                     {
                         try
                         {
-                            // We obtain the json representation of a TA from the xml generated by UPPAAL.
-                            json j = getJsonFromFileStream(file);
-
                             std::string nameTA = getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0);
                             std::string outputFileName = nameTA + ".tck";
                             d_entry.nameTA = nameTA;
 
                             printTitle(nameTA, static_cast<std::string>(entry.path()), outputFileName, stringsGetter.getOutputDirPath());
 
-                            Translator translator(stringsGetter.getOutputDirPath() + "/" += outputFileName);
+                            // The -jsn option needs the TA to be parsed, hence in that case the conversion is never skipped.
+                            uint64_t inputHash = OutputManifest::getFileHash(entry.path());
+                            if (!cliHandler.isCmd(jsn) && manifest.isUpToDate(nameTA, inputHash))
+                            {
+                                std::cout << BHGRN << "Up-to-date, conversion skipped" << rstColor << std::endl;
+                                d_entry.translationResult = manifest.getStoredResult(nameTA);
+                                manifest.keep(nameTA);
+                                idTA++;
+                            } else
+                            {
+                                // We obtain the json representation of a TA from the xml generated by UPPAAL (or from its snapshot).
+                                json j = TASnapshot::loadTA(entry.path());
 
-                            if (cliHandler.isCmd(jsn))
-                                std::cout << std::setw(4) << j << std::endl;
+                                Translator translator(stringsGetter.getOutputDirPath() + "/" += outputFileName);
 
-                            if (cliHandler.isCmd(nrt))
-                            {
-                                if (Translator::isNRT(j))
+                                if (cliHandler.isCmd(jsn))
+                                    std::cout << std::setw(4) << j << std::endl;
+
+                                if (cliHandler.isCmd(nrt))
                                 {
-                                    // If -nrt option is enabled and the TA is actually a nrt, we proceed in its translation.
-                                    startTranslation(translator, nameTA, j, d_entry);
+                                    if (Translator::isNRT(j))
+                                    {
+                                        // If -nrt option is enabled and the TA is actually a nrt, we proceed in its translation.
+                                        startTranslation(translator, nameTA, j, d_entry);
+                                    } else
+                                    {
+                                        // If -nrt option is enabled and the TA is not a nrt, we stop its translation and raise an error.
+                                        std::cerr << BHRED << "Error: " << entry.path() << " is not an nrtTA and thus will not be translated" << rstColor << std::endl;
+                                        d_entry.translationResult = false;
+                                    }
                                 } else
                                 {
-                                    // If -nrt option is enabled and the TA is not a nrt, we stop its translation and raise an error.
-                                    std::cerr << BHRED << "Error: " << entry.path() << " is not an nrtTA and thus will not be translated" << rstColor << std::endl;
-                                    d_entry.translationResult = false;
+                                    // The normal translation (without any option enabled) is carried out.
+                                    startTranslation(translator, nameTA, j, d_entry);
                                 }
-                            } else
-                            {
-                                // The normal translation (without any option enabled) is carried out.
-                                startTranslation(translator, nameTA, j, d_entry);
+                                idTA++;
+
+                                // A TA which has not been translated has no output, but its result is still recorded.
+                                manifest.record(nameTA, inputHash, d_entry.translationResult ? std::vector<std::string> { outputFileName } : std::vector<std::string> {},
+                                                d_entry.translationResult);
                             }
-                            idTA++;
 
                         } catch (NotXMLFormatException &e)
                         {
@@ -104,6 +125,10 @@ int main(int argc, char *argv[])
                 dashboardResults.push_back(d_entry);
                 std::cout << std::string(21, '-') << std::endl;
             }
+            // Outputs of TAs that are no longer in the input directory are removed.
+            manifest.prune();
+            manifest.save();
+
             // At the end we print a convenient dashboard to quickly check the results.
             printDashBoard(dashboardResults, true, false);
 
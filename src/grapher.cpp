@@ -4,9 +4,11 @@
 
 #include "defines/ANSI-color-codes.h"
 #include "TAHeaders/TADotConverter.hpp"
+#include "TAHeaders/TASnapshot.hpp"
 #include "utilities/StringsGetter.hpp"
 #include "utilities/Utils.hpp"
 #include "utilities/CliHandler.hpp"
+#include "utilities/OutputManifest.hpp"
 
 using json = nlohmann::json;
 
@@ -15,15 +17,15 @@ using json = nlohmann::json;
  * Function used to translate a .xml file into a .dot file, writing it into a specified output directory.
  * @param outputDirPath the output directory from which to write the resulting .dot file.
  * @param outputFileName the name of the resulting .dot file.
- * @param fileToConvert the .xml file to convert into .dot format.
+ * @param fileToConvert the path to the .xml file to convert into .dot format.
 */
-void convertXMLtoDOT(const std::string &outputDirPath, const std::string &outputFileName, std::ifstream &fileToConvert)
+void convertXMLtoDOT(const std::string &outputDirPath, const std::string &outputFileName, const std::string &fileToConvert)
 {
     TADotConverter taDotConverter(outputDirPath + "/" += (outputFileName + ".dot"));
     try
     {
         // Converting the .xml file into .dot format.
-        taDotConverter.translateTAtoDot(outputFileName, getJsonFromFileStream(fileToConvert));
+        taDotConverter.translateTAtoDot(outputFileName, TASnapshot::loadTA(fileToConvert));
 
     } catch (NotXMLFormatException &e)
     {
@@ -36,21 +38,42 @@ void convertXMLtoDOT(const std::string &outputDirPath, const std::string &output
  * Function used to translate all .dot files from a given directory into .pdf files into a specified output directory.
  * @param sourceDirPath the directory from which to take the .dot files to translate.
  * @param outputDirPath the directory from which to write the resulting .pdf files.
+ * @param force true if all the .pdf files have to be generated again, even if their .dot file did not change.
  */
-void convertDOTtoPDF(const std::string &sourceDirPath, const std::string &outputDirPath)
+void convertDOTtoPDF(const std::string &sourceDirPath, const std::string &outputDirPath, bool force)
 {
     std::cout << "Starting conversion from .dot to .pdf file format." << std::endl;
     std::cout << std::string(50, '-') << std::endl;
 
+    OutputManifest manifest(outputDirPath, "dot -Tpdf", force);
+
     for (const auto &entry: getEntriesInAlphabeticalOrder(sourceDirPath))
     {
-        std::string outputFileName = getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0) + ".pdf";
+        if (entry.path().extension() != ".dot")
+            continue;
 
+        std::string dotName = getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0);
+        std::string outputFileName = dotName + ".pdf";
         std::string outputDirFile = outputDirPath + "/" += outputFileName;
-        system(("dot -Tpdf -o " + outputDirFile + " " + static_cast<std::string>(entry.path())).c_str());
+
+        uint64_t dotHash = OutputManifest::getFileHash(entry.path());
+        if (manifest.isUpToDate(dotName, dotHash))
+        {
+            manifest.keep(dotName);
+            std::cout << "Up-to-date file: " << outputDirFile << "\n\n";
+            continue;
+        }
+
+        // If the rendering fails, the .pdf file is not recorded so that it will be generated again in the next run.
+        if (system(("dot -Tpdf -o " + outputDirFile + " " + static_cast<std::string>(entry.path())).c_str()) == 0)
+            manifest.record(dotName, dotHash, { outputFileName });
 
         std::cout << "Written file from: " << entry.path() << std::endl << "to: " << outputDirFile << "\n\n";
     }
+
+    // The .pdf files whose .dot file has been removed are deleted.
+    manifest.prune();
+    manifest.save();
 }
 
 
@@ -61,13 +84,15 @@ int main(int argc, char *argv[])
         CliHandler cliHandler(&argc, &argv);
         StringsGetter stringsGetter(cliHandler);
 
-        deleteDirectoryContents(stringsGetter.getOutputPDFsDirPath());
-
         if (!cliHandler.isCmd(rfd))
         {
-            deleteDirectoryContents(stringsGetter.getOutputDOTsDirPath());
+            // Only the TAs which changed since the last run (or whose .dot file is missing) are translated again.
+            OutputManifest manifest(stringsGetter.getOutputDOTsDirPath(), "", cliHandler.isCmd(frc));
             try
             {
+                // The snapshots of the TAs that are no longer in the input directory are removed.
+                TASnapshot::removeOrphanSnapshots(stringsGetter.getInputDirPath());
+
                 for (const auto &entry: getEntriesInAlphabeticalOrder(stringsGetter.getInputDirPath()))
                 {
                     if (std::filesystem::is_regular_file(entry))
@@ -82,13 +107,26 @@ int main(int argc, char *argv[])
                             // Computing the name of the .dot file to subsequently translate into PDF format.
                             std::string outputFileName = getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0);
 
-                            std::cout << "Starting translation from .xml to .dot of file:\n" << entry.path() << std::endl;
-
-                            convertXMLtoDOT(stringsGetter.getOutputDOTsDirPath(), outputFileName, file);
+                            uint64_t inputHash = OutputManifest::getFileHash(entry.path());
+                            if (manifest.isUpToDate(outputFileName, inputHash))
+                            {
+                                std::cout << "Up-to-date .dot file for:\n" << entry.path() << std::endl;
+                                manifest.keep(outputFileName);
+                            } else
+                            {
+                                std::cout << "Starting translation from .xml to .dot of file:\n" << entry.path() << std::endl;
+
+                                convertXMLtoDOT(stringsGetter.getOutputDOTsDirPath(), outputFileName, entry.path());
+                                manifest.record(outputFileName, inputHash, { outputFileName + ".dot" });
+                            }
                         }
                     }
                     std::cout << std::endl;
                 }
+
+                // The .dot files of TAs that are no longer in the input directory are removed.
+                manifest.prune();
+                manifest.save();
             } catch (const std::filesystem::filesystem_error &e)
             {
                 std::cerr << BHRED << "Error while reading directory: " << e.what() << rstColor << std::endl;
@@ -97,7 +135,7 @@ int main(int argc, char *argv[])
         }
 
         // At the end, we translate all the .dot files into .pdf files.
-        convertDOTtoPDF(stringsGetter.getOutputDOTsDirPath(), stringsGetter.getOutputPDFsDirPath());
+        convertDOTtoPDF(stringsGetter.getOutputDOTsDirPath(), stringsGetter.getOutputPDFsDirPath(), cliHandler.isCmd(frc));
 
     } catch (CommandNotProvidedException &e)
     {
@@ -1,5 +1,13 @@
+#include <atomic>
+#include <climits>
+#include <condition_variable>
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
 #include "nlohmann/json.hpp"
 
 #include "utilities/Utils.hpp"
@@ -7,13 +15,22 @@
 #include "utilities/CliHandler.hpp"
 #include "TAHeaders/TADotConverter.hpp"
 #include "TAHeaders/TAutotTranslator.hpp"
+#include "TAHeaders/TAGraph.hpp"
 #include "TAHeaders/TATileHeaders/regexGenerator/TATileRegExGenerator.hpp"
 #include "TAHeaders/TATileHeaders/regexGenerator/TATileRegExGeneratorStrict.hpp"
+#include "TAHeaders/TATileHeaders/regexGenerator/TATileRegExGeneratorBoltzmann.hpp"
 #include "TAHeaders/TATileHeaders/lexerAndParser/TATileInputParser.hpp"
 #include "utilities/Logger.hpp"
 #include "TAHeaders/TATileHeaders/TATileRenamer.hpp"
 #include "utilities/CommandReader.hpp"
 #include "TAHeaders/TABoundsCalculator.hpp"
+#include "utilities/RandomStream.hpp"
+#include "utilities/BoundedQueue.hpp"
+#include "utilities/PrintUtilities.hpp"
+#include "TAHeaders/TAChecker.hpp"
+#include "TAHeaders/TAResultsStore.hpp"
+#include "TAHeaders/TACanonicalHasher.hpp"
+#include "utilities/CampaignJournal.hpp"
 
 using json = nlohmann::json;
 
@@ -22,10 +39,10 @@ using json = nlohmann::json;
  * Function used to print the TiledTA.
  * @param tiledTA the TiledTA to print.
  */
-void printTiledTA(const json &tiledTA)
+void printTiledTA(const TAGraph &tiledTA)
 {
     std::cout << "\n\nResultingTiledTA:\n\n";
-    std::cout << std::setw(4) << tiledTA << std::endl;
+    std::cout << std::setw(4) << tiledTA.toJson() << std::endl;
 }
 
 
@@ -33,9 +50,9 @@ void printTiledTA(const json &tiledTA)
  * Function used to convert a TA to a .dot file.
  * @param outputDOTDirPath the path to the directory where the .dot file will be written.
  * @param tiledTAName the name of the Tiled TA.
- * @param tiledTA a json representation of the Tiled TA to convert into .dot format.
+ * @param tiledTA a graph representation of the Tiled TA to convert into .dot format.
  */
-void convertTiledTAtoDOT(const std::string &outputDOTDirPath, const std::string &tiledTAName, const json &tiledTA)
+void convertTiledTAtoDOT(const std::string &outputDOTDirPath, const std::string &tiledTAName, const TAGraph &tiledTA)
 {
     TADotConverter taDotConverter(outputDOTDirPath + "/" += (tiledTAName + ".dot"));
     taDotConverter.translateTAtoDot(tiledTAName, tiledTA);
@@ -46,9 +63,9 @@ void convertTiledTAtoDOT(const std::string &outputDOTDirPath, const std::string
  * Function used to convert a TA to a .tck file.
  * @param outputDirPath the path to the directory where the .tck file will be written.
  * @param tiledTAName the name of the Tiled TA.
- * @param tiledTA a json representation of the Tiled TA to convert into .tck format.
+ * @param tiledTA a graph representation of the Tiled TA to convert into .tck format.
  */
-void convertTiledTAtoTCK(const std::string &outputDirPath, const std::string &tiledTAName, const json &tiledTA)
+void convertTiledTAtoTCK(const std::string &outputDirPath, const std::string &tiledTAName, const TAGraph &tiledTA)
 {
     Translator translator(outputDirPath + "/" += (tiledTAName + ".tck"));
     translator.translateTA(tiledTAName, tiledTA);
@@ -72,25 +89,33 @@ void cleanDirectories(StringsGetter &stringsGetter)
 }
 
 
+/**
+ * Function used to remove the outputs written for a single test, e.g., when a test interrupted in the middle is generated again.
+ * @param stringsGetter a 'StringsGetter' that will retrieve the paths of the outputs.
+ * @param nameTA the name of the TA of the test.
+ */
+void removeTestOutputs(StringsGetter &stringsGetter, const std::string &nameTA)
+{
+    std::error_code errorCode {};
+    std::filesystem::remove(stringsGetter.getOutputDirForCheckingPathLogs() + "/" + nameTA + ".txt", errorCode);
+    std::filesystem::remove(stringsGetter.getTestingResourceUsageDirPath() + "/" + nameTA + ".txt", errorCode);
+    std::filesystem::remove(stringsGetter.getOutputDOTsDirPath() + "/" + nameTA + ".dot", errorCode);
+    std::filesystem::remove(stringsGetter.getOutputDirPath() + "/" + nameTA + ".tck", errorCode);
+    for (const char *prefix: { "lt2C_", "gt2C_", "lt2C_tmp_" })
+        std::filesystem::remove(stringsGetter.getOutputDirForCheckingPath() + "/" + prefix + nameTA + ".tck", errorCode);
+}
+
+
 /**
  * Function used to collect the name of all the used tiles inside the randomly-generated regular expression.
+ * The expression is written with the symbols of the tiles (e.g., 't3'), which are mapped to their names by the lexer.
  * @param regEx the regular expression in which to look for the used tiles.
  * @param parser an instance of the parser.
  * @return a vector containing the name of all the used tiles.
  */
 std::vector<std::string> gatherUsedTiles(const std::string &regEx, TATileInputParser &parser)
 {
-    std::vector<std::string> usedTiles {};
-
-    for (const std::string &tile: parser.getBinTileSymbols())
-        if (regEx.find(tile) != std::string::npos)
-            usedTiles.push_back(tile);
-
-    for (const std::string &tile: parser.getTriTileSymbols())
-        if (regEx.find(tile) != std::string::npos)
-            usedTiles.push_back(tile);
-
-    return usedTiles;
+    return parser.getUsedBinAndTriTiles(regEx);
 }
 
 
@@ -118,239 +143,414 @@ void writeLogs(StringsGetter &stringsGetter, TATileInputParser &parser, const st
 }
 
 
+
+
+// A test of the campaign, as it goes through generation, composition, translation and checking.
+typedef struct ct {
+    int index;
+    std::string nameTA;
+    std::string regEx;
+    // The random stream of the test, as left by the generation of its regular expression.
+    std::mt19937 generator;
+    TAGraph tiledTA;
+    std::vector<Bound> bounds;
+    // The hash of the canonical form of the TA, and the name of the checked TA it is a duplicate of (empty if none).
+    std::string canonicalHash;
+    std::string duplicateOf;
+    bool isAccepting;
+    // The error raised by the test, empty as long as the test goes through the stages successfully.
+    std::string error;
+} CampaignTest;
+
+
 /**
- * Function which, by calling a shell script, collects all the results in a single file.
+ * Function used to build the record of a test for the results store.
+ * The record of a duplicate copies the one of the checked TA it is a duplicate of, which is already in the store.
  * @param stringsGetter a strings getter.
+ * @param parser an instance of the parser.
+ * @param resultsStore the results store.
+ * @param test the test.
+ * @param isChecked true if the emptiness of the TA has been checked.
+ * @return the record of the test.
  */
-void gatherResults(StringsGetter &stringsGetter, CliHandler &cliHandler)
+json getTestRecord(StringsGetter &stringsGetter, TATileInputParser &parser, TAResultsStore &resultsStore, const CampaignTest &test, bool isChecked)
 {
-    system(
-            spaceStr({
-                             stringsGetter.getOtherScriptsPath() + "/collectResults.sh", // Script name
-                             stringsGetter.getOutputDirForCheckingPathLogs(),            // $1
-                             stringsGetter.getTestingResultsDirPath(),                   // $2
-                             stringsGetter.getTCheckerBinPath(),                         // $3
-                             std::to_string(cliHandler.isCmd(atc)), // $4
-                             std::to_string(cliHandler.isCmd(all))  // $5
-                     }).c_str());
+    if (!test.duplicateOf.empty())
+        if (std::optional<json> original = resultsStore.findCheckedRecord(test.canonicalHash))
+            return TAResultsStore::buildDuplicateRecord(test.nameTA, test.regEx, gatherUsedTiles(test.regEx, parser), test.bounds, *original);
+
+    return TAResultsStore::buildRecord(test.nameTA, test.regEx, gatherUsedTiles(test.regEx, parser), test.bounds,
+                                       test.canonicalHash, isChecked, test.isAccepting,
+                                       stringsGetter.getOutputDirForCheckingPathLogs(),
+                                       stringsGetter.getTestingResourceUsageDirPath());
 }
 
 
 /**
- * Function used to get the mean out of a set of values obtained by running the 'cmd' command.
- * @param totalRuns the total number of elements over which we compute the mean.
- * @param cmd the command used to get the set of values to average.
- * @return an average of the collected values.
+ * Function used to check the emptiness of a generated test (only if the checker has to be run automatically) and to
+ * append its record to the results store, as soon as the test has been generated, so that the tests completed before an
+ * interruption are not generated again when the campaign is resumed.
+ * A TA with the same canonical hash as an already checked one (in this campaign or, if resumed, before) is not checked
+ * again: the verdict of the checked TA is copied into its record.
+ * @param stringsGetter a strings getter.
+ * @param parser an instance of the parser.
+ * @param taChecker the checker of the TAs.
+ * @param resultsStore the results store.
+ * @param test the generated test.
+ * @param isChecked true if the emptiness of the TA has to be checked.
  */
-double getMeanResourceUsage(int totalRuns, const std::string &cmd)
+void checkAndStoreTest(StringsGetter &stringsGetter, TATileInputParser &parser, TAChecker &taChecker, TAResultsStore &resultsStore,
+                       CampaignTest &test, bool isChecked)
 {
-    // TODO: you can merge this function with the peak one, use th same for loop and return a pair of doubles.
-    // Collecting the set of values (as strings) to average.
-    std::string resourceValues { Command::exec(cmd) };
-
-    // Tokenizing the previous values in order to get single values.
-    std::vector<std::string> tokenizedRV { getTokenizedString(resourceValues, '\n') };
-
-    // The maximum value a double can get is 1.79769e+308. For this reason, no side check on overflows are made, since
-    // either for memory or time it would be more than enough to fit the total inside while performing the sums below.
-    double meanValue { 0 };
-    for (const std::string &rv: tokenizedRV)
-        meanValue += std::stod(rv);
+    if (isChecked)
+    {
+        std::cout << "\n-------- " << test.nameTA << " --------\n";
+        if (std::optional<json> original = resultsStore.findCheckedRecord(test.canonicalHash))
+        {
+            test.duplicateOf = original->at("name").get<std::string>();
+            test.isAccepting = (original->at("verdict") == "not empty");
+            std::cout << "Same TA as " << test.duplicateOf << ", copying its verdict.\n";
+        } else
+            test.isAccepting = taChecker.checkTA(test.nameTA);
+        std::cout << std::string(21, '-') << std::endl;
+    }
 
-    return meanValue / totalRuns;
+    resultsStore.append(getTestRecord(stringsGetter, parser, resultsStore, test, isChecked));
 }
 
 
 /**
- * Function used to get the maximum out of a set of values obtained by running the 'cmd' command.
- * @param cmd the command used to get the set of values from which to get the maximum.
- * @return the maximum of the collected values.
+ * Function used to generate the tests on a pool of threads, each with its own parser, while the calling thread checks and
+ * stores them in order, as soon as they are generated (see 'checkAndStoreTest').
+ * If a seed is given, test i draws its random numbers from the stream derived from the seed and from i, hence the
+ * same seed always gives the same tests, whatever the number of threads (and a failing test can be generated again alone,
+ * with the 'idx' command).
+ * With more than one thread the standard output is silenced and only the progress is printed, since the logs of concurrent
+ * tests would be interleaved; with a single thread each test is generated and checked on the calling thread.
+ * @param stringsGetter a strings getter.
+ * @param cliHandler a cliHandler.
+ * @param resultsStore the results store.
+ * @param taTileRegExGenerator the generator of the regular expressions, shared by all the threads.
+ * @param indices the indexes of the tests to generate.
+ * @param isSeeded true if the tests must be generated from the given seed.
+ * @param seed the seed from which the random stream of each test is derived.
+ * @param threads the number of threads generating the tests (at least one).
+ * @return the number of tests that could not be generated.
  */
-double getPeakResourceUsage(const std::string &cmd)
+int runTestsConcurrently(StringsGetter &stringsGetter, CliHandler &cliHandler, TAResultsStore &resultsStore,
+                         TATileRegExGenerator &taTileRegExGenerator, const std::vector<int> &indices, bool isSeeded, uint64_t seed, unsigned int threads)
 {
-    // Collecting the set of values (as strings) to average.
-    std::string resourceValues { Command::exec(cmd) };
+    int numTests { static_cast<int>(indices.size()) };
+    threads = std::max(1u, std::min<unsigned int>(threads, static_cast<unsigned int>(numTests)));
+    bool isVerbose { threads == 1 };
+    bool isChecked { cliHandler.isCmd(atc) };
 
-    // Tokenizing the previous values in order to get single values.
-    std::vector<std::string> tokenizedRV { getTokenizedString(resourceValues, '\n') };
+    std::vector<CampaignTest> tests(numTests);
 
-    // Getting the maximum out of the set of collected values.
-    double maxValue { 0 };
-    for (const std::string &rv: tokenizedRV)
-        maxValue = (std::stod(rv) > maxValue) ? std::stod(rv) : maxValue;
+    // The tests whose generation is over, which the calling thread waits for in order.
+    std::vector<bool> isGenerated(numTests, false);
+    std::mutex generatedMutex;
+    std::condition_variable generatedCondition;
 
-    return maxValue;
-}
+    std::atomic<int> next { 0 };
 
+    auto generate = [&](TATileInputParser &taTileInputParser, int k) {
+        int i { indices[k] };
 
-/**
- * Function used to print to a file the resources utilization obtained after running tests.
- * @param stringsGetter a strings getter.
- */
-void gatherResourcesUsage(StringsGetter &stringsGetter)
-{
-    for (const auto &entry: getEntriesInAlphabeticalOrder(stringsGetter.getTestingResourceUsageDirPath()))
+        if (isSeeded)
+            RandomStream::seed(seed, static_cast<uint64_t>(i));
+
+        TABoundsCalculator::resetBoundCalculator();
+        TATileRenamer::resetTANonce();
+
+        CampaignTest &test = tests[k];
+        test.index = i;
+        test.nameTA = "RegExTA_" + std::to_string(i);
+
+        try
+        {
+            test.regEx = taTileRegExGenerator.generateRegEx();
+            std::cout << "Obtained string:\n" << test.regEx << "\n";
+
+            TAGraph tiledTA = taTileInputParser.getTiledTA(test.regEx);
+            test.canonicalHash = TACanonicalHasher::getCanonicalHash(tiledTA);
+
+            writeLogs(stringsGetter, taTileInputParser, test.nameTA, test.regEx);
+
+            if (isVerbose)
+                printTiledTA(tiledTA);
+            convertTiledTAtoDOT(stringsGetter.getOutputDOTsDirPath(), test.nameTA, tiledTA);
+            convertTiledTAtoTCK(stringsGetter.getOutputDirPath(), test.nameTA, tiledTA);
+
+            test.bounds = TABoundsCalculator::getPathBounds();
+        } catch (std::exception &e)
+        {
+            test.error = e.what();
+        }
+    };
+
+    auto worker = [&]() {
+        TATileInputParser taTileInputParser(stringsGetter);
+        for (int k = next++; k < numTests; k = next++)
+        {
+            generate(taTileInputParser, k);
+            {
+                std::lock_guard<std::mutex> lock(generatedMutex);
+                isGenerated[k] = true;
+            }
+            generatedCondition.notify_all();
+        }
+    };
+
+    // The progress is printed on the buffer of the standard output, which is silenced for the workers.
+    std::ostream progress(std::cout.rdbuf());
+
+    TATileInputParser taTileInputParser(stringsGetter);
+    TAChecker taChecker(stringsGetter, cliHandler);
+    std::vector<DashBoardEntry> dashboardResults {};
+    int failed { 0 };
+
+    auto collect = [&](int k) {
+        CampaignTest &test = tests[k];
+        if (!test.error.empty())
+        {
+            failed++;
+            std::cerr << BHRED << test.nameTA << (isSeeded ? " (seed " + std::to_string(seed) + ")" : "") << ": " << test.error << rstColor << '\n';
+            return;
+        }
+
+        checkAndStoreTest(stringsGetter, taTileInputParser, taChecker, resultsStore, test, isChecked);
+        if (isChecked)
+            dashboardResults.push_back({ test.nameTA, false, test.isAccepting });
+
+        if (!isVerbose)
+            progress << "[" << (k + 1) << "/" << numTests << "] " << test.nameTA
+                     << (isChecked ? (test.isAccepting ? ": language is not empty" : ": language is empty") : "")
+                     << (test.duplicateOf.empty() ? "" : " (same TA as " + test.duplicateOf + ")") << std::endl;
+    };
+
+    if (isVerbose)
+    {
+        for (int k = 0; k < numTests; k++)
+        {
+            generate(taTileInputParser, k);
+            collect(k);
+        }
+    } else
     {
-        std::string entryPath { static_cast<std::string>(entry.path()) };
-        std::string nameTA { getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0) };
-
-        std::ofstream out;
-        std::string outputFileName { "ResourceUsages.txt" };
-        out.open(stringsGetter.getTestingResultsDirPath() + "/" + outputFileName, std::ofstream::out | std::ofstream::app);
-
-        // Now getting the total number of locations and transitions of a given TA.
-
-        std::string totalLocations_command { "grep \"TOTAL_LOCATIONS\" " + entryPath + " | awk '{print $NF}'" };
-        int totalLocations { std::stoi(Command::exec(totalLocations_command)) };
-
-        std::string totalTransitions_command { "grep \"TOTAL_TRANSITIONS\" " + entryPath + " | awk '{print $NF}'" };
-        int totalTransitions { std::stoi(Command::exec(totalTransitions_command)) };
-
-        // Now getting the total number of runs in order to use it in computing averages.
-        // The number of total runs is equal to the number of times tChecker has been called during the check
-        // of the parameter being > 2C and the parameter being < 2C, conditioned by the fact of having enabled the
-        // option to get the full range of suitable parameters and not stopping at the first one found.
-        // Please note that this should work also for non-parametric TAs.
-
-        std::string totalRuns_command { "grep -c \"CYCLE\" " + entryPath };
-        int totalRuns { std::stoi(Command::exec(totalRuns_command)) };
-
-        // Now getting the average and peak resources' utilization.
-        // The meanRunningTime will be the mean time spent by executing the algorithm in tChecker (e.g. the couvscc).
-        // The meanExecutionTime will be the mean time spent executing tChecker (plus some small overhead for the shell script).
-
-        std::string runningTime_command { "grep \"RUNNING_TIME_SECONDS\" " + entryPath + " | awk '{print $NF}'" };
-        double meanRunningTime { getMeanResourceUsage(totalRuns, runningTime_command) };
-        double peakRunningTime { getPeakResourceUsage(runningTime_command) };
-
-        std::string memoryMaxRSS_command { "grep \"MEMORY_MAX_RSS\" " + entryPath + " | awk '{print $NF}'" };
-        double meanMemoryMaxRSS { getMeanResourceUsage(totalRuns, memoryMaxRSS_command) };
-        double peakMemoryMaxRSS { getPeakResourceUsage(memoryMaxRSS_command) };
-
-        std::string storedStates_command { "grep \"STORED_STATES\" " + entryPath + " | awk '{print $NF}'" };
-        double meanStoredStates { getMeanResourceUsage(totalRuns, storedStates_command) };
-
-        std::string visitedStates_command { "grep \"VISITED_STATES\" " + entryPath + " | awk '{print $NF}'" };
-        double meanVisitedStates { getMeanResourceUsage(totalRuns, visitedStates_command) };
-
-        std::string visitedTransitions_command { "grep \"VISITED_TRANSITIONS\" " + entryPath + " | awk '{print $NF}'" };
-        double meanVisitedTransitions { getMeanResourceUsage(totalRuns, visitedTransitions_command) };
-
-        std::string executionTime_command { "grep \"EXECUTION_TIME\" " + entryPath + " | awk '{print $NF}'" };
-        double meanExecutionTime { getMeanResourceUsage(totalRuns, executionTime_command) };
-        double peakExecutionTime { getPeakResourceUsage(executionTime_command) };
-
-        // Now printing results to the file.
-
-        out << nameTA << '\n';
-        out << std::string(nameTA.length(), '-') << '\n';
-        out << "Total number of locations:                     " << totalLocations << '\n';
-        out << "Total number of transitions:                   " << totalTransitions << '\n';
-        out << "Total number of runs:                          " << totalRuns << '\n';
-        out << "Mean algorithm running time [milliseconds]:    " << meanRunningTime * 1000 << '\n';
-        out << "Peak algorithm running time [milliseconds]:    " << peakRunningTime * 1000 << '\n';
-        out << "Mean tChecker running time [milliseconds]:     " << meanExecutionTime << '\n';
-        out << "Peak tChecker running time [milliseconds]:     " << peakExecutionTime << '\n';
-        out << "Mean maximum memory utilization [Bytes]:       " << meanMemoryMaxRSS << '\n';
-        out << "Peak maximum memory utilization [Bytes]:       " << peakMemoryMaxRSS << '\n';
-        out << "Mean number of stored zone graph states:       " << meanStoredStates << '\n';
-        out << "Mean number of visited zone graph states:      " << meanVisitedStates << '\n';
-        out << "Mean number of visited zone graph transitions: " << meanVisitedTransitions << '\n';
-        out << "\n\n";
-
-        out.flush();
-        out.close();
+        std::cout.setstate(std::ios::badbit);
+
+        std::vector<std::thread> pool {};
+        for (unsigned int i = 0; i < threads; i++)
+            pool.emplace_back(worker);
+
+        // Collecting the tests in order, while the following ones are still being generated.
+        for (int k = 0; k < numTests; k++)
+        {
+            {
+                std::unique_lock<std::mutex> lock(generatedMutex);
+                generatedCondition.wait(lock, [&]() { return static_cast<bool>(isGenerated[k]); });
+            }
+            collect(k);
+        }
+
+        for (std::thread &thread: pool)
+            thread.join();
+
+        std::cout.clear();
     }
-}
 
+    if (isChecked)
+        printDashBoard(dashboardResults, false, true);
 
-/**
- * Function used to get a value of the parameter found by tChecker.
- * @param stringsGetter a string getter.
- * @param filePath the path to the file in which to look for the parameter value.
- * @return a string containing the parameter value, an empty string if no values have been found.
- */
-std::string getParameterString(StringsGetter &stringsGetter, const std::string &filePath)
-{
-    std::string parString {
-            Command::exec(spaceStr({
-                                           stringsGetter.getOtherScriptsPath() + "/getParameterValue.sh", // Script name
-                                           filePath                                                       // $1
-                                   })) };
-    // Getting rid of the final '\n' character;
-    parString.pop_back();
-
-    return parString;
+    std::cout << ((failed == 0) ? BHGRN : BHYEL) << "Generated " << (numTests - failed) << " out of " << numTests << " tests" << rstColor << std::endl;
+
+    return failed;
 }
 
 
 /**
- * Function used to print the results on bounds after testing has been performed.
+ * Function used to generate the tests as a pipeline made of five stages, each running on its own thread: generation of the
+ * regular expressions, composition of the TAs, translation into .dot and .tck files, emptiness check (only if the checker
+ * has to be run automatically) and collection of the results (on the calling thread).
+ * Consecutive stages are connected by bounded queues, hence test i is checked while the following ones are generated, and
+ * at most 'capacity' tests wait between two stages, whatever the number of tests. The record of each test is appended to
+ * the results store as soon as the test is checked, so partial results can be read while the tests are still running.
+ * As in 'checkAndStoreTest', a TA with the same canonical hash as an already checked one is not checked again.
+ * If a seed is given, test i is the same one generated by 'runTestsConcurrently' with the same seed.
+ * The standard output of the stages is silenced, since the logs of different tests would be interleaved.
+ * @param stringsGetter a strings getter.
  * @param cliHandler a cliHandler.
- * @param out the stream in which to write the results.
- * @param parameterValue the value of the found parameter.
- * @param nameTA the name of the current TA.
+ * @param resultsStore the results store.
+ * @param taTileRegExGenerator the generator of the regular expressions.
+ * @param indices the indexes of the tests to generate.
+ * @param isSeeded true if the tests must be generated from the given seed.
+ * @param seed the seed from which the random stream of each test is derived.
+ * @param capacity the maximum number of tests waiting between two consecutive stages.
+ * @return the number of tests that could not be generated or checked.
  */
-void printBoundResults(CliHandler &cliHandler, std::ofstream &out, double parameterValue, const std::string &nameTA)
+int runTestsPipeline(StringsGetter &stringsGetter, CliHandler &cliHandler, TAResultsStore &resultsStore,
+                     TATileRegExGenerator &taTileRegExGenerator, const std::vector<int> &indices, bool isSeeded, uint64_t seed, size_t capacity)
 {
-    if (cliHandler.isCmd(bds))
-    {
-        out << "The following bounds have been found:\n" << TABoundsCalculator::getBoundsAsString(nameTA);
-        out << "The parameter value is: " << std::fixed << std::setprecision(1) << parameterValue << '\n';
-    }
+    int numTests { static_cast<int>(indices.size()) };
+
+    bool isChecked { cliHandler.isCmd(atc) };
 
-    double strictestBoundSize { std::numeric_limits<double>::max() };
-    Bound resultBound {};
+    BoundedQueue<CampaignTest> generatedTests(capacity);
+    BoundedQueue<CampaignTest> composedTests(capacity);
+    BoundedQueue<CampaignTest> translatedTests(capacity);
+    BoundedQueue<CampaignTest> checkedTests(capacity);
 
-    bool isInBound {};
+    auto generate = [&]() {
+        for (int i: indices)
+        {
+            if (isSeeded)
+                RandomStream::seed(seed, static_cast<uint64_t>(i));
+
+            CampaignTest test {};
+            test.index = i;
+            test.nameTA = "RegExTA_" + std::to_string(i);
+            try
+            {
+                test.regEx = taTileRegExGenerator.generateRegEx();
+            } catch (std::exception &e)
+            {
+                test.error = e.what();
+            }
+            test.generator = RandomStream::getGenerator();
 
-    // Getting the strictest bound as a result.
-    for (const Bound &b: TABoundsCalculator::getStoredBounds(nameTA))
-        if (!(b.isDisjoint || b.isNan) && b.l <= parameterValue && parameterValue <= b.r)
+            generatedTests.push(std::move(test));
+        }
+        generatedTests.close();
+    };
+
+    auto compose = [&]() {
+        TATileInputParser taTileInputParser(stringsGetter);
+        while (std::optional<CampaignTest> test = generatedTests.pop())
         {
-            isInBound = true;
-            double boundSize { TABoundsCalculator::computeBoundSize(b) };
-            if (boundSize <= strictestBoundSize)
+            if (test->error.empty())
             {
-                resultBound = b;
-                strictestBoundSize = boundSize;
+                // Random tiles keep drawing from the stream of the test.
+                RandomStream::restore(test->generator);
+                TABoundsCalculator::resetBoundCalculator();
+                TATileRenamer::resetTANonce();
+
+                try
+                {
+                    test->tiledTA = taTileInputParser.getTiledTA(test->regEx);
+                    test->canonicalHash = TACanonicalHasher::getCanonicalHash(test->tiledTA);
+                    test->bounds = TABoundsCalculator::getPathBounds();
+                } catch (std::exception &e)
+                {
+                    test->error = e.what();
+                }
             }
+            composedTests.push(std::move(*test));
         }
+        composedTests.close();
+    };
 
-    out << "Parameter value: " << std::fixed << std::setprecision(1) << parameterValue
-        << " is within found bound: " << TABoundsCalculator::getBoundAsString(resultBound)
-        << (isInBound ? "true" : "false");
-}
+    auto translate = [&]() {
+        TATileInputParser taTileInputParser(stringsGetter);
+        while (std::optional<CampaignTest> test = composedTests.pop())
+        {
+            if (test->error.empty())
+            {
+                try
+                {
+                    writeLogs(stringsGetter, taTileInputParser, test->nameTA, test->regEx);
+                    convertTiledTAtoDOT(stringsGetter.getOutputDOTsDirPath(), test->nameTA, test->tiledTA);
+                    convertTiledTAtoTCK(stringsGetter.getOutputDirPath(), test->nameTA, test->tiledTA);
+                } catch (std::exception &e)
+                {
+                    test->error = e.what();
+                }
+            }
+            // The TA is not needed anymore once translated.
+            test->tiledTA = TAGraph {};
+            translatedTests.push(std::move(*test));
+        }
+        translatedTests.close();
+    };
+
+    auto check = [&]() {
+        TAChecker taChecker(stringsGetter, cliHandler);
+        // The tests checked by this stage, given their canonical hash: their records may not be in the store yet.
+        std::unordered_map<std::string, std::pair<std::string, bool>> checkedHashes {};
+        while (std::optional<CampaignTest> test = translatedTests.pop())
+        {
+            if (isChecked && test->error.empty())
+            {
+                auto checked = checkedHashes.find(test->canonicalHash);
+                if (checked != checkedHashes.end())
+                {
+                    test->duplicateOf = checked->second.first;
+                    test->isAccepting = checked->second.second;
+                } else if (std::optional<json> original = resultsStore.findCheckedRecord(test->canonicalHash))
+                {
+                    test->duplicateOf = original->at("name").get<std::string>();
+                    test->isAccepting = (original->at("verdict") == "not empty");
+                } else
+                {
+                    try
+                    {
+                        test->isAccepting = taChecker.checkTA(test->nameTA);
+                        checkedHashes.emplace(test->canonicalHash, std::make_pair(test->nameTA, test->isAccepting));
+                    } catch (std::exception &e)
+                    {
+                        test->error = e.what();
+                    }
+                }
+            }
+            checkedTests.push(std::move(*test));
+        }
+        checkedTests.close();
+    };
 
+    // The progress is printed on the buffer of the standard output, which is silenced for the stages.
+    std::ostream progress(std::cout.rdbuf());
+    std::cout.setstate(std::ios::badbit);
 
-/**
- * Function used to print into a file the results concerning the bounds found for the parameter.
- * @param stringsGetter a string getter.
- */
-void checkParameterInterval(StringsGetter &stringsGetter, CliHandler &cliHandler)
-{
-    std::ofstream out;
-    std::string outputFileName { "ParametersBounds.txt" };
-    out.open(stringsGetter.getTestingResultsDirPath() + "/" + outputFileName, std::ofstream::out | std::ofstream::app);
+    std::vector<std::thread> stages {};
+    stages.emplace_back(generate);
+    stages.emplace_back(compose);
+    stages.emplace_back(translate);
+    stages.emplace_back(check);
 
-    for (const auto &entry: getEntriesInAlphabeticalOrder(stringsGetter.getOutputDirForCheckingPathLogs()))
+    // Collecting the results in order, while the following tests are still going through the pipeline.
+    TATileInputParser taTileInputParser(stringsGetter);
+    std::vector<DashBoardEntry> dashboardResults {};
+    int failed { 0 };
+    int collected { 0 };
+    while (std::optional<CampaignTest> test = checkedTests.pop())
     {
-        std::string entryPath { static_cast<std::string>(entry.path()) };
-        std::string nameTA { getStringGivenPosAndToken(getWordAfterLastSymbol(entry.path(), '/'), '.', 0) };
+        if (!test->error.empty())
+        {
+            failed++;
+            std::cerr << BHRED << test->nameTA << (isSeeded ? " (seed " + std::to_string(seed) + ")" : "") << ": " << test->error << rstColor << '\n';
+            continue;
+        }
 
-        out << nameTA << '\n' << std::string(nameTA.length(), '-') << '\n';
+        resultsStore.append(getTestRecord(stringsGetter, taTileInputParser, resultsStore, *test, isChecked));
+        if (isChecked)
+            dashboardResults.push_back({ test->nameTA, false, test->isAccepting });
 
-        std::string parString { getParameterString(stringsGetter, entryPath) };
+        progress << "[" << ++collected << "/" << numTests << "] " << test->nameTA
+                 << (isChecked ? (test->isAccepting ? ": language is not empty" : ": language is empty") : "")
+                 << (test->duplicateOf.empty() ? "" : " (same TA as " + test->duplicateOf + ")") << std::endl;
+    }
 
-        if (!parString.empty())
-            printBoundResults(cliHandler, out, std::stod(parString), nameTA);
-        else
-            out << "The language of the given TA is empty and thus no parameter has been found.\n";
+    for (std::thread &stage: stages)
+        stage.join();
 
-        out << "\n\n";
-        out.flush();
-    }
-    out.close();
+    std::cout.clear();
+
+    if (isChecked)
+        printDashBoard(dashboardResults, false, true);
+
+    std::cout << ((failed == 0) ? BHGRN : BHYEL) << "Generated " << (numTests - failed) << " out of " << numTests << " tests" << rstColor << std::endl;
+
+    return failed;
 }
 
 
@@ -367,73 +567,202 @@ int main(int argc, char *argv[])
     StringsGetter stringsGetter(cliHandler);
     TATileInputParser taTileInputParser(stringsGetter);
 
-    // Cleaning directories before starting test generation.
-    cleanDirectories(stringsGetter);
+    CampaignJournal campaignJournal(stringsGetter.getTestingResultsDirPath());
+    TAResultsStore resultsStore(stringsGetter.getTestingResultsDirPath());
 
-    // Integer indicating the maximum number of states randomly-generated tiles will have.
-    int maxNumOfRandomStates { cliHandler.isCmd(sup) ? std::stoi(cliHandler.getCmdArgument(sup)) : 5 };
+    CampaignConfig config {};
+    bool isResumed { cliHandler.isCmd(rsm) };
 
-    // Now generating the right regex generator based on the given cli command.
+    // The index of the only test to generate (if any), the capacity of the queues of the pipeline and the number of threads.
+    int onlyIndex { 0 };
+    size_t capacity { 0 };
+    unsigned int threads { std::thread::hardware_concurrency() };
+
+    try
+    {
+        if (isResumed)
+        {
+            // Resuming the journaled campaign: its configuration replaces the one given in the command line.
+            if (!campaignJournal.exists())
+                throw InvalidCampaignJournalException("No campaign to resume has been found in: " + stringsGetter.getTestingResultsDirPath());
+            config = campaignJournal.read();
+            resultsStore.recover();
+        } else
+        {
+            if (cliHandler.isCmd(tns))
+                config.generator = tns;
+            else if (cliHandler.isCmd(tst))
+                config.generator = tst;
+            else if (cliHandler.isCmd(tbz))
+            {
+                config.generator = tbz;
+                config.tolerance = cliHandler.isCmd(tol) ? std::stod(cliHandler.getCmdArgument(tol)) : 0;
+            } else
+            {
+                std::cerr << BHRED << "Invalid argument specified for running the tester." << rstColor << std::endl;
+                return EXIT_FAILURE;
+            }
+            config.generatorParameter = static_cast<int>(cliHandler.getNumericCmdArgument(config.generator, INT_MAX));
+
+            // Integer indicating the maximum number of states randomly-generated tiles will have.
+            config.maxNumOfRandomStates = cliHandler.isCmd(sup) ? static_cast<int>(cliHandler.getNumericCmdArgument(sup, INT_MAX)) : 5;
+            config.numTests = cliHandler.isCmd(nbt) ? static_cast<int>(cliHandler.getNumericCmdArgument(nbt, INT_MAX)) : 10;
+            config.isSeeded = cliHandler.isCmd(sed);
+            config.seed = config.isSeeded ? cliHandler.getNumericCmdArgument(sed) : 0;
+            config.isLazy = cliHandler.isCmd(lzy);
+        }
+
+        // A single test can be generated again only from the seed of the campaign.
+        onlyIndex = cliHandler.isCmd(idx) ? static_cast<int>(cliHandler.getNumericCmdArgument(idx, INT_MAX)) : 0;
+        capacity = cliHandler.isCmd(ppl) ? cliHandler.getNumericCmdArgument(ppl, SIZE_MAX) : 0;
+        threads = cliHandler.isCmd(thr) ? cliHandler.getNumericCmdArgument(thr, UINT_MAX) : threads;
+    } catch (InvalidCampaignJournalException &e)
+    {
+        std::cerr << BHRED << e.what() << rstColor << std::endl;
+        return EXIT_FAILURE;
+    } catch (InvalidCommandArgumentException &e)
+    {
+        std::cerr << BHRED << e.what() << rstColor << std::endl;
+        return EXIT_FAILURE;
+    } catch (std::logic_error &e)
+    {
+        std::cerr << BHRED << "Exception: the argument of command " << tol << " must be a number." << rstColor << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (cliHandler.isCmd(idx) && (!config.isSeeded || onlyIndex < 1 || onlyIndex > config.numTests))
+    {
+        std::cerr << BHRED << "A single test can be generated only from a seed, with an index from 1 to the number of tests."
+                  << rstColor << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!isResumed)
+    {
+        // Cleaning directories before starting test generation, then journaling the new campaign.
+        cleanDirectories(stringsGetter);
+        campaignJournal.write(config);
+    }
+
+    TAGraph::setLazyComposition(config.isLazy);
+
+    // Now generating the right regex generator based on the configuration of the campaign.
     TATileRegExGenerator *taTileRegExGenerator;
 
-    if (cliHandler.isCmd(tns))
-        taTileRegExGenerator = new TATileRegExGenerator(std::stoi(cliHandler.getCmdArgument(tns)));
-    else if (cliHandler.isCmd(tst))
+    if (config.generator == tns)
+        taTileRegExGenerator = new TATileRegExGenerator(config.generatorParameter);
+    else if (config.generator == tbz)
     {
-        taTileRegExGenerator = new TATileRegExGeneratorStrict(
-                std::stoi(cliHandler.getCmdArgument(tst)), maxNumOfRandomStates,
+        taTileRegExGenerator = new TATileRegExGeneratorBoltzmann(
+                config.generatorParameter, config.tolerance, config.maxNumOfRandomStates,
                 taTileInputParser.getRngTileTokens(),
                 taTileInputParser.getAccTileTokens(),
                 taTileInputParser.getBinTileTokens(),
                 taTileInputParser.getTriTileTokens());
     } else
     {
-        std::cerr << BHRED << "Invalid argument specified for running the tester." << rstColor << std::endl;
-        return EXIT_FAILURE;
+        taTileRegExGenerator = new TATileRegExGeneratorStrict(
+                config.generatorParameter, config.maxNumOfRandomStates,
+                taTileInputParser.getRngTileTokens(),
+                taTileInputParser.getAccTileTokens(),
+                taTileInputParser.getBinTileTokens(),
+                taTileInputParser.getTriTileTokens());
     }
 
-    std::cout << "Starting generating random tests.\n";
+    int numTests { config.numTests };
 
-    int numTests = cliHandler.isCmd(nbt) ? std::stoi(cliHandler.getCmdArgument(nbt)) : 10;
-    for (int i = 0; i <= numTests; i++)
+    // The indexes of the tests to generate: when no tests are requested a single one is built from the input string,
+    // while the tests already completed by a resumed campaign are skipped.
+    std::vector<int> indices {};
+    if (numTests == 0)
+        indices.push_back(0);
+    else
     {
-        // TODO: also this if condition is related to the TODO below.
-        if (i == 0 && numTests > 0)
-            ++i;
+        std::set<std::string> completedTests {};
+        if (isResumed)
+            completedTests = resultsStore.getStoredNames();
 
-        TABoundsCalculator::resetBoundCalculator();
+        for (int i = 1; i <= numTests; i++)
+        {
+            std::string TAName = "RegExTA_" + std::to_string(i);
+            if (completedTests.count(TAName) > 0 || (onlyIndex > 0 && i != onlyIndex))
+                continue;
+
+            // The outputs of a test interrupted in the middle are removed, since logs are appended to.
+            if (isResumed)
+                removeTestOutputs(stringsGetter, TAName);
+            indices.push_back(i);
+        }
 
-        // Resetting the nonce at each test generation in order to avoid the index becoming too big.
-        TATileRenamer::resetTANonce();
+        if (isResumed)
+            std::cout << "Resuming the campaign: " << completedTests.size() << " out of " << numTests << " tests already completed.\n";
+    }
 
-        std::string regEx { taTileRegExGenerator->generateRegEx() };
-        std::cout << "Obtained string:\n" << regEx << "\n";
+    std::cout << "Starting generating random tests.\n";
 
-        // TODO: LAST MINUTE CHANGE, THIS IF CONDITION NEEDS TO BE ENHANCED.
-        //       You should also find a way to know the input string in order to pass it to the writeLogs function.
-        json tiledTA;
-        if (numTests == 0)
+    if (numTests > 0 && indices.empty())
+        std::cout << BHGRN << "All the tests of the campaign have been completed." << rstColor << std::endl;
+    // Generating the tests as a pipeline, which also checks them and stores the results as soon as they are available.
+    else if (numTests > 0 && cliHandler.isCmd(ppl))
+    {
+        runTestsPipeline(stringsGetter, cliHandler, resultsStore, *taTileRegExGenerator, indices, config.isSeeded, config.seed, capacity);
+    }
+    // Generating the tests on a pool of threads if either a seed or a number of threads has been given.
+    else if (numTests > 0 && (config.isSeeded || cliHandler.isCmd(thr)))
+        runTestsConcurrently(stringsGetter, cliHandler, resultsStore, *taTileRegExGenerator, indices, config.isSeeded, config.seed, threads);
+    else
+    {
+        bool isChecked { cliHandler.isCmd(atc) };
+        TAChecker taChecker(stringsGetter, cliHandler);
+        std::vector<DashBoardEntry> dashboardResults {};
+
+        for (int i: indices)
         {
-            TATileInputParser t(stringsGetter, true);
-            tiledTA = t.getTiledTA();
-        } else
-            tiledTA = taTileInputParser.getTiledTA(regEx);
+            TABoundsCalculator::resetBoundCalculator();
 
-        std::string TAName = "RegExTA_" + std::to_string(i);
-        writeLogs(stringsGetter, taTileInputParser, TAName, regEx);
+            // Resetting the nonce at each test generation in order to avoid the index becoming too big.
+            TATileRenamer::resetTANonce();
 
-        printTiledTA(tiledTA);
-        convertTiledTAtoDOT(stringsGetter.getOutputDOTsDirPath(), TAName, tiledTA);
-        convertTiledTAtoTCK(stringsGetter.getOutputDirPath(), TAName, tiledTA);
+            std::string regEx { taTileRegExGenerator->generateRegEx() };
+            std::cout << "Obtained string:\n" << regEx << "\n";
 
-        // Storing the bounds that have been found before starting a new iteration.
-        TABoundsCalculator::storeTABounds(TAName);
+            // TODO: LAST MINUTE CHANGE, THIS IF CONDITION NEEDS TO BE ENHANCED.
+            //       You should also find a way to know the input string in order to pass it to the writeLogs function.
+            TAGraph tiledTA;
+            if (numTests == 0)
+            {
+                TATileInputParser t(stringsGetter, true);
+                tiledTA = t.getTiledTA();
+            } else
+                tiledTA = taTileInputParser.getTiledTA(regEx);
+
+            std::string TAName = "RegExTA_" + std::to_string(i);
+            writeLogs(stringsGetter, taTileInputParser, TAName, regEx);
+
+            printTiledTA(tiledTA);
+            convertTiledTAtoDOT(stringsGetter.getOutputDOTsDirPath(), TAName, tiledTA);
+            convertTiledTAtoTCK(stringsGetter.getOutputDirPath(), TAName, tiledTA);
+
+            // Keeping the bounds that have been found before starting a new iteration.
+            CampaignTest test {};
+            test.index = i;
+            test.nameTA = TAName;
+            test.regEx = regEx;
+            test.bounds = TABoundsCalculator::getPathBounds();
+            test.canonicalHash = TACanonicalHasher::getCanonicalHash(tiledTA);
+
+            // Storing the test before generating the next one, so that it is not lost if the campaign is interrupted.
+            checkAndStoreTest(stringsGetter, taTileInputParser, taChecker, resultsStore, test, isChecked);
+            if (isChecked)
+                dashboardResults.push_back({ test.nameTA, false, test.isAccepting });
+        }
+
+        if (isChecked)
+            printDashBoard(dashboardResults, false, true);
     }
 
-    gatherResults(stringsGetter, cliHandler);
-    gatherResourcesUsage(stringsGetter);
-    checkParameterInterval(stringsGetter, cliHandler);
+    // Rendering the text reports from the results store, which also contains the tests completed before resuming.
+    resultsStore.renderReports(stringsGetter.getTestingResultsDirPath(), cliHandler.isCmd(bds));
 
     return EXIT_SUCCESS;
 }
-
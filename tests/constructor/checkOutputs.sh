@@ -0,0 +1,50 @@
+#!/bin/bash
+
+# Shell script that compiles the compositional strings in 'compositions.txt' with the constructor and compares the
+# resulting .tck files with the ones in 'expected'. The script fails as soon as a file is missing or different.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the constructor executable.
+constructor="$1"
+
+# The options given to the constructor besides the batch ones (e.g., -lzy).
+constructor_options=("${@:2}")
+
+# The path of the directory containing this script, the compositional strings and the expected files.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles, with which the expected files have been written.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the constructor reads or writes (tiles, snapshots, .tck and .dot files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# The tiles are laid out as the constructor expects them, in the same order given by the names of their files.
+mkdir -p "$work_directory/tiles/accTiles" "$work_directory/tiles/binTiles" "$work_directory/tiles/triTiles"
+cp "$tiles_directory"/acc*.xml "$work_directory/tiles/accTiles"
+cp "$tiles_directory"/bin_*.xml "$work_directory/tiles/binTiles"
+cp "$tiles_directory"/tri_*.xml "$work_directory/tiles/triTiles"
+
+output_directory="$work_directory/outputs/outputFiles"
+
+if ! "$constructor" "${constructor_options[@]}" -bat "$tests_directory/compositions.txt" -tls "$work_directory/tiles" -ots "$work_directory/outputs" > /dev/null; then
+    echo "The constructor failed to compile the compositional strings."
+    exit 1
+fi
+
+failed=0
+for expected_file in "$tests_directory"/expected/*.tck; do
+    output_file="$output_directory/$(basename "$expected_file")"
+    if ! cmp -s "$expected_file" "$output_file"; then
+        echo "Different output: $(basename "$expected_file")"
+        failed=1
+    fi
+done
+
+exit $failed
@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Shell script that converts the TAs in 'labels' with the converter and compares the resulting .tck files with the ones in
+# 'labels/expected', then converts them again with the -nrt option, checking which ones are recognized as nrtTAs:
+# - constants.xml: constants written without spaces and negative ones (which give C), assignments separated by commas.
+# - resetsOtherClock.xml: the guard tests x2 while the assignment resets x, hence the TA is an nrtTA.
+# - testsAndResets.xml: the same clock is tested by the guard and reset by the assignment, hence the TA is not an nrtTA.
+# The script fails as soon as a file is missing or different.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the converter executable.
+converter="$1"
+
+# The path of the directory containing the TAs and the expected files.
+labels_directory="$(cd "$(dirname "$0")" && pwd)/labels"
+
+# The TAs which are not nrtTAs.
+not_nrt_tas=("testsAndResets")
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the converter reads or writes (TAs, snapshots, .tck files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+mkdir -p "$work_directory/inputs"
+cp "$labels_directory"/*.xml "$work_directory/inputs"
+
+if ! "$converter" -src "$work_directory/inputs" -ots "$work_directory/outputs" > /dev/null; then
+    echo "The converter failed to convert the TAs."
+    exit 1
+fi
+
+failed=0
+for expected_file in "$labels_directory"/expected/*.tck; do
+    if ! cmp -s "$expected_file" "$work_directory/outputs/outputFiles/$(basename "$expected_file")"; then
+        echo "Different output: $(basename "$expected_file")"
+        failed=1
+    fi
+done
+
+# With the -nrt option, only the nrtTAs are translated.
+if ! "$converter" -nrt -src "$work_directory/inputs" -ots "$work_directory/nrtOutputs" > /dev/null 2>&1; then
+    echo "The converter failed to convert the TAs with the -nrt option."
+    exit 1
+fi
+
+for xml_file in "$labels_directory"/*.xml; do
+    ta="$(basename "$xml_file" .xml)"
+    is_translated=false
+    if [ -e "$work_directory/nrtOutputs/outputFiles/$ta.tck" ]; then
+        is_translated=true
+    fi
+    is_nrt=true
+    if [[ " ${not_nrt_tas[*]} " == *" $ta "* ]]; then
+        is_nrt=false
+    fi
+    if [ "$is_translated" != "$is_nrt" ]; then
+        echo "Wrong nrt check: $ta is $([ "$is_nrt" == true ] || echo "not ")an nrtTA."
+        failed=1
+    fi
+done
+
+exit $failed
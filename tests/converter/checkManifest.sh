@@ -0,0 +1,107 @@
+#!/bin/bash
+
+# Shell script that runs the converter several times on the same output directory, checking through the manifest that
+# only the TAs whose .xml file (or output) changed are converted again, that the outputs of removed TAs are deleted, and
+# that changing the options or forcing the conversion rewrites every output. The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the converter executable.
+converter="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example TAs.
+examples_directory="$tests_directory/../../examples/nrt"
+
+# The line appended to the .tck files, which is still there only if the file has not been written again.
+marker="# not rewritten"
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the converter reads or writes (TAs, snapshots, .tck files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+input_directory="$work_directory/inputs"
+output_directory="$work_directory/outputs/outputFiles"
+mkdir -p "$input_directory"
+cp "$examples_directory"/*/*.xml "$input_directory"
+
+
+# Converts the TAs, always in the same output directory.
+# $@: the options given to the converter.
+convert() {
+    if ! "$converter" "$@" -src "$input_directory" -ots "$work_directory/outputs" > /dev/null; then
+        echo "The converter failed to convert the TAs."
+        exit 1
+    fi
+}
+
+# Checks which TAs have been converted by the last run, then marks every .tck file for the next run.
+# $1: the description of the run.
+# $2: the name of the TA whose output must have been written again, "all" for every TA, "none" for no TA.
+check_rewritten() {
+    for xml_file in "$input_directory"/*.xml; do
+        ta="$(basename "$xml_file" .xml)"
+        tck_file="$output_directory/$ta.tck"
+
+        is_rewritten=true
+        if grep -q "^$marker\$" "$tck_file"; then
+            is_rewritten=false
+        fi
+        must_be_rewritten=false
+        if [ "$2" == "all" ] || [ "$2" == "$ta" ]; then
+            must_be_rewritten=true
+        fi
+
+        if [ "$is_rewritten" != "$must_be_rewritten" ]; then
+            echo "$1: $ta.tck has $([ "$is_rewritten" == true ] && echo "been" || echo "not been") written again."
+            exit 1
+        fi
+        if [ "$is_rewritten" == true ]; then
+            echo "$marker" >> "$tck_file"
+        fi
+    done
+}
+
+
+convert
+check_rewritten "First run" "all"
+
+# Nothing changed: every conversion is skipped.
+convert
+check_rewritten "Nothing changed" "none"
+
+# Only the TA whose .xml file changed is converted again.
+sed -i 's/x &lt;= 3/x \&lt;= 7/' "$input_directory/mu2.xml"
+convert
+check_rewritten "TA changed" "mu2"
+
+# The outputs of the removed TAs, and any other file, are deleted.
+rm "$input_directory/forcedloop.xml"
+touch "$output_directory/stale.tck"
+convert
+check_rewritten "TA removed" "none"
+for removed_file in forcedloop.tck stale.tck; do
+    if [ -e "$output_directory/$removed_file" ]; then
+        echo "TA removed: $removed_file has not been deleted."
+        exit 1
+    fi
+done
+
+# A missing output is written again.
+rm "$output_directory/mu2_inv.tck"
+convert
+check_rewritten "Output removed" "mu2_inv"
+
+# Changing the options, or forcing the conversion, writes every output again.
+convert -nrt
+check_rewritten "Options changed" "all"
+convert -nrt -frc
+check_rewritten "Conversion forced" "all"
+
+exit 0
@@ -0,0 +1,91 @@
+#!/bin/bash
+
+# Shell script that converts the example TAs with the converter several times, checking that the .tck files written from
+# the snapshots are the same ones written from the .xml files, and that a snapshot is not used anymore once its .xml file
+# has changed (or once the snapshot itself is corrupted). The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the converter executable.
+converter="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example TAs.
+examples_directory="$tests_directory/../../examples/nrt"
+
+# The example TA which is changed to check that its snapshot is not used anymore.
+changed_ta="mu2"
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the converter reads or writes (TAs, snapshots, .tck files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+input_directory="$work_directory/inputs"
+mkdir -p "$input_directory"
+cp "$examples_directory"/*/*.xml "$input_directory"
+
+
+# Converts the TAs of a directory, writing the .tck files in a new output directory (hence no conversion is skipped).
+# $1: the directory containing the TAs.
+# $2: the name of the output directory.
+convert() {
+    if ! "$converter" -src "$1" -ots "$work_directory/$2" > /dev/null; then
+        echo "The converter failed to convert the TAs ($2)."
+        exit 1
+    fi
+}
+
+# Compares the .tck files of two output directories.
+# $1, $2: the names of the output directories.
+compare() {
+    if ! diff -r "$work_directory/$1/outputFiles" "$work_directory/$2/outputFiles" -x .manifest.json > /dev/null; then
+        echo "Different outputs: $1 and $2."
+        exit 1
+    fi
+}
+
+
+# The first conversion parses the .xml files and writes their snapshots, which are used by the second one.
+convert "$input_directory" "fromXml"
+for xml_file in "$input_directory"/*.xml; do
+    if [ ! -s "${xml_file%.xml}.tasnap" ]; then
+        echo "Missing snapshot: $(basename "$xml_file")"
+        exit 1
+    fi
+done
+convert "$input_directory" "fromSnapshots"
+compare "fromXml" "fromSnapshots"
+
+# A snapshot is still used after its .xml file has only been touched.
+touch "$input_directory/$changed_ta.xml"
+convert "$input_directory" "afterTouch"
+compare "fromXml" "afterTouch"
+
+# A snapshot is not used anymore after its .xml file has changed, even if its size has not.
+sed -i 's/x &lt;= 3/x \&lt;= 7/' "$input_directory/$changed_ta.xml"
+convert "$input_directory" "afterChange"
+if ! grep -q "x <= 7" "$work_directory/afterChange/outputFiles/$changed_ta.tck"; then
+    echo "Stale snapshot used for: $changed_ta.xml"
+    exit 1
+fi
+mkdir -p "$work_directory/freshInputs"
+cp "$input_directory"/*.xml "$work_directory/freshInputs"
+convert "$work_directory/freshInputs" "freshXml"
+compare "freshXml" "afterChange"
+
+# A corrupted snapshot is ignored, and written again.
+truncate -s 16 "$input_directory/$changed_ta.tasnap"
+convert "$input_directory" "afterCorruption"
+compare "freshXml" "afterCorruption"
+if [ "$(stat -c %s "$input_directory/$changed_ta.tasnap")" -le 16 ]; then
+    echo "Corrupted snapshot not written again: $changed_ta.tasnap"
+    exit 1
+fi
+
+exit 0
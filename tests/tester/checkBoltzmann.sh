@@ -0,0 +1,72 @@
+#!/bin/bash
+
+# Shell script that generates seeded campaigns with the Boltzmann generator of the tester, checking that with a tolerance
+# the number of tiles of every regular expression (the final accepting tile excluded) is within the tolerance of the
+# requested one, while still being spread over the range. The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the tester executable.
+tester="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# The number of tests of each campaign.
+num_tests=30
+
+# The minimum number of different sizes among the tests of a campaign.
+min_distinct_sizes=3
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the tester reads or writes (tiles, snapshots, .tck, .dot and log files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# The tiles are laid out as the tester expects them, in the same order given by the names of their files.
+mkdir -p "$work_directory/tiles/accTiles" "$work_directory/tiles/binTiles" "$work_directory/tiles/triTiles"
+cp "$tiles_directory"/acc*.xml "$work_directory/tiles/accTiles"
+cp "$tiles_directory"/bin_*.xml "$work_directory/tiles/binTiles"
+cp "$tiles_directory"/tri_*.xml "$work_directory/tiles/triTiles"
+
+
+# Runs a campaign with the Boltzmann generator and checks the number of tiles of its regular expressions.
+# $1: the requested number of tiles.
+# $2: the tolerance.
+# $3, $4: the minimum and maximum number of tiles allowed by the tolerance.
+check_sizes() {
+    output_directory="$work_directory/outputs_$1_$2"
+    if ! "$tester" -tbz "$1" -tol "$2" -nbt "$num_tests" -sed 3 -thr 2 -tls "$work_directory/tiles" -ots "$output_directory" > /dev/null 2>&1; then
+        echo "The tester failed to run the campaign (-tbz $1 -tol $2)."
+        exit 1
+    fi
+
+    # Every tile is either a tile of the library (e.g., t4) or a randomly-generated one (e.g., t:BA[3]).
+    sizes="$(sed -n 's/.*"regex":"\([^"]*\)".*/\1/p' "$output_directory/logs/testingResults/Results.jsonl" \
+        | awk '{ print gsub(/t[0-9]+|t:[A-Z]+/, "&") - 1 }' | sort -n)"
+
+    if [ "$(echo "$sizes" | wc -l)" -ne "$num_tests" ]; then
+        echo "Missing tests in the campaign (-tbz $1 -tol $2)."
+        exit 1
+    fi
+    if [ "$(echo "$sizes" | head -n 1)" -lt "$3" ] || [ "$(echo "$sizes" | tail -n 1)" -gt "$4" ]; then
+        echo "Number of tiles out of [$3, $4] (-tbz $1 -tol $2): $(echo "$sizes" | tr '\n' ' ')"
+        exit 1
+    fi
+    if [ "$(echo "$sizes" | uniq | wc -l)" -lt "$min_distinct_sizes" ]; then
+        echo "Number of tiles not spread over [$3, $4] (-tbz $1 -tol $2): $(echo "$sizes" | tr '\n' ' ')"
+        exit 1
+    fi
+}
+
+
+check_sizes 10 0.2 8 12
+check_sizes 30 0.1 27 33
+
+exit 0
@@ -0,0 +1,100 @@
+#!/bin/bash
+
+# Shell script that generates the same seeded campaign with the tester from three copies of the example tiles: the tiles
+# themselves, the tiles with their locations and transitions renamed, and the tiles with a guard of bin_1_1 changed.
+# It checks that renaming never changes the canonical hash of a TA, while the TAs using the changed tile get a different
+# hash (and the other ones the same hash). The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the tester executable.
+tester="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# The options of the campaign.
+campaign_options=(-tst 3 -nbt 20 -sed 5 -thr 2)
+
+# The tile whose guard is changed.
+changed_tile="bin_1_1"
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the tester reads or writes (tiles, snapshots, .tck, .dot and log files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# Copies the tiles, laid out as the tester expects them, in the same order given by the names of their files.
+# $1: the name of the directory of the copy.
+copy_tiles() {
+    mkdir -p "$work_directory/$1/accTiles" "$work_directory/$1/binTiles" "$work_directory/$1/triTiles"
+    cp "$tiles_directory"/acc*.xml "$work_directory/$1/accTiles"
+    cp "$tiles_directory"/bin_*.xml "$work_directory/$1/binTiles"
+    cp "$tiles_directory"/tri_*.xml "$work_directory/$1/triTiles"
+}
+
+copy_tiles "tiles"
+copy_tiles "renamedTiles"
+sed -i 's/"id\([0-9]*\)"/"loc\1"/g' "$work_directory"/renamedTiles/*/*.xml
+copy_tiles "changedTiles"
+sed -i 's/y == 2/y == 3/' "$work_directory/changedTiles/binTiles/$changed_tile.xml"
+
+# Runs the campaign from a copy of the tiles, then prints the canonical hash and the used tiles of each test, one per line.
+# $1: the name of the directory of the copy.
+get_hashes() {
+    if ! "$tester" "${campaign_options[@]}" -tls "$work_directory/$1" -ots "$work_directory/outputs_$1" > /dev/null 2>&1; then
+        echo "The tester failed to run the campaign ($1)." >&2
+        exit 1
+    fi
+    sed -n 's/.*"canonicalHash":"\([^"]*\)".*"usedTiles":\(\[[^]]*\]\).*/\1 \2/p' "$work_directory/outputs_$1/logs/testingResults/Results.jsonl"
+}
+
+hashes="$(get_hashes "tiles")" || exit 1
+renamed_hashes="$(get_hashes "renamedTiles")" || exit 1
+changed_hashes="$(get_hashes "changedTiles")" || exit 1
+
+if [ "$(echo "$hashes" | wc -l)" -ne 20 ]; then
+    echo "Missing records in the campaign."
+    exit 1
+fi
+
+# The renamed TAs are written differently, but have the same canonical hashes.
+if diff -r "$work_directory/outputs_tiles/outputFiles" "$work_directory/outputs_renamedTiles/outputFiles" > /dev/null; then
+    echo "The tiles have not been renamed."
+    exit 1
+fi
+if [ "$hashes" != "$renamed_hashes" ]; then
+    echo "Different canonical hashes after renaming the tiles."
+    exit 1
+fi
+
+# Only the TAs using the changed tile have a different canonical hash.
+changed_tests=0
+while read -r line && read -r changed_line <&3; do
+    is_using_tile=false
+    if [[ "$line" == *"\"$changed_tile\""* ]]; then
+        is_using_tile=true
+        changed_tests=$((changed_tests + 1))
+    fi
+    is_changed=true
+    if [ "$line" == "$changed_line" ]; then
+        is_changed=false
+    fi
+    if [ "$is_using_tile" != "$is_changed" ]; then
+        echo "Wrong canonical hash after changing $changed_tile: $line"
+        exit 1
+    fi
+done <<< "$hashes" 3<<< "$changed_hashes"
+
+if [ "$changed_tests" -eq 0 ]; then
+    echo "No test uses $changed_tile."
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,88 @@
+#!/bin/bash
+
+# Shell script that generates a seeded campaign with the tester and checks the results store: one record for each test,
+# holding the regular expression written in its log, and text reports rendered from the records in order of test number
+# (also when rendered again from the store alone). The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the tester executable.
+tester="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# The number of tests of the campaign, more than 9 so that sorting the names as strings would give a different order.
+num_tests=12
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the tester reads or writes (tiles, snapshots, .tck, .dot and log files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# The tiles are laid out as the tester expects them, in the same order given by the names of their files.
+mkdir -p "$work_directory/tiles/accTiles" "$work_directory/tiles/binTiles" "$work_directory/tiles/triTiles"
+cp "$tiles_directory"/acc*.xml "$work_directory/tiles/accTiles"
+cp "$tiles_directory"/bin_*.xml "$work_directory/tiles/binTiles"
+cp "$tiles_directory"/tri_*.xml "$work_directory/tiles/triTiles"
+
+results_directory="$work_directory/outputs/logs/testingResults"
+logs_directory="$work_directory/outputs/logs/outputFilesForCheckingLogs"
+
+# Runs the tester on the campaign, always in the same output directory.
+# $@: the options given to the tester.
+run_tester() {
+    if ! "$tester" "$@" -tls "$work_directory/tiles" -ots "$work_directory/outputs" > /dev/null 2>&1; then
+        echo "The tester failed to run the campaign."
+        exit 1
+    fi
+}
+
+
+run_tester -tst 3 -nbt "$num_tests" -sed 7 -thr 3
+
+# Each test has a single record, in order, with the regular expression written in its log and a canonical hash.
+expected_names="$(seq -f "RegExTA_%g" 1 "$num_tests")"
+if [ "$(sed -n 's/.*"name":"\([^"]*\)".*/\1/p' "$results_directory/Results.jsonl")" != "$expected_names" ]; then
+    echo "Wrong records in: Results.jsonl"
+    exit 1
+fi
+while read -r record; do
+    name="$(echo "$record" | sed -n 's/.*"name":"\([^"]*\)".*/\1/p')"
+    regex="$(echo "$record" | sed -n 's/.*"regex":"\([^"]*\)".*/\1/p')"
+    if [ "$(grep -A 1 "^RegEx generated:" "$logs_directory/$name.txt" | tail -n 1)" != "$regex" ]; then
+        echo "Wrong regular expression in the record of: $name"
+        exit 1
+    fi
+    if ! echo "$record" | grep -q '"canonicalHash":"[0-9a-f]\{32\}"' || ! echo "$record" | grep -q '"verdict":"unchecked"'; then
+        echo "Wrong canonical hash or verdict in the record of: $name"
+        exit 1
+    fi
+done < "$results_directory/Results.jsonl"
+
+# The reports list the tests in order of test number, and only the checked TAs have a result.
+if [ "$(grep "^RegExTA_" "$results_directory/ParametersBounds.txt")" != "$expected_names" ]; then
+    echo "Wrong order of the tests in: ParametersBounds.txt"
+    exit 1
+fi
+if [ -s "$results_directory/Results.txt" ] || [ -s "$results_directory/ResourceUsages.txt" ]; then
+    echo "Results of unchecked TAs in: Results.txt or ResourceUsages.txt"
+    exit 1
+fi
+
+# The reports are rendered again from the store alone when the completed campaign is resumed.
+cp "$results_directory/ParametersBounds.txt" "$work_directory/ParametersBounds.txt"
+rm "$results_directory"/*.txt
+run_tester -rsm
+if ! cmp -s "$work_directory/ParametersBounds.txt" "$results_directory/ParametersBounds.txt"; then
+    echo "Different report rendered from the store: ParametersBounds.txt"
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,77 @@
+#!/bin/bash
+
+# Shell script that interrupts a seeded campaign of the tester (by cutting its results store in the middle of a record)
+# and resumes it, checking that the resumed campaign gives the same tests and records as the same campaign run at once,
+# and that a campaign cannot be resumed when no journal has been written. The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the tester executable.
+tester="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# The options of the campaign.
+campaign_options=(-tst 3 -nbt 10 -sed 9 -thr 2)
+
+# The number of records kept in the results store when the campaign is interrupted.
+completed_tests=4
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the tester reads or writes (tiles, snapshots, .tck, .dot and log files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# The tiles are laid out as the tester expects them, in the same order given by the names of their files.
+mkdir -p "$work_directory/tiles/accTiles" "$work_directory/tiles/binTiles" "$work_directory/tiles/triTiles"
+cp "$tiles_directory"/acc*.xml "$work_directory/tiles/accTiles"
+cp "$tiles_directory"/bin_*.xml "$work_directory/tiles/binTiles"
+cp "$tiles_directory"/tri_*.xml "$work_directory/tiles/triTiles"
+
+# Runs the tester, writing its outputs in the given output directory.
+# $1: the name of the output directory.
+# ${@:2}: the options given to the tester.
+run_tester() {
+    "$tester" "${@:2}" -tls "$work_directory/tiles" -ots "$work_directory/$1" > /dev/null 2>&1
+}
+
+
+if ! run_tester "atOnce" "${campaign_options[@]}" || ! run_tester "resumed" "${campaign_options[@]}"; then
+    echo "The tester failed to run the campaign."
+    exit 1
+fi
+
+# The campaign is interrupted while the record of the test following the completed ones is being written.
+results_store="$work_directory/resumed/logs/testingResults/Results.jsonl"
+head -n "$completed_tests" "$results_store" > "$work_directory/Results.jsonl"
+sed -n "$((completed_tests + 1))p" "$results_store" | head -c 40 >> "$work_directory/Results.jsonl"
+mv "$work_directory/Results.jsonl" "$results_store"
+for ((i = completed_tests + 2; i <= 10; i++)); do
+    rm "$work_directory/resumed/outputFiles/RegExTA_$i.tck"
+done
+
+# Only the configuration of the journal is used when resuming, whatever the options given.
+if ! run_tester "resumed" -rsm -tst 5 -nbt 2 -sed 1; then
+    echo "The tester failed to resume the campaign."
+    exit 1
+fi
+if ! diff -r "$work_directory/atOnce/outputFiles" "$work_directory/resumed/outputFiles" > /dev/null \
+    || ! cmp -s "$work_directory/atOnce/logs/testingResults/Results.jsonl" "$results_store"; then
+    echo "Different tests or records after resuming the campaign."
+    exit 1
+fi
+
+# Without a journal there is no campaign to resume.
+if run_tester "noJournal" -rsm; then
+    echo "A campaign without journal has been resumed."
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,84 @@
+#!/bin/bash
+
+# Shell script that generates the same seeded campaign with the tester on one thread, on several threads and as a pipeline,
+# checking that the same seed always gives the same tests, that a different seed gives different ones, and that a single
+# test generated alone (with -idx) is the same one generated by the whole campaign. The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the tester executable.
+tester="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# The options of the campaign, the seed excluded.
+campaign_options=(-tst 4 -nbt 8)
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the tester reads or writes (tiles, snapshots, .tck, .dot and log files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# The tiles are laid out as the tester expects them, in the same order given by the names of their files.
+mkdir -p "$work_directory/tiles/accTiles" "$work_directory/tiles/binTiles" "$work_directory/tiles/triTiles"
+cp "$tiles_directory"/acc*.xml "$work_directory/tiles/accTiles"
+cp "$tiles_directory"/bin_*.xml "$work_directory/tiles/binTiles"
+cp "$tiles_directory"/tri_*.xml "$work_directory/tiles/triTiles"
+
+
+# Runs a campaign, writing its outputs in a new output directory.
+# $1: the name of the output directory.
+# ${@:2}: the options given to the tester.
+run_campaign() {
+    if ! "$tester" "${@:2}" -tls "$work_directory/tiles" -ots "$work_directory/$1" > /dev/null 2>&1; then
+        echo "The tester failed to run the campaign ($1)."
+        exit 1
+    fi
+}
+
+# Compares the .tck files, the .dot files and the records of two campaigns.
+# $1, $2: the names of the output directories.
+compare() {
+    if ! diff -r "$work_directory/$1/outputFiles" "$work_directory/$2/outputFiles" > /dev/null \
+        || ! diff -r "$work_directory/$1/outputDOTs" "$work_directory/$2/outputDOTs" > /dev/null \
+        || ! cmp -s "$work_directory/$1/logs/testingResults/Results.jsonl" "$work_directory/$2/logs/testingResults/Results.jsonl"; then
+        echo "Different tests: $1 and $2."
+        exit 1
+    fi
+}
+
+
+run_campaign "oneThread" "${campaign_options[@]}" -sed 11 -thr 1
+run_campaign "fourThreads" "${campaign_options[@]}" -sed 11 -thr 4
+run_campaign "pipeline" "${campaign_options[@]}" -sed 11 -ppl 2
+compare "oneThread" "fourThreads"
+compare "oneThread" "pipeline"
+
+if [ "$(find "$work_directory/oneThread/outputFiles" -name "RegExTA_*.tck" | wc -l)" -ne 8 ]; then
+    echo "Missing tests in the campaign."
+    exit 1
+fi
+
+# A different seed gives different tests.
+run_campaign "otherSeed" "${campaign_options[@]}" -sed 12 -thr 1
+if diff -r "$work_directory/oneThread/outputFiles" "$work_directory/otherSeed/outputFiles" > /dev/null; then
+    echo "Same tests with different seeds."
+    exit 1
+fi
+
+# A test generated alone is the same one generated by the campaign.
+run_campaign "singleTest" "${campaign_options[@]}" -sed 11 -idx 5
+if ! cmp -s "$work_directory/oneThread/outputFiles/RegExTA_5.tck" "$work_directory/singleTest/outputFiles/RegExTA_5.tck" \
+    || [ "$(find "$work_directory/singleTest/outputFiles" -name "RegExTA_*.tck" | wc -l)" -ne 1 ]; then
+    echo "Different test generated alone: RegExTA_5."
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# Shell script that generates seeded campaigns with the strict generator of the tester, checking that every regular
+# expression has exactly the requested number of tiles (the final accepting tile excluded), is closed by the accepting
+# tile and gives a TA. The script fails as soon as a check does not hold.
+
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+# The path of the tester executable.
+tester="$1"
+
+# The path of the directory containing this script.
+tests_directory="$(cd "$(dirname "$0")" && pwd)"
+
+# The path of the directory containing the example tiles.
+tiles_directory="$tests_directory/../../examples/tiles"
+
+# The number of tests of each campaign.
+num_tests=30
+
+# ----- PARAMETERS DEFINITIONS ----- #
+
+
+# Everything the tester reads or writes (tiles, snapshots, .tck, .dot and log files) stays inside a temporary directory.
+work_directory="$(mktemp -d)"
+trap 'rm -rf "$work_directory"' EXIT
+
+# The tiles are laid out as the tester expects them, in the same order given by the names of their files.
+mkdir -p "$work_directory/tiles/accTiles" "$work_directory/tiles/binTiles" "$work_directory/tiles/triTiles"
+cp "$tiles_directory"/acc*.xml "$work_directory/tiles/accTiles"
+cp "$tiles_directory"/bin_*.xml "$work_directory/tiles/binTiles"
+cp "$tiles_directory"/tri_*.xml "$work_directory/tiles/triTiles"
+
+
+# Runs a campaign with the strict generator and checks its regular expressions.
+# $1: the requested number of tiles.
+check_regexes() {
+    output_directory="$work_directory/outputs_$1"
+    if ! "$tester" -tst "$1" -nbt "$num_tests" -sed 8 -thr 2 -tls "$work_directory/tiles" -ots "$output_directory" > /dev/null 2>&1; then
+        echo "The tester failed to run the campaign (-tst $1)."
+        exit 1
+    fi
+
+    if [ "$(find "$output_directory/outputFiles" -name "RegExTA_*.tck" | wc -l)" -ne "$num_tests" ]; then
+        echo "Missing tests in the campaign (-tst $1)."
+        exit 1
+    fi
+
+    while read -r regex; do
+        # Every tile is either a tile of the library (e.g., t4) or a randomly-generated one (e.g., t:BA[3]).
+        size="$(echo "$regex" | awk '{ print gsub(/t[0-9]+|t:[A-Z]+/, "&") - 1 }')"
+        if [ "$size" -ne "$1" ] || [[ "$regex" != "( "*" ) +1 t1" ]]; then
+            echo "Wrong regular expression (-tst $1): $regex"
+            exit 1
+        fi
+    done < <(sed -n 's/.*"regex":"\([^"]*\)".*/\1/p' "$output_directory/logs/testingResults/Results.jsonl")
+}
+
+
+check_regexes 1
+check_regexes 4
+check_regexes 9
+
+exit 0